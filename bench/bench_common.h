@@ -0,0 +1,31 @@
+#pragma once
+#include "trading/multi_symbol_trader.h"
+#include <cstdlib>
+#include <ctime>
+
+namespace trading {
+
+/**
+ * Trading config for benchmarks: SIGOR with the same warmup adjustments
+ * main.cpp makes for the rule-based strategy, console output off
+ */
+inline TradingConfig bench_trading_config() {
+    TradingConfig config;
+    config.strategy = StrategyType::SIGOR;
+    config.min_bars_to_learn = 0;
+    config.warmup.enabled = false;
+    config.warmup.observation_days = 0;
+    config.warmup.simulation_days = 0;
+    config.quiet = true;
+    return config;
+}
+
+/**
+ * Session times and EOD detection use local time; benchmarks pin it to ET
+ */
+inline void use_market_timezone() {
+    setenv("TZ", "America/New_York", 1);
+    tzset();
+}
+
+} // namespace trading
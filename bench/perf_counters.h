@@ -0,0 +1,178 @@
+#pragma once
+#include <array>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <utility>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace trading {
+
+/**
+ * Hardware counters collected by PerfCounters
+ */
+enum class PerfEvent : size_t {
+    CYCLES,
+    INSTRUCTIONS,
+    L1D_MISSES,         // L1 data cache read misses
+    LLC_MISSES,         // Last-level cache read misses
+    BRANCH_MISSES,
+    COUNT
+};
+
+inline const char* perf_event_name(PerfEvent event) {
+    switch (event) {
+        case PerfEvent::CYCLES:        return "cycles";
+        case PerfEvent::INSTRUCTIONS:  return "instructions";
+        case PerfEvent::L1D_MISSES:    return "l1d_misses";
+        case PerfEvent::LLC_MISSES:    return "llc_misses";
+        case PerfEvent::BRANCH_MISSES: return "branch_misses";
+        default:                       return "unknown";
+    }
+}
+
+/**
+ * Counter totals over one or more measured regions (-1 = counter unavailable)
+ */
+struct PerfSample {
+    static constexpr size_t NUM_EVENTS = static_cast<size_t>(PerfEvent::COUNT);
+    std::array<double, NUM_EVENTS> counts;
+
+    PerfSample() { counts.fill(-1.0); }
+
+    double operator[](PerfEvent e) const { return counts[static_cast<size_t>(e)]; }
+    bool has(PerfEvent e) const { return (*this)[e] >= 0.0; }
+
+    void add(const PerfSample& other) {
+        for (size_t i = 0; i < NUM_EVENTS; ++i) {
+            if (other.counts[i] < 0.0) continue;
+            counts[i] = (counts[i] < 0.0 ? 0.0 : counts[i]) + other.counts[i];
+        }
+    }
+
+    double ipc() const {
+        return has(PerfEvent::CYCLES) && has(PerfEvent::INSTRUCTIONS) && (*this)[PerfEvent::CYCLES] > 0
+            ? (*this)[PerfEvent::INSTRUCTIONS] / (*this)[PerfEvent::CYCLES] : -1.0;
+    }
+};
+
+/**
+ * Perf Counters - Linux perf_event_open counters around a code region
+ *
+ * Counts user-space cycles, instructions, L1D/LLC read misses and branch
+ * misses for the calling thread. Each counter is opened on its own, so a PMU
+ * that lacks one event (common in VMs) still reports the rest; counts are
+ * scaled when the kernel multiplexes counters. Unavailable when the kernel
+ * denies access (see /proc/sys/kernel/perf_event_paranoid) or off Linux.
+ *
+ * Usage:
+ *   PerfCounters perf;
+ *   if (perf.available()) {
+ *       perf.start();
+ *       run();
+ *       PerfSample s = perf.stop();
+ *   }
+ */
+class PerfCounters {
+public:
+    PerfCounters() {
+        fds_.fill(-1);
+#ifdef __linux__
+        const std::array<std::pair<uint32_t, uint64_t>, PerfSample::NUM_EVENTS> events = {{
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+            {PERF_TYPE_HW_CACHE, cache_event(PERF_COUNT_HW_CACHE_L1D)},
+            {PERF_TYPE_HW_CACHE, cache_event(PERF_COUNT_HW_CACHE_LL)},
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+        }};
+        for (size_t i = 0; i < events.size(); ++i) {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = events[i].first;
+            attr.config = events[i].second;
+            attr.disabled = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            fds_[i] = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+            if (fds_[i] < 0 && error_.empty()) error_ = std::strerror(errno);
+        }
+#else
+        error_ = "perf_event_open is Linux-only";
+#endif
+    }
+
+    ~PerfCounters() {
+#ifdef __linux__
+        for (int fd : fds_) {
+            if (fd >= 0) close(fd);
+        }
+#endif
+    }
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    /**
+     * True if at least one counter opened
+     */
+    bool available() const {
+        for (int fd : fds_) {
+            if (fd >= 0) return true;
+        }
+        return false;
+    }
+
+    /**
+     * Why the first failing counter could not be opened (empty if all opened)
+     */
+    const std::string& error() const { return error_; }
+
+    void start() {
+#ifdef __linux__
+        for (int fd : fds_) {
+            if (fd < 0) continue;
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    PerfSample stop() {
+        PerfSample sample;
+#ifdef __linux__
+        for (int fd : fds_) {
+            if (fd >= 0) ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        }
+        for (size_t i = 0; i < fds_.size(); ++i) {
+            if (fds_[i] < 0) continue;
+            uint64_t values[3] = {0, 0, 0};     // value, time enabled, time running
+            if (read(fds_[i], values, sizeof(values)) != static_cast<ssize_t>(sizeof(values))) continue;
+            if (values[2] == 0) continue;       // Never scheduled on the PMU
+            sample.counts[i] = static_cast<double>(values[0]) *
+                               static_cast<double>(values[1]) / static_cast<double>(values[2]);
+        }
+#endif
+        return sample;
+    }
+
+private:
+    std::array<int, PerfSample::NUM_EVENTS> fds_;
+    std::string error_;
+
+#ifdef __linux__
+    static uint64_t cache_event(uint64_t cache) {
+        return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    }
+#endif
+};
+
+} // namespace trading
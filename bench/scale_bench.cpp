@@ -0,0 +1,270 @@
+/**
+ * Sentio Scale Bench - End-to-end throughput as symbols and threads scale
+ *
+ * For each symbol count, runs MultiSymbolTrader over every minute of the data
+ * (one on_bar per minute, all symbols in the snapshot) and reports:
+ *   - bars/sec (symbol-bars through on_bar per wall-clock second, all threads)
+ *   - per-minute on_bar latency percentiles
+ *   - peak RSS of the run (Linux: the high-water mark is reset per run)
+ *
+ * A single trader is single-threaded, so thread scaling runs T independent
+ * traders over the same read-only data - the way sweep/walkforward/optimize
+ * spread backtests across cores.
+ *
+ * Usage:
+ *   sentio_scale_bench --symbols 12,100,500 --threads 1,2,4 --days 5
+ *   sentio_synth --symbols 500 --days 250 --out /tmp/synth
+ *   sentio_scale_bench --data-dir /tmp/synth --symbols 50,500 --json scale.json
+ */
+#include "bench_common.h"
+#include "synthetic_market.h"
+#include "utils/config_reader.h"
+#include "utils/data_loader.h"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+using namespace trading;
+
+namespace {
+
+struct Dataset {
+    std::vector<Symbol> symbols;
+    std::vector<std::vector<Bar>> bars;     // Per symbol, minute-aligned
+    size_t minutes = 0;
+};
+
+struct ScaleResult {
+    size_t symbols = 0;
+    size_t threads = 0;
+    size_t minutes = 0;
+    double seconds = 0.0;
+    double bars_per_sec = 0.0;
+    double p50_us = 0.0;
+    double p90_us = 0.0;
+    double p99_us = 0.0;
+    double p999_us = 0.0;
+    double max_us = 0.0;
+    double peak_rss_mb = 0.0;
+    int trades = 0;
+};
+
+std::vector<size_t> parse_list(const std::string& text) {
+    std::vector<size_t> values;
+    std::stringstream ss(text);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        if (!item.empty()) values.push_back(std::stoul(item));
+    }
+    return values;
+}
+
+/**
+ * Reset the peak-RSS high-water mark (Linux >= 4.0)
+ * @return false if unsupported (VmHWM then reports the process-lifetime peak)
+ */
+bool reset_peak_rss() {
+    std::ofstream clear_refs("/proc/self/clear_refs");
+    if (!clear_refs.is_open()) return false;
+    clear_refs << "5";
+    return static_cast<bool>(clear_refs.flush());
+}
+
+double peak_rss_mb() {
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.rfind("VmHWM:", 0) == 0) {
+            return std::stod(line.substr(6)) / 1024.0;   // kB
+        }
+    }
+    return 0.0;
+}
+
+Dataset make_dataset(size_t num_symbols, const std::string& data_dir,
+                     const SyntheticMarketConfig& mc, bool days_set) {
+    Dataset data;
+    if (data_dir.empty()) {
+        data.symbols = synthetic_symbols(num_symbols);
+        auto regimes = generate_regime_path(mc);
+        for (size_t s = 0; s < num_symbols; ++s) {
+            data.bars.push_back(generate_synthetic_bars(data.symbols[s], s, mc, regimes));
+        }
+    } else {
+        std::vector<Symbol> all = utils::ConfigReader::load_symbols(data_dir + "/symbols.conf");
+        if (all.size() < num_symbols) {
+            throw std::runtime_error(data_dir + " has only " + std::to_string(all.size()) + " symbols");
+        }
+        data.symbols.assign(all.begin(), all.begin() + static_cast<std::ptrdiff_t>(num_symbols));
+
+        std::streambuf* saved = std::cout.rdbuf(nullptr);   // Loader logs every file
+        auto loaded = DataLoader::load_from_directory(data_dir, data.symbols, ".bin");
+        std::cout.rdbuf(saved);
+        for (const auto& symbol : data.symbols) data.bars.push_back(std::move(loaded[symbol]));
+    }
+
+    data.minutes = data.bars.front().size();
+    for (const auto& bars : data.bars) data.minutes = std::min(data.minutes, bars.size());
+    if (days_set) {
+        data.minutes = std::min(data.minutes, mc.days * static_cast<size_t>(mc.bars_per_day));
+    }
+    return data;
+}
+
+ScaleResult run_scale(const Dataset& data, size_t num_threads, const TradingConfig& config,
+                      bool rss_reset) {
+    if (rss_reset) reset_peak_rss();
+    std::vector<std::vector<uint32_t>> latencies(num_threads);
+    std::vector<int> trades(num_threads, 0);
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < num_threads; ++t) {
+        workers.emplace_back([&, t]() {
+            MultiSymbolTrader trader(data.symbols, config);
+            std::unordered_map<Symbol, Bar> snapshot;
+            snapshot.reserve(data.symbols.size());
+            auto& lat = latencies[t];
+            lat.reserve(data.minutes);
+
+            for (size_t m = 0; m < data.minutes; ++m) {
+                for (size_t s = 0; s < data.symbols.size(); ++s) {
+                    snapshot[data.symbols[s]] = data.bars[s][m];
+                }
+                auto t0 = std::chrono::steady_clock::now();
+                trader.on_bar(snapshot);
+                auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - t0).count();
+                lat.push_back(static_cast<uint32_t>(std::min<int64_t>(ns, UINT32_MAX)));
+            }
+            trades[t] = trader.get_results().total_trades;
+        });
+    }
+    for (auto& w : workers) w.join();
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::vector<uint32_t> all;
+    for (const auto& lat : latencies) all.insert(all.end(), lat.begin(), lat.end());
+    std::sort(all.begin(), all.end());
+    auto pct = [&](double q) {
+        if (all.empty()) return 0.0;
+        size_t idx = std::min(all.size() - 1, static_cast<size_t>(q * static_cast<double>(all.size())));
+        return all[idx] / 1000.0;
+    };
+
+    ScaleResult r;
+    r.symbols = data.symbols.size();
+    r.threads = num_threads;
+    r.minutes = data.minutes;
+    r.seconds = secs;
+    r.bars_per_sec = static_cast<double>(data.minutes * data.symbols.size() * num_threads) / secs;
+    r.p50_us = pct(0.50);
+    r.p90_us = pct(0.90);
+    r.p99_us = pct(0.99);
+    r.p999_us = pct(0.999);
+    r.max_us = all.empty() ? 0.0 : all.back() / 1000.0;
+    r.peak_rss_mb = peak_rss_mb();
+    r.trades = trades.front();
+    return r;
+}
+
+void print_usage(const char* program) {
+    std::cout << "Usage: " << program << " [options]\n\n"
+              << "  --symbols LIST       Symbol counts, e.g. 12,100,500 (default: 12,50,200)\n"
+              << "  --threads LIST       Concurrent traders, e.g. 1,2,4 (default: 1)\n"
+              << "  --days N             Trading days per run (default: 5; all for --data-dir)\n"
+              << "  --data-dir DIR       Use sentio_synth output instead of generating in memory\n"
+              << "  --seed N             Seed for in-memory data (default: 42)\n"
+              << "  --json FILE          Write results as JSON\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::vector<size_t> symbol_counts = {12, 50, 200};
+    std::vector<size_t> thread_counts = {1};
+    SyntheticMarketConfig mc;
+    bool days_set = false;
+    std::string data_dir;
+    std::string json_file;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--symbols" && i + 1 < argc) symbol_counts = parse_list(argv[++i]);
+        else if (arg == "--threads" && i + 1 < argc) thread_counts = parse_list(argv[++i]);
+        else if (arg == "--days" && i + 1 < argc) { mc.days = std::stoul(argv[++i]); days_set = true; }
+        else if (arg == "--data-dir" && i + 1 < argc) data_dir = argv[++i];
+        else if (arg == "--seed" && i + 1 < argc) mc.seed = std::stoull(argv[++i]);
+        else if (arg == "--json" && i + 1 < argc) json_file = argv[++i];
+        else {
+            print_usage(argv[0]);
+            return arg == "--help" || arg == "-h" ? 0 : 1;
+        }
+    }
+    if (symbol_counts.empty() || thread_counts.empty() ||
+        std::count(symbol_counts.begin(), symbol_counts.end(), 0u) > 0 ||
+        std::count(thread_counts.begin(), thread_counts.end(), 0u) > 0) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    use_market_timezone();
+    std::sort(symbol_counts.begin(), symbol_counts.end());
+    const TradingConfig config = bench_trading_config();
+    const bool rss_reset = reset_peak_rss();
+
+    std::cout << std::right << std::setw(8) << "symbols" << std::setw(8) << "threads"
+              << std::setw(9) << "minutes" << std::setw(14) << "bars/s"
+              << std::setw(10) << "p50 us" << std::setw(10) << "p90 us" << std::setw(10) << "p99 us"
+              << std::setw(11) << "p99.9 us" << std::setw(11) << "max us"
+              << std::setw(11) << "peak MB" << std::setw(8) << "trades" << "\n"
+              << std::string(110, '-') << std::endl;
+
+    nlohmann::json rows = nlohmann::json::array();
+    try {
+        for (size_t n : symbol_counts) {
+            Dataset data = make_dataset(n, data_dir, mc, days_set);
+            for (size_t t : thread_counts) {
+                ScaleResult r = run_scale(data, t, config, rss_reset);
+                std::cout << std::fixed << std::setw(8) << r.symbols << std::setw(8) << r.threads
+                          << std::setw(9) << r.minutes << std::setw(14) << std::setprecision(0) << r.bars_per_sec
+                          << std::setprecision(1) << std::setw(10) << r.p50_us << std::setw(10) << r.p90_us
+                          << std::setw(10) << r.p99_us << std::setw(11) << r.p999_us << std::setw(11) << r.max_us
+                          << std::setw(11) << r.peak_rss_mb << std::setw(8) << r.trades << std::endl;
+                rows.push_back({
+                    {"symbols", r.symbols}, {"threads", r.threads}, {"minutes", r.minutes},
+                    {"seconds", r.seconds}, {"bars_per_sec", r.bars_per_sec},
+                    {"on_bar_us", {{"p50", r.p50_us}, {"p90", r.p90_us}, {"p99", r.p99_us},
+                                   {"p999", r.p999_us}, {"max", r.max_us}}},
+                    {"peak_rss_mb", r.peak_rss_mb}, {"trades", r.trades}
+                });
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "❌ " << e.what() << "\n";
+        return 1;
+    }
+    if (!rss_reset) {
+        std::cout << "(peak RSS could not be reset per run: values are the process-wide peak)\n";
+    }
+
+    if (!json_file.empty()) {
+        std::ofstream out(json_file);
+        if (!out.is_open()) {
+            std::cerr << "Cannot write " << json_file << "\n";
+            return 1;
+        }
+        out << nlohmann::json{{"data_dir", data_dir}, {"results", rows}}.dump(2) << "\n";
+        std::cout << "Wrote " << json_file << "\n";
+    }
+    return 0;
+}
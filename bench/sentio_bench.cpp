@@ -0,0 +1,524 @@
+/**
+ * Sentio Bench - Microbenchmarks for the hot paths
+ *
+ * Each benchmark reports median ns/op over several repetitions, heap
+ * allocations/op (global operator new calls) and throughput. Results can be
+ * saved as a baseline and later runs compared against it; a benchmark slower
+ * than baseline × (1 + tolerance), or allocating more per op, is flagged and
+ * the run exits non-zero.
+ *
+ * With --perf, Linux hardware counters (perf_event_open) are read around the
+ * timed runs too, and each benchmark gets a second line with IPC and cycles,
+ * instructions, L1D/LLC misses and branch misses per op.
+ *
+ * Usage:
+ *   sentio_bench                                   # run everything
+ *   sentio_bench --filter on_bar --reps 9
+ *   sentio_bench --filter on_bar --perf
+ *   sentio_bench --save-baseline bench/baseline.json
+ *   sentio_bench --baseline bench/baseline.json --tolerance 0.15
+ *
+ * Inputs are synthetic and seeded (see synthetic_market.h), so runs are
+ * repeatable; the process forces TZ=America/New_York like the engine expects.
+ */
+#include "bench_common.h"
+#include "perf_counters.h"
+#include "synthetic_market.h"
+#include "strategy/sigor_strategy.h"
+#include "trading/alpaca_cost_model.h"
+#include "trading/multi_symbol_trader.h"
+#include "utils/circular_buffer.h"
+#include "utils/data_loader.h"
+#include "utils/live_bar_parser.h"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <unistd.h>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// ============================================================================
+// Allocation counting
+// ============================================================================
+
+namespace {
+std::atomic<uint64_t> g_allocations{0};
+}
+
+void* operator new(std::size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    return std::malloc(size ? size : 1);
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+using namespace trading;
+
+namespace {
+
+// ============================================================================
+// Harness
+// ============================================================================
+
+struct Benchmark {
+    std::string name;
+    std::string unit;                       // What one item is (bars, signals, ...)
+    double items_per_op = 1.0;
+    std::function<void(size_t)> run;        // Perform n ops
+    std::function<void()> setup;            // Before each repetition (optional)
+    size_t fixed_ops = 0;                   // >0: every repetition runs exactly this many ops
+};
+
+struct BenchResult {
+    std::string name;
+    std::string unit;
+    double ns_per_op = 0.0;
+    double allocs_per_op = 0.0;
+    double items_per_sec = 0.0;
+    size_t ops = 0;
+    PerfSample perf;                        // Counter totals over all repetitions (--perf)
+    size_t perf_ops = 0;                    // Ops covered by perf
+};
+
+struct BenchOptions {
+    std::string filter;
+    double min_time = 0.2;                  // Seconds per repetition (calibrated runs)
+    int reps = 5;
+    std::string baseline_file;
+    std::string save_baseline_file;
+    std::string json_file;
+    double tolerance = 0.20;
+    bool perf = false;                      // Collect hardware counters
+};
+
+double seconds_since(std::chrono::steady_clock::time_point t0) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+BenchResult measure(const Benchmark& b, const BenchOptions& opt, PerfCounters* perf) {
+    size_t ops = b.fixed_ops;
+    if (ops == 0) {
+        // Calibrate: double n until one batch takes a tenth of min_time
+        ops = 1;
+        while (true) {
+            auto t0 = std::chrono::steady_clock::now();
+            b.run(ops);
+            double secs = seconds_since(t0);
+            if (secs >= opt.min_time / 10 || ops >= (size_t(1) << 40)) {
+                double per_op = secs / static_cast<double>(ops);
+                ops = std::max<size_t>(1, static_cast<size_t>(opt.min_time / std::max(per_op, 1e-12)));
+                break;
+            }
+            ops *= 2;
+        }
+    }
+
+    BenchResult r;
+    std::vector<double> ns(static_cast<size_t>(std::max(1, opt.reps)));
+    uint64_t allocations = 0;
+    for (auto& sample : ns) {
+        if (b.setup) b.setup();
+        uint64_t a0 = g_allocations.load(std::memory_order_relaxed);
+        if (perf) perf->start();
+        auto t0 = std::chrono::steady_clock::now();
+        b.run(ops);
+        double secs = seconds_since(t0);
+        if (perf) {
+            r.perf.add(perf->stop());
+            r.perf_ops += ops;
+        }
+        allocations += g_allocations.load(std::memory_order_relaxed) - a0;
+        sample = secs * 1e9 / static_cast<double>(ops);
+    }
+    std::sort(ns.begin(), ns.end());
+
+    r.name = b.name;
+    r.unit = b.unit;
+    r.ns_per_op = ns[ns.size() / 2];
+    r.allocs_per_op = static_cast<double>(allocations) / static_cast<double>(ops * ns.size());
+    r.items_per_sec = r.ns_per_op > 0 ? b.items_per_op * 1e9 / r.ns_per_op : 0.0;
+    r.ops = ops;
+    return r;
+}
+
+std::string human_rate(double per_sec) {
+    std::ostringstream ss;
+    ss << std::fixed << std::setprecision(2);
+    if (per_sec >= 1e9) ss << per_sec / 1e9 << "G";
+    else if (per_sec >= 1e6) ss << per_sec / 1e6 << "M";
+    else if (per_sec >= 1e3) ss << per_sec / 1e3 << "k";
+    else ss << per_sec;
+    return ss.str();
+}
+
+/**
+ * "    perf: IPC 2.41 | cycles 1.2k | instructions 2.9k | ..." (counts per op)
+ */
+void print_perf(const BenchResult& r) {
+    std::cout << "    perf: IPC ";
+    double ipc = r.perf.ipc();
+    if (ipc >= 0.0) std::cout << std::fixed << std::setprecision(2) << ipc;
+    else std::cout << "n/a";
+    for (size_t i = 0; i < PerfSample::NUM_EVENTS; ++i) {
+        std::cout << " | " << perf_event_name(static_cast<PerfEvent>(i)) << " ";
+        if (r.perf.counts[i] < 0.0 || r.perf_ops == 0) {
+            std::cout << "n/a";
+        } else {
+            std::cout << human_rate(r.perf.counts[i] / static_cast<double>(r.perf_ops));
+        }
+    }
+    std::cout << "  (per op)\n";
+}
+
+/**
+ * Discards std::cout for its lifetime (the loaders log every file they read)
+ */
+class QuietStdout {
+public:
+    QuietStdout() : saved_(std::cout.rdbuf(nullptr)) {}
+    ~QuietStdout() { std::cout.rdbuf(saved_); }
+private:
+    std::streambuf* saved_;
+};
+
+// ============================================================================
+// Benchmarks
+// ============================================================================
+
+Benchmark sigor_generate_signal() {
+    SyntheticMarketConfig mc;
+    mc.days = 10;
+    auto bars = std::make_shared<std::vector<Bar>>(generate_synthetic_bars("S000", 0, mc));
+    auto sigor = std::make_shared<SigorStrategy>(SigorConfig());
+    auto cursor = std::make_shared<size_t>(0);
+    const int bars_per_day = mc.bars_per_day;
+
+    Benchmark b;
+    b.name = "sigor/generate_signal";
+    b.unit = "signals";
+    b.run = [=](size_t n) {
+        double sink = 0.0;
+        for (size_t i = 0; i < n; ++i) {
+            size_t idx = (*cursor)++ % bars->size();
+            int bar_index = static_cast<int>(idx % bars_per_day) + 1;
+            sink += sigor->generate_signal((*bars)[idx], bar_index).probability;
+        }
+        if (sink == -1.0) std::cerr << "";   // Keep the loop observable
+    };
+    return b;
+}
+
+Benchmark trader_on_bar(size_t num_symbols) {
+    // 1 untimed warmup day, then 2 timed days per repetition on a fresh trader
+    SyntheticMarketConfig mc;
+    mc.days = 3;
+    auto symbols = synthetic_symbols(num_symbols);
+    auto regimes = generate_regime_path(mc);
+    auto snapshots = std::make_shared<std::vector<std::unordered_map<Symbol, Bar>>>(
+        static_cast<size_t>(mc.days * mc.bars_per_day));
+    for (size_t s = 0; s < num_symbols; ++s) {
+        auto bars = generate_synthetic_bars(symbols[s], s, mc, regimes);
+        for (size_t i = 0; i < bars.size(); ++i) (*snapshots)[i][symbols[s]] = bars[i];
+    }
+
+    auto config = bench_trading_config();
+    auto trader = std::make_shared<std::unique_ptr<MultiSymbolTrader>>();
+    const size_t warm = static_cast<size_t>(mc.bars_per_day);
+
+    Benchmark b;
+    b.name = "trader/on_bar/" + std::to_string(num_symbols);
+    b.unit = "bars";
+    b.items_per_op = static_cast<double>(num_symbols);
+    b.fixed_ops = snapshots->size() - warm;
+    b.setup = [=]() {
+        *trader = std::make_unique<MultiSymbolTrader>(symbols, config);
+        for (size_t i = 0; i < warm; ++i) (*trader)->on_bar((*snapshots)[i]);
+    };
+    b.run = [=](size_t n) {
+        for (size_t i = 0; i < n; ++i) (*trader)->on_bar((*snapshots)[warm + i]);
+    };
+    return b;
+}
+
+Benchmark data_load(const std::string& path, size_t num_bars, const std::string& name) {
+    Benchmark b;
+    b.name = name;
+    b.unit = "bars";
+    b.items_per_op = static_cast<double>(num_bars);
+    b.run = [=](size_t n) {
+        QuietStdout quiet;
+        for (size_t i = 0; i < n; ++i) {
+            if (DataLoader::load(path).size() != num_bars) {
+                throw std::runtime_error("Unexpected bar count from " + path);
+            }
+        }
+    };
+    return b;
+}
+
+Benchmark cost_model() {
+    Benchmark b;
+    b.name = "cost/calculate_trade_cost";
+    b.unit = "calls";
+    b.run = [](size_t n) {
+        const Symbol symbol = "TQQQ";
+        double sink = 0.0;
+        for (size_t i = 0; i < n; ++i) {
+            double price = 50.0 + static_cast<double>(i % 100) * 0.1;
+            int shares = 100 + static_cast<int>(i % 500);
+            bool is_buy = (i & 1) == 0;
+            sink += AlpacaCostModel::calculate_trade_cost(symbol, price, shares, is_buy,
+                                                          2000000, 0.03,
+                                                          static_cast<int>(i % 390)).total_cost;
+        }
+        if (sink == -1.0) std::cerr << "";
+    };
+    return b;
+}
+
+Benchmark circular_buffer_push() {
+    auto buffer = std::make_shared<CircularBuffer<double>>(256);
+    Benchmark b;
+    b.name = "circular_buffer/push_back";
+    b.unit = "pushes";
+    b.run = [=](size_t n) {
+        for (size_t i = 0; i < n; ++i) buffer->push_back(static_cast<double>(i));
+        if (buffer->back() == -1.0) std::cerr << "";
+    };
+    return b;
+}
+
+Benchmark circular_buffer_window() {
+    auto buffer = std::make_shared<CircularBuffer<double>>(64);
+    for (int i = 0; i < 64; ++i) buffer->push_back(i);
+    Benchmark b;
+    b.name = "circular_buffer/push_and_sum_64";
+    b.unit = "windows";
+    b.run = [=](size_t n) {
+        double sink = 0.0;
+        for (size_t i = 0; i < n; ++i) {
+            buffer->push_back(static_cast<double>(i));
+            double sum = 0.0;
+            for (size_t k = 0; k < buffer->size(); ++k) sum += (*buffer)[k];
+            sink += sum;
+        }
+        if (sink == -1.0) std::cerr << "";
+    };
+    return b;
+}
+
+Benchmark live_json_parse() {
+    // Lines in the bridge's format, incl. the optional fields it also sends
+    SyntheticMarketConfig mc;
+    mc.days = 1;
+    auto bars = generate_synthetic_bars("TQQQ", 0, mc);
+    auto lines = std::make_shared<std::vector<std::string>>();
+    for (const auto& bar : bars) {
+        nlohmann::json j = {
+            {"symbol", bar.symbol},
+            {"timestamp_ms", to_timestamp_ms(bar.timestamp)},
+            {"open", bar.open}, {"high", bar.high}, {"low", bar.low}, {"close", bar.close},
+            {"volume", bar.volume}, {"vwap", (bar.high + bar.low) / 2}, {"trade_count", 120}
+        };
+        lines->push_back(j.dump());
+    }
+
+    Benchmark b;
+    b.name = "live/parse_json_bar";
+    b.unit = "lines";
+    b.run = [=](size_t n) {
+        Bar bar;
+        bar.close = 0.0;
+        for (size_t i = 0; i < n; ++i) parse_live_bar((*lines)[i % lines->size()], bar);
+        if (bar.close == -1.0) std::cerr << "";
+    };
+    return b;
+}
+
+// ============================================================================
+// Baselines
+// ============================================================================
+
+nlohmann::json results_json(const std::vector<BenchResult>& results) {
+    nlohmann::json benchmarks = nlohmann::json::object();
+    for (const auto& r : results) {
+        benchmarks[r.name] = {
+            {"ns_per_op", r.ns_per_op},
+            {"allocs_per_op", r.allocs_per_op},
+            {"items_per_sec", r.items_per_sec},
+            {"unit", r.unit}
+        };
+        if (r.perf_ops > 0) {
+            nlohmann::json perf = nlohmann::json::object();
+            double ipc = r.perf.ipc();
+            if (ipc >= 0.0) perf["ipc"] = ipc;
+            for (size_t i = 0; i < PerfSample::NUM_EVENTS; ++i) {
+                if (r.perf.counts[i] < 0.0) continue;
+                perf[std::string(perf_event_name(static_cast<PerfEvent>(i))) + "_per_op"] =
+                    r.perf.counts[i] / static_cast<double>(r.perf_ops);
+            }
+            benchmarks[r.name]["perf"] = perf;
+        }
+    }
+    return {{"benchmarks", benchmarks}};
+}
+
+void print_usage(const char* program) {
+    std::cout << "Usage: " << program << " [options]\n\n"
+              << "  --filter TEXT          Only benchmarks whose name contains TEXT\n"
+              << "  --min-time SEC         Target time per repetition (default: 0.2)\n"
+              << "  --reps N               Repetitions, median reported (default: 5)\n"
+              << "  --baseline FILE        Compare against a saved baseline\n"
+              << "  --tolerance X          Allowed ns/op slowdown vs baseline (default: 0.20)\n"
+              << "  --save-baseline FILE   Write this run as a baseline\n"
+              << "  --json FILE            Write results as JSON\n"
+              << "  --perf                 Also read hardware counters (Linux perf_event_open)\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    BenchOptions opt;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--filter" && i + 1 < argc) opt.filter = argv[++i];
+        else if (arg == "--min-time" && i + 1 < argc) opt.min_time = std::stod(argv[++i]);
+        else if (arg == "--reps" && i + 1 < argc) opt.reps = std::stoi(argv[++i]);
+        else if (arg == "--baseline" && i + 1 < argc) opt.baseline_file = argv[++i];
+        else if (arg == "--tolerance" && i + 1 < argc) opt.tolerance = std::stod(argv[++i]);
+        else if (arg == "--save-baseline" && i + 1 < argc) opt.save_baseline_file = argv[++i];
+        else if (arg == "--json" && i + 1 < argc) opt.json_file = argv[++i];
+        else if (arg == "--perf") opt.perf = true;
+        else {
+            print_usage(argv[0]);
+            return arg == "--help" || arg == "-h" ? 0 : 1;
+        }
+    }
+
+    use_market_timezone();
+
+    std::unique_ptr<PerfCounters> perf;
+    if (opt.perf) {
+        perf = std::make_unique<PerfCounters>();
+        if (!perf->available()) {
+            std::cerr << "Hardware counters unavailable (" << perf->error() << "): needs a PMU"
+                      << " and kernel.perf_event_paranoid <= 2. Timing only.\n";
+            perf.reset();
+        } else if (!perf->error().empty()) {
+            std::cerr << "Some hardware counters unavailable (" << perf->error() << ")\n";
+        }
+    }
+
+    // Loader inputs: 20 days of one symbol in both on-disk formats
+    namespace fs = std::filesystem;
+    fs::path tmp_dir = fs::temp_directory_path() / ("sentio_bench_" + std::to_string(::getpid()));
+    fs::create_directories(tmp_dir);
+    SyntheticMarketConfig load_mc;
+    load_mc.days = 20;
+    auto load_bars = generate_synthetic_bars("QQQ", 0, load_mc);
+    std::string bin_path = (tmp_dir / "QQQ.bin").string();
+    std::string csv_path = (tmp_dir / "QQQ.csv").string();
+    write_binary_bars(load_bars, bin_path);
+    write_csv_bars(load_bars, csv_path);
+
+    std::vector<std::function<Benchmark()>> registry = {
+        sigor_generate_signal,
+        [] { return trader_on_bar(12); },
+        [] { return trader_on_bar(200); },
+        [&] { return data_load(bin_path, load_bars.size(), "data/load_binary"); },
+        [&] { return data_load(csv_path, load_bars.size(), "data/load_csv"); },
+        cost_model,
+        circular_buffer_push,
+        circular_buffer_window,
+        live_json_parse,
+    };
+
+    nlohmann::json baseline;
+    if (!opt.baseline_file.empty()) {
+        std::ifstream in(opt.baseline_file);
+        if (!in.is_open()) {
+            std::cerr << "Cannot open baseline: " << opt.baseline_file << "\n";
+            return 1;
+        }
+        baseline = nlohmann::json::parse(in)["benchmarks"];
+    }
+
+    std::cout << std::left << std::setw(34) << "Benchmark" << std::right
+              << std::setw(14) << "ns/op" << std::setw(12) << "allocs/op"
+              << std::setw(20) << "throughput";
+    if (!baseline.is_null()) std::cout << std::setw(14) << "vs baseline";
+    std::cout << "\n" << std::string(baseline.is_null() ? 80 : 94, '-') << "\n";
+
+    std::vector<BenchResult> results;
+    size_t regressions = 0;
+    int status = 0;
+    try {
+        for (const auto& make : registry) {
+            Benchmark b = make();
+            if (!opt.filter.empty() && b.name.find(opt.filter) == std::string::npos) continue;
+            BenchResult r = measure(b, opt, perf.get());
+            results.push_back(r);
+
+            std::cout << std::left << std::setw(34) << r.name << std::right << std::fixed
+                      << std::setw(14) << std::setprecision(1) << r.ns_per_op
+                      << std::setw(12) << std::setprecision(2) << r.allocs_per_op
+                      << std::setw(20) << (human_rate(r.items_per_sec) + " " + r.unit + "/s");
+            if (!baseline.is_null() && baseline.contains(r.name)) {
+                double base_ns = baseline[r.name].value("ns_per_op", 0.0);
+                double base_allocs = baseline[r.name].value("allocs_per_op", 0.0);
+                double change = base_ns > 0 ? r.ns_per_op / base_ns - 1.0 : 0.0;
+                bool slower = change > opt.tolerance;
+                bool allocs = r.allocs_per_op > base_allocs + 0.5;
+                std::cout << std::setw(13) << std::showpos << std::setprecision(1)
+                          << (change * 100) << "%" << std::noshowpos;
+                if (slower) std::cout << "  REGRESSION";
+                if (allocs) std::cout << "  ALLOCS (baseline " << std::setprecision(2) << base_allocs << ")";
+                if (slower || allocs) regressions++;
+            }
+            std::cout << std::endl;
+            if (r.perf_ops > 0) print_perf(r);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Benchmark failed: " << e.what() << "\n";
+        status = 1;
+    }
+    fs::remove_all(tmp_dir);
+
+    nlohmann::json report = results_json(results);
+    for (const auto& file : {opt.json_file, opt.save_baseline_file}) {
+        if (file.empty()) continue;
+        std::ofstream out(file);
+        if (!out.is_open()) {
+            std::cerr << "Cannot write " << file << "\n";
+            return 1;
+        }
+        out << report.dump(2) << "\n";
+        std::cout << "Wrote " << file << "\n";
+    }
+
+    if (regressions > 0) {
+        std::cout << "\n" << regressions << " benchmark(s) regressed beyond "
+                  << std::setprecision(0) << (opt.tolerance * 100) << "% of baseline\n";
+        return 1;
+    }
+    return status;
+}
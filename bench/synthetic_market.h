@@ -0,0 +1,214 @@
+#pragma once
+#include "core/bar.h"
+#include "core/bar_id_utils.h"
+#include "utils/binary_io.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace trading {
+
+/**
+ * Synthetic Market - Deterministic regime-switching minute bars
+ *
+ * A market-wide Markov chain over the regimes of generate_regime_test_data.py
+ * (trending up/down, choppy, high/low volatility) drives every symbol; each
+ * symbol adds its own GBM shocks, and odd-indexed symbols are the inverse leg
+ * of a pair (like TQQQ/SQQQ), so their drift flips. Volume follows a U-shaped
+ * intraday profile scaled by regime.
+ *
+ * Sessions are 391 bars (9:30-16:00 local time) on a weekday calendar from
+ * 2025-01-06; run with TZ=America/New_York for the engine's EOD logic to fire
+ * at 15:59. Same config → same bars.
+ */
+enum class SyntheticRegime { TRENDING_UP, TRENDING_DOWN, CHOPPY, HIGH_VOLATILITY, LOW_VOLATILITY };
+
+struct SyntheticMarketConfig {
+    size_t days = 5;
+    int bars_per_day = 391;
+    double base_price = 50.0;
+    double base_volume = 20000.0;
+    double mean_regime_bars = 120.0;        // Expected regime length (0 = always CHOPPY)
+    uint64_t seed = 42;
+};
+
+/**
+ * Per-minute drift and volatility, and volume multiplier, for a regime
+ */
+struct SyntheticRegimeParams {
+    double drift;
+    double volatility;
+    double volume;
+};
+
+inline SyntheticRegimeParams synthetic_regime_params(SyntheticRegime regime) {
+    switch (regime) {
+        case SyntheticRegime::TRENDING_UP:     return {0.00015, 0.0012, 1.2};
+        case SyntheticRegime::TRENDING_DOWN:   return {-0.00015, 0.0012, 1.3};
+        case SyntheticRegime::HIGH_VOLATILITY: return {0.0, 0.0030, 2.0};
+        case SyntheticRegime::LOW_VOLATILITY:  return {0.0, 0.0006, 0.6};
+        case SyntheticRegime::CHOPPY:
+        default:                               return {0.0, 0.0010, 1.0};
+    }
+}
+
+/**
+ * Market regime for every bar (shared by all symbols of one config)
+ */
+inline std::vector<SyntheticRegime> generate_regime_path(const SyntheticMarketConfig& config) {
+    size_t total = config.days * static_cast<size_t>(config.bars_per_day);
+    std::vector<SyntheticRegime> path(total, SyntheticRegime::CHOPPY);
+    if (config.mean_regime_bars <= 0.0) return path;
+
+    std::mt19937_64 rng(config.seed);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    std::uniform_int_distribution<int> pick(0, 4);
+    const double switch_prob = 1.0 / config.mean_regime_bars;
+    auto regime = static_cast<SyntheticRegime>(pick(rng));
+    for (size_t i = 0; i < total; ++i) {
+        if (uniform(rng) < switch_prob) regime = static_cast<SyntheticRegime>(pick(rng));
+        path[i] = regime;
+    }
+    return path;
+}
+
+/**
+ * Symbol names S000, S001, ...
+ */
+inline std::vector<Symbol> synthetic_symbols(size_t count) {
+    std::vector<Symbol> symbols;
+    char name[32];
+    for (size_t i = 0; i < count; ++i) {
+        std::snprintf(name, sizeof(name), "S%03zu", i);
+        symbols.emplace_back(name);
+    }
+    return symbols;
+}
+
+/**
+ * Local 9:30 open of the n-th weekday session from 2025-01-06
+ */
+inline Timestamp synthetic_session_open(size_t day) {
+    struct tm tm_info = {};
+    tm_info.tm_year = 2025 - 1900;
+    tm_info.tm_mon = 0;
+    tm_info.tm_mday = 6;
+    tm_info.tm_hour = 9;
+    tm_info.tm_min = 30;
+    tm_info.tm_isdst = -1;
+    // Advance whole weeks, then the remaining weekdays (the start is a Monday)
+    tm_info.tm_mday += static_cast<int>(day / 5) * 7 + static_cast<int>(day % 5);
+    return std::chrono::system_clock::from_time_t(std::mktime(&tm_info));
+}
+
+/**
+ * Minute bars for one symbol over a precomputed regime path
+ * symbol_index varies the price level and seed, and picks the pair leg
+ */
+inline std::vector<Bar> generate_synthetic_bars(const Symbol& symbol, size_t symbol_index,
+                                                const SyntheticMarketConfig& config,
+                                                const std::vector<SyntheticRegime>& regimes) {
+    std::mt19937_64 rng(config.seed * 1000003ULL + symbol_index + 1);
+    std::normal_distribution<double> normal(0.0, 1.0);
+    std::lognormal_distribution<double> volume_noise(0.0, 0.4);
+
+    const double direction = (symbol_index % 2 == 0) ? 1.0 : -1.0;
+    const double session = config.bars_per_day - 1;
+    double price = config.base_price * (1.0 + 0.05 * static_cast<double>(symbol_index % 40));
+
+    std::vector<Bar> bars;
+    bars.reserve(regimes.size());
+    size_t i = 0;
+    for (size_t d = 0; d < config.days; ++d) {
+        Timestamp open_time = synthetic_session_open(d);
+        for (int m = 0; m < config.bars_per_day; ++m, ++i) {
+            SyntheticRegimeParams rp = synthetic_regime_params(regimes[i]);
+            Bar bar;
+            bar.symbol = symbol;
+            bar.timestamp = open_time + std::chrono::minutes(m);
+            bar.bar_id = generate_bar_id(to_timestamp_ms(bar.timestamp), symbol);
+            bar.open = price;
+            price *= std::exp(direction * rp.drift + rp.volatility * normal(rng));
+            bar.close = price;
+            double wick = rp.volatility * 0.5;
+            bar.high = std::max(bar.open, bar.close) * (1.0 + wick * std::abs(normal(rng)));
+            bar.low = std::min(bar.open, bar.close) * (1.0 - wick * std::abs(normal(rng)));
+
+            // U-shaped: heavy open, lighter midday, pickup into the close
+            double t = static_cast<double>(m);
+            double profile = 1.0 + 2.0 * std::exp(-t / 30.0) + std::exp(-(session - t) / 30.0);
+            bar.volume = static_cast<Volume>(config.base_volume * rp.volume * profile * volume_noise(rng));
+            bars.push_back(bar);
+        }
+    }
+    return bars;
+}
+
+inline std::vector<Bar> generate_synthetic_bars(const Symbol& symbol, size_t symbol_index,
+                                                const SyntheticMarketConfig& config) {
+    return generate_synthetic_bars(symbol, symbol_index, config, generate_regime_path(config));
+}
+
+/**
+ * Write bars in the downloader's binary format (what DataLoader reads from .bin):
+ * u64 count, then per bar: u32 length + ISO timestamp text, i64 epoch seconds,
+ * f64 open/high/low/close, u64 volume
+ */
+inline void write_binary_bars(const std::vector<Bar>& bars, const std::string& path) {
+    utils::BinaryWriter out;
+    out.put<uint64_t>(bars.size());
+    char iso[32];
+    for (const auto& bar : bars) {
+        int64_t epoch = std::chrono::duration_cast<std::chrono::seconds>(
+            bar.timestamp.time_since_epoch()).count();
+        time_t t = static_cast<time_t>(epoch);
+        struct tm tm_info;
+        gmtime_r(&t, &tm_info);
+        size_t len = std::strftime(iso, sizeof(iso), "%Y-%m-%dT%H:%M:%SZ", &tm_info);
+
+        out.put<uint32_t>(static_cast<uint32_t>(len));
+        out.put_bytes(iso, len);
+        out.put(epoch);
+        out.put(bar.open);
+        out.put(bar.high);
+        out.put(bar.low);
+        out.put(bar.close);
+        out.put<uint64_t>(static_cast<uint64_t>(bar.volume));
+    }
+
+    std::ofstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot create binary file: " + path);
+    }
+    file.write(out.data().data(), static_cast<std::streamsize>(out.size()));
+    if (!file) {
+        throw std::runtime_error("Error writing binary file: " + path);
+    }
+}
+
+/**
+ * Write bars as CSV (timestamp_ms,symbol,open,high,low,close,volume)
+ */
+inline void write_csv_bars(const std::vector<Bar>& bars, const std::string& path) {
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot create CSV file: " + path);
+    }
+    file << "timestamp_ms,symbol,open,high,low,close,volume\n";
+    file.precision(10);
+    for (const auto& bar : bars) {
+        file << to_timestamp_ms(bar.timestamp) << ',' << bar.symbol << ','
+             << bar.open << ',' << bar.high << ',' << bar.low << ',' << bar.close << ','
+             << bar.volume << '\n';
+    }
+}
+
+} // namespace trading
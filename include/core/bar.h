@@ -20,6 +20,10 @@ struct Bar {
     // Symbol name for bar_id generation and validation
     std::string symbol;
 
+    // Live mode: carried forward from an earlier minute (no new print this minute)
+    // Stale bars mark positions but are never fed into indicators
+    bool stale = false;
+
     Bar() = default;
     Bar(Timestamp ts, Price o, Price h, Price l, Price c, Volume v, const std::string& sym = "")
         : timestamp(ts), open(o), high(h), low(l), close(c), volume(v), symbol(sym) {}
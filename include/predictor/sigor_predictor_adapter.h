@@ -32,19 +32,16 @@ public:
         : symbol_(symbol), sigor_(config) {}
 
     /**
-     * Generate multi-horizon prediction from features
+     * Generate multi-horizon prediction from the cached signal
      *
      * For SIGOR:
-     * - Features are ignored (SIGOR uses bar data directly)
-     * - Current bar must be provided via update()
-     * - Returns cached signal from last update()
+     * - No feature vector (SIGOR uses bar data directly)
+     * - Current bar must be provided via update_with_bar()
+     * - Returns cached signal from last update_with_bar()
      *
-     * @param features Ignored (SIGOR doesn't use EWRLS features)
      * @return Multi-horizon prediction structure
      */
-    MultiHorizonPredictor::MultiHorizonPrediction predict(const Eigen::VectorXd& features) {
-        (void)features;  // Unused - SIGOR uses bar data directly
-
+    MultiHorizonPredictor::MultiHorizonPrediction predict() const {
         MultiHorizonPredictor::MultiHorizonPrediction result;
 
         if (!has_signal_) {
@@ -116,7 +113,7 @@ public:
         auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(duration).count();
         int bar_index_of_day = utils::get_bar_index_of_day(millis);
 
-        last_signal_ = sigor_.generate_signal(bar, symbol_, bar_index_of_day);
+        last_signal_ = sigor_.generate_signal(bar, bar_index_of_day);
         has_signal_ = true;
     }
 
@@ -135,6 +132,53 @@ public:
         has_signal_ = false;
     }
 
+    /**
+     * Switch to a new SIGOR configuration, keeping detector history
+     * (the cached signal is replaced by the next update_with_bar())
+     */
+    void reconfigure(const SigorConfig& config) {
+        sigor_.reconfigure(config);
+    }
+
+    /**
+     * Write predictor state (detectors + cached signal) for a checkpoint
+     */
+    void save_state(utils::BinaryWriter& out) const {
+        sigor_.save_state(out);
+        out.put(has_signal_);
+        out.put(last_signal_.timestamp);
+        out.put(last_signal_.probability);
+        out.put(last_signal_.confidence);
+        out.put(last_signal_.is_long);
+        out.put(last_signal_.is_short);
+        out.put(last_signal_.is_neutral);
+        for (double p : {last_signal_.prob_boll, last_signal_.prob_rsi, last_signal_.prob_mom,
+                         last_signal_.prob_vwap, last_signal_.prob_orb, last_signal_.prob_ofi,
+                         last_signal_.prob_vol}) {
+            out.put(p);
+        }
+    }
+
+    /**
+     * Restore state written by save_state()
+     * @throws runtime_error if the SIGOR configuration differs
+     */
+    void load_state(utils::BinaryReader& in) {
+        sigor_.load_state(in);
+        in.get(has_signal_);
+        in.get(last_signal_.timestamp);
+        in.get(last_signal_.probability);
+        in.get(last_signal_.confidence);
+        in.get(last_signal_.is_long);
+        in.get(last_signal_.is_short);
+        in.get(last_signal_.is_neutral);
+        for (double* p : {&last_signal_.prob_boll, &last_signal_.prob_rsi, &last_signal_.prob_mom,
+                          &last_signal_.prob_vwap, &last_signal_.prob_orb, &last_signal_.prob_ofi,
+                          &last_signal_.prob_vol}) {
+            in.get(*p);
+        }
+    }
+
     /**
      * Get last SIGOR signal (for debugging/monitoring)
      */
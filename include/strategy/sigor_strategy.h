@@ -1,6 +1,7 @@
 #pragma once
 
 #include "core/bar.h"
+#include "utils/binary_io.h"
 #include <vector>
 #include <cstdint>
 #include <string>
@@ -35,12 +36,23 @@ struct SigorConfig {
     int warmup_bars = 50;
 };
 
+inline bool operator==(const SigorConfig& a, const SigorConfig& b) {
+    return a.k == b.k &&
+           a.w_boll == b.w_boll && a.w_rsi == b.w_rsi && a.w_mom == b.w_mom &&
+           a.w_vwap == b.w_vwap && a.w_orb == b.w_orb && a.w_ofi == b.w_ofi &&
+           a.w_vol == b.w_vol &&
+           a.win_boll == b.win_boll && a.win_rsi == b.win_rsi && a.win_mom == b.win_mom &&
+           a.win_vwap == b.win_vwap && a.orb_opening_bars == b.orb_opening_bars &&
+           a.vol_window == b.vol_window && a.warmup_bars == b.warmup_bars;
+}
+
+inline bool operator!=(const SigorConfig& a, const SigorConfig& b) { return !(a == b); }
+
 /**
  * Sigor Strategy Signal Output
  */
 struct SigorSignal {
     Timestamp timestamp;
-    std::string symbol;
     double probability;      // 0..1 (0.5 = neutral)
     double confidence;       // 0..1 detector agreement
     bool is_long;           // true if probability > 0.5
@@ -79,10 +91,9 @@ public:
     /**
      * Generate signal from new bar
      * @param bar Current bar data
-     * @param symbol Symbol being traded
      * @param bar_index_of_day 1-based bar index within trading day (1-391), -1 if market closed
      */
-    SigorSignal generate_signal(const Bar& bar, const std::string& symbol, int bar_index_of_day);
+    SigorSignal generate_signal(const Bar& bar, int bar_index_of_day);
 
     /**
      * Check if warmup period is complete
@@ -94,10 +105,36 @@ public:
      */
     void reset();
 
+    /**
+     * Write detector state (history buffers, ORB and RSI state) for a checkpoint
+     */
+    void save_state(utils::BinaryWriter& out) const;
+
+    /**
+     * Restore state written by save_state()
+     * @throws runtime_error if the checkpoint was taken with a different SigorConfig
+     */
+    void load_state(utils::BinaryReader& in);
+
+    const SigorConfig& config() const { return config_; }
+
+    /**
+     * Continue under new weights/windows without losing price history
+     *
+     * Detectors read raw bars from the history buffers, so new windows apply
+     * from the next signal. The Wilder RSI average depends on its window and
+     * is re-seeded from the close history when win_rsi changes.
+     * @throws runtime_error if a window exceeds the retained history
+     */
+    void reconfigure(const SigorConfig& config);
+
+    static constexpr size_t max_window() { return MAX_HISTORY; }
+
 private:
     SigorConfig config_;
 
-    // Price/volume history
+    // Price/volume history (bounded to MAX_HISTORY bars)
+    static constexpr size_t MAX_HISTORY = 2048;
     std::vector<double> closes_;
     std::vector<double> highs_;
     std::vector<double> lows_;
@@ -0,0 +1,209 @@
+#pragma once
+#include "core/types.h"
+#include "core/bar.h"
+#include "trading/multi_symbol_trader.h"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace trading {
+
+class ResultCache;
+
+/**
+ * Replay Window - Pre-assembled market snapshots for one test day
+ *
+ * Built once from filtered bars (warmup prefix + test day) and then shared
+ * read-only by any number of concurrent backtests, so batch evaluation never
+ * reloads, refilters or re-assembles per-bar snapshots.
+ */
+struct ReplayWindow {
+    std::vector<Symbol> symbols;
+    std::vector<std::unordered_map<Symbol, Bar>> snapshots;  // One per bar, in time order
+    size_t warmup_bars = 0;                                 // Leading bars used for warmup
+    int sim_days = 0;                                       // Simulation days before test day
+    std::string test_date;                                  // YYYY-MM-DD
+    uint64_t data_fingerprint = 0;                          // Content hash of every bar (symbol order included)
+
+    size_t size() const { return snapshots.size(); }
+
+    /**
+     * Assemble snapshots from per-symbol bar vectors of equal length
+     * @throws runtime_error if a symbol is missing or lengths differ
+     */
+    static ReplayWindow from_bars(const std::vector<Symbol>& symbols,
+                                  const std::unordered_map<Symbol, std::vector<Bar>>& bars,
+                                  size_t warmup_bars,
+                                  const std::string& test_date,
+                                  int sim_days = 0);
+};
+
+/**
+ * Walk-Forward Results - Independent test days aggregated into one report
+ *
+ * Every day is run separately (own warmup, starting from initial capital), so
+ * days can be evaluated in parallel. The aggregate chains daily returns into a
+ * compounded equity curve; per-day DailyResults are renumbered 1..N in date order.
+ */
+struct WalkForwardResults {
+    std::vector<std::string> dates;                            // Successfully evaluated days, ascending
+    std::vector<MultiSymbolTrader::BacktestResults> days;      // Per-day results (same order)
+    std::vector<DailyResults> daily;                           // Per-day breakdown (same order)
+
+    double mrd = 0.0;                  // Mean daily return
+    double compounded_return = 0.0;    // Product of (1 + daily return) - 1
+    double final_equity = 0.0;         // Initial capital compounded over all days
+    double max_drawdown = 0.0;         // Peak-to-trough on the compounded day-end curve
+    double worst_intraday_drawdown = 0.0;
+    double daily_sharpe = 0.0;         // Annualized (sqrt 252) Sharpe of daily returns
+    double best_day_return = 0.0;
+    double worst_day_return = 0.0;
+    int profitable_days = 0;
+    int total_trades = 0;
+    int winning_trades = 0;
+    int losing_trades = 0;
+    double win_rate = 0.0;
+    double total_transaction_costs = 0.0;
+
+    /**
+     * Aggregate per-day results (inputs must be in ascending date order)
+     */
+    static WalkForwardResults aggregate(const std::vector<std::string>& dates,
+                                        const std::vector<MultiSymbolTrader::BacktestResults>& days,
+                                        double initial_capital);
+};
+
+/**
+ * Prefix Cache - Shared warmup state for configs that differ only in trading settings
+ *
+ * The first `warmup_bars` bars of a prepared run never trade: they only feed
+ * the SIGOR detectors, price history and market context. Their end state is a
+ * function of the window and a few config fields (strategy, SIGOR settings,
+ * capital, market-context defaults), so one replay is forked for every config
+ * that shares them - thresholds, stops, sizing and rotation sweeps replay only
+ * the trading bars. Thread-safe; concurrent requests for one prefix wait for a
+ * single replay.
+ */
+class PrefixCache {
+public:
+    struct Stats {
+        size_t hits = 0;
+        size_t misses = 0;
+    };
+
+    /**
+     * @param max_entries Prefixes kept (each holds full detector history; cleared when full)
+     */
+    explicit PrefixCache(size_t max_entries = 32) : max_entries_(max_entries) {}
+
+    /**
+     * Trader state after the window's warmup bars under a prepared config
+     * (shared, read-only: fork() it to continue)
+     */
+    std::shared_ptr<const MultiSymbolTrader> get(const ReplayWindow& window,
+                                                 const TradingConfig& prepared_config);
+
+    /**
+     * Canonical text of every input the warmup prefix depends on
+     */
+    static std::string prefix_key(const ReplayWindow& window, const TradingConfig& prepared_config);
+
+    Stats stats() const { return {hits_.load(), misses_.load()}; }
+
+private:
+    using Entry = std::shared_future<std::shared_ptr<const MultiSymbolTrader>>;
+
+    size_t max_entries_;
+    std::mutex mutex_;
+    std::unordered_map<std::string, Entry> entries_;
+    std::atomic<size_t> hits_{0};
+    std::atomic<size_t> misses_{0};
+};
+
+/**
+ * Run Progress - Intermediate metrics reported while a backtest replays
+ *
+ * Reports fall on the same bars for every config over a window, so `step`
+ * can be used directly as a pruner step (e.g. Optuna trial.report()).
+ */
+struct RunProgress {
+    size_t step = 0;             // Report sequence number (0-based)
+    size_t bar = 0;              // Bars replayed so far
+    size_t total_bars = 0;       // Bars in the window
+    int days_completed = 0;      // Trading days closed by EOD so far
+    bool end_of_day = false;     // Report triggered by a day close
+    double equity = 0.0;         // Marked-to-market equity
+    double total_return = 0.0;   // Return since start (fraction)
+    double day_return = 0.0;     // Return of the day just closed (end_of_day reports)
+    int total_trades = 0;
+    double max_drawdown = 0.0;
+};
+
+/**
+ * Progress callback: return false to abort the run
+ */
+using ProgressCallback = std::function<bool(const RunProgress&)>;
+
+/**
+ * Run Options - Optional services for BacktestRunner::run
+ */
+struct RunOptions {
+    ResultCache* cache = nullptr;       // Consulted before running, filled after (never with aborted runs)
+    PrefixCache* prefixes = nullptr;    // Fork the warmup bars instead of replaying them
+    ProgressCallback on_progress;       // Called at each day close and every report_every_bars
+    size_t report_every_bars = 0;       // Trading bars between reports (0 = day closes only)
+};
+
+/**
+ * Run Info - How a run ended
+ */
+struct RunInfo {
+    bool from_cache = false;
+    bool aborted = false;               // Stopped by the progress callback (results are partial)
+    size_t reports = 0;                 // Progress reports delivered
+};
+
+/**
+ * Backtest Runner - Headless single-config evaluation over a ReplayWindow
+ *
+ * Applies the same MOCK-mode warmup configuration as `sentio_lite mock`,
+ * runs a fresh MultiSymbolTrader over every snapshot and returns its results.
+ * Thread-safe: each call owns its trader; the window is only read.
+ */
+class BacktestRunner {
+public:
+    /**
+     * Apply MOCK-mode warmup settings for a window (what `mock` does before trading)
+     */
+    static TradingConfig prepare_config(TradingConfig config, const ReplayWindow& window);
+
+    /**
+     * Run one configuration over the window
+     * @param config Trading configuration (prepared internally; console output suppressed)
+     * @param cache Optional result cache, consulted before running and filled after
+     * @param from_cache Set to whether the results came from the cache
+     * @param prefixes Optional prefix cache: the warmup bars are forked instead of replayed
+     */
+    static MultiSymbolTrader::BacktestResults run(const ReplayWindow& window,
+                                                  const TradingConfig& config,
+                                                  ResultCache* cache = nullptr,
+                                                  bool* from_cache = nullptr,
+                                                  PrefixCache* prefixes = nullptr);
+
+    /**
+     * Run one configuration with progress reporting and early abort
+     * @param info Set to how the run ended (cache hit, aborted, reports)
+     */
+    static MultiSymbolTrader::BacktestResults run(const ReplayWindow& window,
+                                                  const TradingConfig& config,
+                                                  const RunOptions& options,
+                                                  RunInfo* info = nullptr);
+};
+
+} // namespace trading
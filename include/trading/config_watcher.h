@@ -0,0 +1,103 @@
+#pragma once
+#include "trading/multi_symbol_trader.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace trading {
+
+/**
+ * Config Watcher - Live parameter hot reload
+ *
+ * Watches the config directory with inotify on its own thread. When a watched
+ * file is written or renamed into place, the watcher waits for writes to
+ * settle (optimizers rewrite trading_params.json and sigor_params.json back
+ * to back) and then calls the loader. The loader parses and validates the
+ * files into a complete TradingConfig. A good config is parked in a one-slot
+ * mailbox, replacing any config that has not been taken yet. A config that
+ * fails to load is counted and its error kept for last_error(), and the
+ * running parameters stay in force.
+ *
+ * The decision stage calls take() at a bar boundary. take() is a single
+ * atomic exchange, so the hot path never parses, locks or waits on the
+ * watcher.
+ *
+ * Usage:
+ *   ConfigWatcher watcher({"config", {"trading_params.json", "sigor_params.json"}},
+ *                         load_params, trader.config());
+ *   watcher.start();
+ *   if (watcher.take(next)) trader.reconfigure(next);   // between bars
+ */
+class ConfigWatcher {
+public:
+    /**
+     * Parse + validate the watched files (called on the watcher thread)
+     * @throws on any parse or validation error
+     */
+    using Loader = std::function<TradingConfig()>;
+
+    struct Options {
+        std::string directory;
+        std::vector<std::string> files;             // File names inside `directory`
+        std::chrono::milliseconds settle{250};      // Quiet period before loading
+    };
+
+    struct Stats {
+        std::atomic<uint64_t> loaded{0};            // Changed configs handed to the mailbox
+        std::atomic<uint64_t> unchanged{0};         // Writes that left every parameter as is
+        std::atomic<uint64_t> rejected{0};          // Loads that failed to parse or validate
+    };
+
+    /**
+     * @param current The running config; loads equal to it are ignored
+     */
+    ConfigWatcher(Options options, Loader loader, const TradingConfig& current);
+    ~ConfigWatcher();
+
+    ConfigWatcher(const ConfigWatcher&) = delete;
+    ConfigWatcher& operator=(const ConfigWatcher&) = delete;
+
+    /**
+     * Begin watching
+     * @throws runtime_error if the directory cannot be watched
+     */
+    void start();
+    void stop();
+
+    /**
+     * Move out the newest loaded config, if any (single consumer)
+     * @return false if nothing new was loaded since the last take()
+     */
+    bool take(TradingConfig& out);
+
+    const Stats& stats() const { return stats_; }
+    const Options& options() const { return options_; }
+
+    /**
+     * Error of the most recent rejected load (empty if none)
+     */
+    std::string last_error() const;
+
+private:
+    Options options_;
+    Loader loader_;
+    TradingConfig last_loaded_;                     // Watcher thread only
+    std::atomic<TradingConfig*> mailbox_{nullptr};
+    std::atomic<bool> stopping_{false};
+    int inotify_fd_ = -1;
+    std::thread thread_;
+    Stats stats_;
+    mutable std::mutex error_mutex_;
+    std::string last_error_;
+
+    void run();
+    bool drain_events();                            // True if a watched file changed
+    void load();
+};
+
+} // namespace trading
@@ -0,0 +1,174 @@
+#pragma once
+#include "utils/latency_histogram.h"
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <ostream>
+
+namespace trading {
+
+/**
+ * Live Latency Tracing - Bar-to-order timing across the live pipeline
+ *
+ * Each bar read from the feed gets a trace id and steady-clock stamps as it
+ * moves through the stages:
+ *
+ *   read ─▶ parsed ─▶ dequeued ─▶ on_bar start ─▶ on_bar end ─▶ order written
+ *   └─ ingest ─────┘  └────────── decide ───────────────────┘  └─ report ──┘
+ *
+ * A minute is triggered by the last bar dequeued before its release (the one
+ * that completed the barrier, or the latest one before the deadline), and
+ * orders carry that bar's trace id. Per-bar spans are attributed to the next
+ * released minute.
+ */
+inline uint64_t trace_now_ns() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+/**
+ * Stamps taken by the ingest stage
+ */
+struct BarTrace {
+    uint64_t trace_id = 0;      // 1-based, in feed order
+    uint64_t read_ns = 0;       // Line read from the FIFO / ZMQ
+    uint64_t parsed_ns = 0;     // JSON parse complete
+};
+
+enum class LatencySpan : size_t {
+    PARSE,          // read → parsed (per bar)
+    HANDOFF,        // parsed → dequeued by the decision stage (per bar)
+    ASSEMBLY,       // trigger dequeued → on_bar start (per minute)
+    ON_BAR,         // on_bar start → end (per minute)
+    DECISION,       // trigger read → on_bar end (per minute, checked against the budget)
+    EMIT,           // on_bar end → order written (per order)
+    END_TO_END,     // trigger read → order written (per order)
+    COUNT
+};
+
+inline const char* latency_span_name(LatencySpan span) {
+    switch (span) {
+        case LatencySpan::PARSE:      return "parse";
+        case LatencySpan::HANDOFF:    return "handoff";
+        case LatencySpan::ASSEMBLY:   return "assembly";
+        case LatencySpan::ON_BAR:     return "on_bar";
+        case LatencySpan::DECISION:   return "decision";
+        case LatencySpan::EMIT:       return "emit";
+        case LatencySpan::END_TO_END: return "end_to_end";
+        default:                      return "unknown";
+    }
+}
+
+/**
+ * Percentiles of one span, small enough to pass through the report queue
+ */
+struct SpanSummary {
+    uint64_t count = 0;
+    double p50_us = 0.0;
+    double p99_us = 0.0;
+    double max_us = 0.0;
+};
+
+/**
+ * One latency histogram per span. Each pipeline stage owns its own instance
+ * (not thread-safe); the session totals are merged once the stages have joined.
+ */
+class LatencySpans {
+public:
+    static constexpr size_t NUM_SPANS = static_cast<size_t>(LatencySpan::COUNT);
+
+    void record(LatencySpan span, uint64_t ns) { spans_[static_cast<size_t>(span)].record(ns); }
+
+    void merge(const LatencySpans& other) {
+        for (size_t i = 0; i < NUM_SPANS; ++i) spans_[i].merge(other.spans_[i]);
+    }
+
+    void reset() {
+        for (auto& h : spans_) h.reset();
+    }
+
+    const utils::LatencyHistogram& span(LatencySpan s) const { return spans_[static_cast<size_t>(s)]; }
+
+    SpanSummary summary(LatencySpan s) const {
+        const auto& h = span(s);
+        return {h.count(), h.percentile(0.50) / 1000.0, h.percentile(0.99) / 1000.0, h.max() / 1000.0};
+    }
+
+    /**
+     * Session table: count and p50/p90/p99/p99.9/max per span (microseconds)
+     */
+    void print(std::ostream& out) const {
+        auto flags = out.flags();
+        auto precision = out.precision();
+        out << "  Span            count       p50       p90       p99     p99.9       max\n";
+        for (size_t i = 0; i < NUM_SPANS; ++i) {
+            const auto& h = spans_[i];
+            out << "  " << std::left << std::setw(12) << latency_span_name(static_cast<LatencySpan>(i))
+                << std::right << std::setw(9) << h.count() << std::fixed << std::setprecision(1)
+                << std::setw(10) << h.percentile(0.50) / 1000.0
+                << std::setw(10) << h.percentile(0.90) / 1000.0
+                << std::setw(10) << h.percentile(0.99) / 1000.0
+                << std::setw(10) << h.percentile(0.999) / 1000.0
+                << std::setw(10) << h.max() / 1000.0 << "\n";
+        }
+        out.flags(flags);
+        out.precision(precision);
+    }
+
+    /**
+     * {"parse":{"count":N,"p50_us":..,"p90_us":..,"p99_us":..,"p999_us":..,"max_us":..},...}
+     */
+    void write_json(std::ostream& out) const {
+        out << "{";
+        for (size_t i = 0; i < NUM_SPANS; ++i) {
+            const auto& h = spans_[i];
+            out << (i ? "," : "") << "\"" << latency_span_name(static_cast<LatencySpan>(i)) << "\":{"
+                << "\"count\":" << h.count()
+                << ",\"p50_us\":" << h.percentile(0.50) / 1000.0
+                << ",\"p90_us\":" << h.percentile(0.90) / 1000.0
+                << ",\"p99_us\":" << h.percentile(0.99) / 1000.0
+                << ",\"p999_us\":" << h.percentile(0.999) / 1000.0
+                << ",\"max_us\":" << h.max() / 1000.0 << "}";
+        }
+        out << "}";
+    }
+
+private:
+    std::array<utils::LatencyHistogram, NUM_SPANS> spans_;
+};
+
+/**
+ * Latency of one released minute. The decision stage fills the bar and
+ * minute spans; the report stage adds the order spans before writing it.
+ */
+struct MinuteLatencyReport {
+    uint64_t bar_id = 0;
+    uint64_t trace_id = 0;          // Bar that triggered the release
+    bool complete = false;          // Released by the all-symbols barrier (false: deadline)
+    std::array<SpanSummary, LatencySpans::NUM_SPANS> spans{};
+
+    SpanSummary& operator[](LatencySpan s) { return spans[static_cast<size_t>(s)]; }
+    const SpanSummary& operator[](LatencySpan s) const { return spans[static_cast<size_t>(s)]; }
+
+    double decision_ms() const { return (*this)[LatencySpan::DECISION].max_us / 1000.0; }
+
+    /**
+     * One JSONL row: {"bar_id":..,"trace_id":..,"complete":..,"over_budget":..,"spans":{...}}
+     */
+    void write_json(std::ostream& out, bool over_budget) const {
+        out << "{\"bar_id\":" << bar_id << ",\"trace_id\":" << trace_id
+            << ",\"complete\":" << (complete ? "true" : "false")
+            << ",\"over_budget\":" << (over_budget ? "true" : "false") << ",\"spans\":{";
+        for (size_t i = 0; i < LatencySpans::NUM_SPANS; ++i) {
+            const auto& s = spans[i];
+            out << (i ? "," : "") << "\"" << latency_span_name(static_cast<LatencySpan>(i)) << "\":{"
+                << "\"count\":" << s.count << ",\"p50_us\":" << s.p50_us
+                << ",\"p99_us\":" << s.p99_us << ",\"max_us\":" << s.max_us << "}";
+        }
+        out << "}}";
+    }
+};
+
+} // namespace trading
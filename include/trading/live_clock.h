@@ -0,0 +1,94 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace trading {
+
+/**
+ * Live Clock - Time source for the live pipeline's snapshot deadlines
+ *
+ * Live trading runs on the steady clock. Replays swap in a ReplayClock so
+ * the same pipeline code runs against virtual market time, either N× faster
+ * than wall time or as fast as the feed can be read. Latency tracing keeps
+ * using wall time (trace_now_ns) in both cases: it measures real work.
+ */
+class LiveClock {
+public:
+    using Clock = std::chrono::steady_clock;
+    using time_point = Clock::time_point;
+
+    virtual ~LiveClock() = default;
+
+    virtual time_point now() const = 0;
+
+    /**
+     * True if time only moves when the feed advances it. Consumers then take
+     * the time from each event (see ingest stamps) and skip idle deadline polls,
+     * which makes the replay deterministic.
+     */
+    virtual bool feed_driven() const { return false; }
+};
+
+/**
+ * Wall-clock time (live trading)
+ */
+class SteadyLiveClock final : public LiveClock {
+public:
+    time_point now() const override { return Clock::now(); }
+};
+
+/**
+ * Replay Clock - Virtual market time for a replayed feed
+ *
+ * Market time maps onto the clock as origin() + (bar time - first bar time).
+ *   speed > 0: virtual time runs speed× faster than wall time from
+ *              construction; wait_until() sleeps until a bar is due
+ *   speed = 0: as fast as possible; virtual time jumps to each bar in
+ *              wait_until() and never moves on its own
+ *
+ * wait_until() is called by the feed thread; now() is safe from any thread.
+ */
+class ReplayClock final : public LiveClock {
+public:
+    explicit ReplayClock(double speed)
+        : speed_(std::max(0.0, speed)),
+          origin_(Clock::now()),
+          virtual_ns_(origin_.time_since_epoch().count()) {}
+
+    time_point now() const override {
+        if (speed_ > 0.0) {
+            auto real = Clock::now() - origin_;
+            return origin_ + std::chrono::duration_cast<Clock::duration>(real * speed_);
+        }
+        return time_point(Clock::duration(virtual_ns_.load(std::memory_order_acquire)));
+    }
+
+    bool feed_driven() const override { return speed_ <= 0.0; }
+
+    double speed() const { return speed_; }
+    time_point origin() const { return origin_; }
+
+    /**
+     * Block (paced) or jump (as fast as possible) until virtual time reaches `at`
+     */
+    void wait_until(time_point at) {
+        if (speed_ > 0.0) {
+            auto offset = std::chrono::duration_cast<Clock::duration>((at - origin_) / speed_);
+            std::this_thread::sleep_until(origin_ + offset);
+            return;
+        }
+        auto ns = at.time_since_epoch().count();
+        if (ns > virtual_ns_.load(std::memory_order_relaxed)) {
+            virtual_ns_.store(ns, std::memory_order_release);
+        }
+    }
+
+private:
+    double speed_;
+    time_point origin_;
+    std::atomic<Clock::rep> virtual_ns_;
+};
+
+} // namespace trading
@@ -0,0 +1,150 @@
+#pragma once
+#include "trading/latency_trace.h"
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <ostream>
+#include <string>
+
+namespace trading {
+
+/**
+ * Live Metrics - Counters and gauges of a running live session
+ *
+ * Every field has exactly one writer (the pipeline stage noted next to it),
+ * which updates it with relaxed stores; the report stage reads them when it
+ * publishes. Nothing here locks, allocates or does I/O, so updating a metric
+ * costs the decision stage a plain store.
+ *
+ * Published as Prometheus text exposition format by write_prometheus(), and
+ * written to disk by publish_metrics_file() with a tmp-file + rename so a
+ * scraper (e.g. node_exporter's textfile collector) never sees a partial file.
+ */
+struct LiveMetrics {
+    // Decision stage
+    std::atomic<uint64_t> bars{0};              // Bars dequeued from the feed
+    std::atomic<uint64_t> snapshots{0};         // Minutes released to the trader
+    std::atomic<uint64_t> parse_errors{0};      // Feed lines that failed to parse
+    std::atomic<uint64_t> reports_dropped{0};   // Report events lost to a full queue
+    std::atomic<uint64_t> trades{0};            // Completed round-trip trades
+    std::atomic<uint64_t> config_reloads{0};    // Hot-reloaded parameter sets swapped in
+    std::atomic<uint64_t> open_positions{0};
+    std::atomic<double> equity{0.0};
+    std::atomic<double> cash{0.0};
+
+    // Report stage
+    std::atomic<uint64_t> orders{0};            // Order intents written
+    std::atomic<uint64_t> minutes_over_budget{0};
+    std::atomic<uint64_t> bar_queue_depth{0};   // Sampled at publish time
+    std::atomic<uint64_t> report_queue_depth{0};
+    std::atomic<uint64_t> order_batches_sent{0};    // Order gateway (copied at publish time)
+    std::atomic<uint64_t> order_batches_rejected{0};
+    std::atomic<uint64_t> orders_filled{0};
+    std::atomic<uint64_t> orders_broker_rejected{0};
+    std::atomic<uint64_t> gateway_pending{0};
+    std::atomic<uint64_t> config_reloads_rejected{0};   // Config watcher (copied at publish time)
+    std::atomic<bool> running{false};
+
+    uint64_t bar_queue_capacity = 0;
+    uint64_t report_queue_capacity = 0;
+
+    /**
+     * Single-writer increment: no read-modify-write instruction needed
+     */
+    static void increment(std::atomic<uint64_t>& counter) {
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    template <typename T>
+    static void set(std::atomic<T>& gauge, T value) { gauge.store(value, std::memory_order_relaxed); }
+
+    /**
+     * Prometheus text format. `latency` holds the spans to publish as
+     * summaries (seconds); spans with no samples are skipped.
+     */
+    void write_prometheus(std::ostream& out, const LatencySpans& latency) const {
+        auto counter = [&](const char* name, const char* help, uint64_t value) {
+            out << "# HELP " << name << " " << help << "\n# TYPE " << name << " counter\n"
+                << name << " " << value << "\n";
+        };
+        auto gauge = [&](const char* name, const char* help, double value) {
+            out << "# HELP " << name << " " << help << "\n# TYPE " << name << " gauge\n"
+                << name << " " << value << "\n";
+        };
+        auto load = [](const std::atomic<uint64_t>& a) { return a.load(std::memory_order_relaxed); };
+
+        auto precision = out.precision(10);
+        gauge("sentio_live_running", "1 while the live session is processing its feed",
+              running.load(std::memory_order_relaxed) ? 1.0 : 0.0);
+        counter("sentio_live_bars_total", "Bars received from the feed", load(bars));
+        counter("sentio_live_snapshots_total", "Minute snapshots released to the trader", load(snapshots));
+        counter("sentio_live_parse_errors_total", "Feed lines that failed to parse", load(parse_errors));
+        counter("sentio_live_reports_dropped_total", "Report events dropped because the report stage fell behind",
+                load(reports_dropped));
+        counter("sentio_live_orders_total", "Order intents written", load(orders));
+        counter("sentio_live_trades_total", "Completed round-trip trades", load(trades));
+        counter("sentio_live_minutes_over_budget_total", "Minutes whose decision latency exceeded the budget",
+                load(minutes_over_budget));
+        counter("sentio_live_order_batches_sent_total", "Order batches written to the broker bridge",
+                load(order_batches_sent));
+        counter("sentio_live_order_batches_rejected_total", "Order batches rejected by gateway backpressure",
+                load(order_batches_rejected));
+        counter("sentio_live_orders_filled_total", "Orders the broker reported filled", load(orders_filled));
+        counter("sentio_live_orders_broker_rejected_total", "Orders the broker rejected",
+                load(orders_broker_rejected));
+        counter("sentio_live_config_reloads_total", "Parameter reloads swapped into the trader",
+                load(config_reloads));
+        counter("sentio_live_config_reloads_rejected_total", "Parameter reloads that failed to parse or validate",
+                load(config_reloads_rejected));
+        gauge("sentio_live_gateway_pending_batches", "Encoded batches waiting for the order FIFO",
+              static_cast<double>(load(gateway_pending)));
+        gauge("sentio_live_equity_dollars", "Marked-to-market equity", equity.load(std::memory_order_relaxed));
+        gauge("sentio_live_cash_dollars", "Uninvested cash", cash.load(std::memory_order_relaxed));
+        gauge("sentio_live_open_positions", "Open positions", static_cast<double>(load(open_positions)));
+
+        out << "# HELP sentio_live_queue_depth Events waiting in a pipeline queue\n"
+            << "# TYPE sentio_live_queue_depth gauge\n"
+            << "sentio_live_queue_depth{queue=\"bar\"} " << load(bar_queue_depth) << "\n"
+            << "sentio_live_queue_depth{queue=\"report\"} " << load(report_queue_depth) << "\n";
+        out << "# HELP sentio_live_queue_capacity Slots in a pipeline queue\n"
+            << "# TYPE sentio_live_queue_capacity gauge\n"
+            << "sentio_live_queue_capacity{queue=\"bar\"} " << bar_queue_capacity << "\n"
+            << "sentio_live_queue_capacity{queue=\"report\"} " << report_queue_capacity << "\n";
+
+        out << "# HELP sentio_live_latency_seconds Live pipeline span latency over the session\n"
+            << "# TYPE sentio_live_latency_seconds summary\n";
+        static constexpr double QUANTILES[] = {0.5, 0.9, 0.99, 0.999};
+        for (size_t i = 0; i < LatencySpans::NUM_SPANS; ++i) {
+            const auto span = static_cast<LatencySpan>(i);
+            const auto& h = latency.span(span);
+            if (h.count() == 0) continue;
+            const char* name = latency_span_name(span);
+            for (double q : QUANTILES) {
+                out << "sentio_live_latency_seconds{span=\"" << name << "\",quantile=\"" << q << "\"} "
+                    << h.percentile(q) / 1e9 << "\n";
+            }
+            out << "sentio_live_latency_seconds_sum{span=\"" << name << "\"} " << h.total_ns() / 1e9 << "\n"
+                << "sentio_live_latency_seconds_count{span=\"" << name << "\"} " << h.count() << "\n";
+        }
+        out.precision(precision);
+    }
+};
+
+/**
+ * Atomically replace `path` with `text` (write `path.tmp`, then rename)
+ * @return false if the file could not be written
+ */
+inline bool publish_metrics_file(const std::string& path, const std::string& text) {
+    const std::string tmp = path + ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::trunc);
+        if (!out) return false;
+        out << text;
+        out.flush();
+        if (!out) return false;
+    }
+    return std::rename(tmp.c_str(), path.c_str()) == 0;
+}
+
+} // namespace trading
@@ -0,0 +1,111 @@
+#pragma once
+#include "trading/backtest_runner.h"
+#include "trading/multi_symbol_trader.h"
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace trading {
+
+/**
+ * Live session settings (live and mock-live modes), filled in from the
+ * command line
+ */
+struct LiveConfig {
+    std::vector<Symbol> symbols;
+    double capital = 100000.0;
+    bool verbose = false;
+    TradingConfig trading;
+
+    // Bar feed
+    std::string feed = "fifo";           // fifo | zmq | replay
+    ReplayWindow replay_window;          // replay: warmup bars, then the replayed day (built by the caller)
+    double replay_speed = 0.0;           // replay: N× market speed (0 = as fast as possible)
+    std::string zmq_url = "tcp://127.0.0.1:5555";
+    std::string bar_fifo = "/tmp/alpaca_bars.fifo";
+    std::string data_dir = "data/equities";   // Live warmup: binary store
+    std::string extension = ".bin";
+    size_t warmup_bars = 100;                 // Live warmup: stored minutes before today
+    std::string warmup_file = "warmup_bars.json";   // Live warmup: today's bars so far
+
+    // Snapshots, latency and metrics
+    int snapshot_deadline_ms = 5000;     // Max wait for all symbols before releasing a minute
+    double latency_budget_ms = 50.0;     // Flag minutes whose bar-read → decision latency exceeds this
+    std::string metrics_file = "logs/live/metrics.prom";
+    int metrics_interval_ms = 1000;      // Metrics file rewrite period (0 = off)
+
+    // Orders
+    std::string order_gateway = "off";   // off | json | binary
+    std::string order_fifo = "/tmp/alpaca_orders.fifo";
+    std::string response_fifo = "/tmp/alpaca_responses.fifo";
+    size_t gateway_queue = 256;          // Batches handed to a gateway, not yet encoded
+    size_t gateway_pending = 64;         // Encoded batches waiting for the bridge
+
+    // Parameters and crash recovery
+    std::string config_dir = "config";   // Params files, watched when hot_reload is on
+    bool hot_reload = true;
+    std::string state_dir = "logs/live/state";  // Checkpoint + write-ahead log (empty = off)
+    int checkpoint_interval = 30;        // Minutes between full checkpoints
+    bool resume = false;                 // Rebuild the trader from state_dir instead of warming up
+    std::vector<std::pair<std::string, std::string>> instances;  // Extra traders: (name, config dir)
+
+    // Threads (-1 = let the OS schedule)
+    int pin_ingest_core = -1;
+    int pin_decision_core = -1;
+    int pin_report_core = -1;
+
+    // End-of-session export
+    std::string results_file = "results.json";
+    std::string trades_file = "trades.jsonl";
+};
+
+/**
+ * Where one trader's order intents went by the end of a session
+ */
+struct LiveRouteResult {
+    std::string label;                            // Empty for the primary trader
+    std::unordered_map<Symbol, int> positions;    // Trader's final shares per symbol
+    std::unordered_map<Symbol, int> routed;       // Net shares sent to the gateway, plus legs still held
+    size_t orders = 0;                            // Intents written to the orders file
+    size_t legs_held = 0;                         // Legs a full backlog never took
+    uint64_t batches_rejected = 0;                // Gateway submits refused for backpressure
+};
+
+/**
+ * Outcome of run_live_session()
+ */
+struct LiveSessionResult {
+    int exit_code = 0;                   // Process exit code (0 = session ran to the end of the feed)
+    std::vector<LiveRouteResult> routes; // Primary first, then each instance
+};
+
+/**
+ * Live Pipeline - One live (or mock-live) trading session
+ *
+ * Three stages on their own threads, talking only through preallocated SPSC
+ * queues:
+ *
+ *   ingest (read + parse) ──bar_queue──▶ decide (assembler + traders)
+ *                         ──report_queue──▶ order/report (stdout, files, gateways)
+ *
+ * Ingest reads the FIFO, ZMQ or replay feed and never drops a bar. The
+ * decision stage assembles minute snapshots, runs the primary trader and
+ * every instance, and turns position changes into order intents; it never
+ * waits on console or file output. The report stage does all I/O: console
+ * lines, orders files and gateway batches, latency rows, metrics and state
+ * journal writes.
+ *
+ * Setup (warmup, --resume, instances, FIFOs, gateways, watcher, journal)
+ * and the end-of-session summary and export are part of the run. Files go
+ * under logs/live/ in the working directory.
+ *
+ * Usage:
+ *   LiveConfig config;
+ *   config.symbols = {"TQQQ", "SQQQ"};
+ *   config.trading = trading_config;
+ *   return run_live_session(config).exit_code;
+ */
+LiveSessionResult run_live_session(LiveConfig& config);
+
+} // namespace trading
@@ -0,0 +1,82 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+namespace trading {
+
+/**
+ * Median Pruner - Stops trials that trail the median of earlier trials
+ *
+ * Same rule as Optuna's MedianPruner: once `startup_trials` trials have
+ * completed, a trial is pruned at step s (s >= warmup_steps) if its
+ * intermediate value is below the median of the completed trials' values at
+ * step s. Values are "higher is better" (e.g. cumulative return). Pruned
+ * trials are not recorded, so the median only reflects full runs.
+ *
+ * Thread-safe: trials may report and complete concurrently.
+ *
+ * Usage:
+ *   MedianPruner pruner(5);
+ *   options.on_progress = [&](const RunProgress& p) {
+ *       values.push_back(p.total_return);
+ *       return !pruner.should_prune(p.step, p.total_return);
+ *   };
+ *   BacktestRunner::run(window, config, options, &info);
+ *   if (!info.aborted) pruner.complete_trial(values);
+ */
+class MedianPruner {
+public:
+    explicit MedianPruner(size_t startup_trials = 5, size_t warmup_steps = 0)
+        : startup_trials_(startup_trials), warmup_steps_(warmup_steps) {}
+
+    /**
+     * True if `value` at `step` is below the median of completed trials
+     */
+    bool should_prune(size_t step, double value) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (completed_ < startup_trials_ || step < warmup_steps_ || step >= by_step_.size()) {
+            return false;
+        }
+        std::vector<double> values = by_step_[step];
+        if (values.empty()) return false;
+
+        size_t mid = values.size() / 2;
+        std::nth_element(values.begin(), values.begin() + mid, values.end());
+        double median = values[mid];
+        if (values.size() % 2 == 0) {
+            median = (median + *std::max_element(values.begin(), values.begin() + mid)) / 2.0;
+        }
+        return value < median;
+    }
+
+    /**
+     * Record a completed trial's intermediate values, indexed by step
+     */
+    void complete_trial(const std::vector<double>& values_by_step) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (by_step_.size() < values_by_step.size()) {
+            by_step_.resize(values_by_step.size());
+        }
+        for (size_t s = 0; s < values_by_step.size(); ++s) {
+            by_step_[s].push_back(values_by_step[s]);
+        }
+        completed_++;
+    }
+
+    size_t completed_trials() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return completed_;
+    }
+
+private:
+    size_t startup_trials_;
+    size_t warmup_steps_;
+
+    mutable std::mutex mutex_;
+    std::vector<std::vector<double>> by_step_;   // Completed trials' values per step
+    size_t completed_ = 0;
+};
+
+} // namespace trading
@@ -6,15 +6,22 @@
 #include "trading/trade_history.h"
 #include "trading/alpaca_cost_model.h"
 #include "trading/trade_filter.h"
+#include "trading/performance_accumulator.h"
+#include "trading/trade_journal.h"
 #include "trading/trading_strategy.h"
+#include "trading/stage_profiler.h"
 #include "strategy/sigor_strategy.h"
 #include "strategy/williams_rsi_strategy.h"
 #include "predictor/sigor_predictor_adapter.h"
+#include "utils/circular_buffer.h"
+#include "utils/pool_allocator.h"
+#include <algorithm>
 #include <unordered_map>
 #include <memory>
 #include <vector>
-#include <deque>
 #include <numeric>
+#include <iostream>
+#include <string>
 
 namespace trading {
 
@@ -23,10 +30,59 @@ namespace trading {
  */
 struct PredictionData {
     MultiHorizonPredictor::MultiHorizonPrediction prediction;  // Multi-horizon prediction
-    Eigen::VectorXd features;     // Feature vector (33 dimensions)
     Price current_price;          // Current price
 };
 
+/**
+ * Prediction Set - One bar's predictions, in slots indexed like the trader's symbols
+ *
+ * Slots are allocated once; clear() only resets the valid flags, so the set
+ * is refilled every bar without touching the heap.
+ */
+class PredictionSet {
+public:
+    explicit PredictionSet(const std::vector<Symbol>& symbols)
+        : slots_(symbols.size()), valid_(symbols.size(), 0) {
+        index_.reserve(symbols.size());
+        for (size_t i = 0; i < symbols.size(); ++i) index_.emplace(symbols[i], i);
+    }
+
+    void clear() { std::fill(valid_.begin(), valid_.end(), 0); }
+
+    void set(size_t index, const PredictionData& data) {
+        slots_[index] = data;
+        valid_[index] = 1;
+    }
+
+    /**
+     * Prediction for the symbol at `index`, nullptr if none this bar
+     */
+    const PredictionData* at(size_t index) const { return valid_[index] ? &slots_[index] : nullptr; }
+
+    /**
+     * Prediction for `symbol`, nullptr if none this bar (or not traded)
+     */
+    const PredictionData* find(const Symbol& symbol) const {
+        auto it = index_.find(symbol);
+        return it == index_.end() ? nullptr : at(it->second);
+    }
+
+private:
+    std::unordered_map<Symbol, size_t> index_;
+    std::vector<PredictionData> slots_;
+    std::vector<char> valid_;
+};
+
+/**
+ * Symbol-keyed map whose nodes come from a NodePool (entries that come and go
+ * while trading reuse pooled memory)
+ */
+template <typename T>
+using SymbolPoolMap = std::unordered_map<Symbol, T, std::hash<Symbol>, std::equal_to<Symbol>,
+                                         utils::PoolAllocator<std::pair<const Symbol, T>>>;
+
+using PositionMap = SymbolPoolMap<PositionWithCosts>;
+
 /**
  * Trading Configuration
  */
@@ -54,6 +110,13 @@ struct TradingConfig {
     // Trade filter settings
     TradeFilter::Config filter_config;
 
+    // Trade journal settings
+    size_t trade_journal_ring_size = 4096;  // Initial in-memory trades; ring size once spilling
+    std::string trade_journal_path;         // Persist trades here (empty = memory only)
+
+    // Console logging (disable for batch/parallel evaluation)
+    bool quiet = false;                     // Suppress per-bar and per-trade console output
+
     // Cost model settings
     bool enable_cost_tracking = true;  // Enable Alpaca cost model
     double default_avg_volume = 1000000.0;  // Default average daily volume
@@ -219,20 +282,28 @@ private:
     // Per-symbol components (SIGOR only)
     std::unordered_map<Symbol, std::unique_ptr<SigorPredictorAdapter>> sigor_predictors_;
 
+    // Node memory for positions_, exit_tracking_ and rotation_cooldowns_
+    // (declared first so it outlives them)
+    utils::NodePool node_pool_;
+
     // Shared components (both strategies)
-    std::unordered_map<Symbol, PositionWithCosts> positions_;
-    std::unordered_map<Symbol, ExitTrackingData> exit_tracking_;  // Price-based exit tracking
+    PositionMap positions_;
+    SymbolPoolMap<ExitTrackingData> exit_tracking_;  // Price-based exit tracking
     std::unordered_map<Symbol, std::unique_ptr<TradeHistory>> trade_history_;
     std::unordered_map<Symbol, MarketContext> market_context_;  // Market microstructure data
 
     // Multi-horizon return tracking for predictor updates
-    std::unordered_map<Symbol, std::deque<double>> price_history_;  // Track for multi-bar returns
+    static constexpr size_t PRICE_HISTORY_BARS = 20;  // Enough for 10-bar returns with buffer
+    std::unordered_map<Symbol, CircularBuffer<double>> price_history_;  // Track for multi-bar returns
 
     // Trade filtering and frequency management
     std::unique_ptr<TradeFilter> trade_filter_;
 
-    // Complete trade log for export (not circular, keeps all trades)
-    std::vector<TradeRecord> all_trades_log_;
+    // Complete trade log for export (memory-bounded, spills to disk)
+    TradeJournal trade_journal_;
+
+    // Streaming test-day statistics (updated on each exit and each bar)
+    PerformanceAccumulator test_day_perf_;
 
     size_t bars_seen_;       // Total bars including warmup
     size_t trading_bars_;    // Trading bars only (excludes warmup) - used for EOD timing
@@ -247,6 +318,19 @@ private:
     int daily_winning_trades_;        // Winning trades today
     int daily_losing_trades_;         // Losing trades today
 
+    // Bar sequence / EOD detection state (per instance, so traders can run concurrently)
+    int64_t last_timestamp_ms_ = -1;  // Previous bar timestamp (gap detection)
+    int64_t last_trading_date_ = 0;   // YYYYMMDD of previous bar
+    int64_t last_eod_date_ = 0;       // YYYYMMDD of last EOD liquidation (prevents duplicates)
+
+    // Per-stage on_bar latency (instrumentation only: not copied by fork/checkpoint)
+    StageProfiler stage_profiler_;
+
+    // Console logging - discarded when config_.quiet is set
+    mutable std::ostream null_log_{nullptr};
+    std::ostream& console() const { return config_.quiet ? null_log_ : std::cout; }
+    std::ostream& console_err() const { return config_.quiet ? null_log_ : std::cerr; }
+
     // Warmup phase tracking
     struct SimulationMetrics {
         std::vector<TradeRecord> simulated_trades;
@@ -283,18 +367,32 @@ private:
     SimulationMetrics warmup_metrics_;
 
     // Rotation tracking (from online_trader)
-    std::unordered_map<Symbol, int> rotation_cooldowns_;  // Bars until can re-enter after rotation
+    SymbolPoolMap<int> rotation_cooldowns_;  // Bars until can re-enter after rotation
+
+    // Per-bar scratch buffers, sized in the constructor so on_bar does not allocate
+    PredictionSet predictions_;
+    std::vector<std::pair<Symbol, double>> ranked_;        // make_trades: (tradeable_symbol, strength)
+    std::vector<Symbol> processed_bases_;                  // make_trades: pairs already ranked
+    std::vector<Symbol> top_symbols_;                      // make_trades: entry candidates
+    std::vector<std::pair<Symbol, const PredictionData*>> debug_ranked_;  // make_trades: analysis log
+    std::vector<Symbol> exit_scratch_;                     // update_positions / liquidate_all
+    mutable std::vector<Symbol> held_scratch_;             // find_weakest_position
 
     // Phase management methods
     void update_phase();
     void handle_observation_phase(const std::unordered_map<Symbol, Bar>& market_data);
-    void handle_simulation_phase(const std::unordered_map<Symbol, PredictionData>& predictions,
+    void handle_simulation_phase(const PredictionSet& predictions,
                                 const std::unordered_map<Symbol, Bar>& market_data);
-    void handle_live_phase(const std::unordered_map<Symbol, PredictionData>& predictions,
+    void handle_live_phase(const PredictionSet& predictions,
                           const std::unordered_map<Symbol, Bar>& market_data);
     bool evaluate_warmup_complete();
     void print_warmup_summary();
 
+    // Checkpoint / fork helpers
+    void check_fork_config(const TradingConfig& config) const;
+    void copy_state_from(const MultiSymbolTrader& other);
+    void load_state(utils::BinaryReader& in);
+
 public:
     /**
      * Constructor
@@ -336,7 +434,8 @@ public:
         double avg_win;             // Average win amount
         double avg_loss;            // Average loss amount
         double profit_factor;       // Gross profit / gross loss
-        double max_drawdown;        // Maximum drawdown (not yet implemented)
+        double max_drawdown;        // Maximum peak-to-trough equity drawdown (fraction)
+        double sharpe_ratio;        // Annualized per-trade Sharpe ratio
 
         // Cost tracking
         double total_transaction_costs;  // Sum of all transaction costs
@@ -350,43 +449,105 @@ public:
 
     /**
      * Get backtest results
+     * O(1) in the number of trades (reads the streaming accumulator)
      */
     BacktestResults get_results() const;
 
     /**
      * Get current positions (for monitoring)
      */
-    const std::unordered_map<Symbol, PositionWithCosts>& positions() const { return positions_; }
+    const PositionMap& positions() const { return positions_; }
 
     /**
      * Get current cash
      */
     double cash() const { return cash_; }
 
+    /**
+     * Completed round-trip trades so far (cheaper than get_results())
+     */
+    int total_trades() const { return total_trades_; }
+
     /**
      * Get configuration
      */
     const TradingConfig& config() const { return config_; }
 
     /**
-     * Get all trades (for export)
+     * Get complete trade journal (for export)
+     * Iterate with range-for; spilled trades are streamed back from disk.
      */
-    std::vector<TradeRecord> get_all_trades() const {
-        return all_trades_log_;
-    }
+    const TradeJournal& trade_journal() const { return trade_journal_; }
+
+    /**
+     * Total bars processed so far (warmup included)
+     */
+    size_t bars_seen() const { return bars_seen_; }
+
+    /**
+     * Per-stage on_bar latency histograms (empty unless built with SENTIO_STAGE_TIMING)
+     */
+    const StageProfiler& stage_profile() const { return stage_profiler_; }
+
+    /**
+     * Days closed by EOD liquidation so far (grows by one per trading day)
+     */
+    const std::vector<DailyResults>& daily_results() const { return daily_results_; }
+
+    /**
+     * Fork - Independent in-memory copy of the current state that continues under `config`
+     *
+     * Trading-side settings (thresholds, stops, sizing, rotation, filter) take
+     * effect from the next bar; detector state is shared history, so the SIGOR
+     * configuration must be unchanged. Forking before the first trade (i.e. at
+     * bars_seen() <= min_bars_to_learn) gives exactly the results of a fresh
+     * trader run under `config` over the same bars.
+     * @throws runtime_error if strategy or SIGOR settings differ
+     */
+    std::unique_ptr<MultiSymbolTrader> fork(const TradingConfig& config) const;
+
+    /**
+     * Reconfigure - Continue this trader under `config` from the next bar
+     *
+     * Unlike fork(), works in place and accepts new SIGOR weights and windows:
+     * detector history, open positions, cash, trade filter state and the
+     * journal are all kept. Warmup/phase, journal and console (quiet)
+     * settings stay as constructed. Meant for live parameter hot reload at a bar boundary.
+     * @throws runtime_error if strategy, capital, bars_per_day or trade history
+     *         size differ, or a SIGOR window exceeds the detector history
+     */
+    void reconfigure(const TradingConfig& config);
+
+    /**
+     * Serialize the full trading state into a compact binary checkpoint
+     * (native layout: readable by the same build only). Console settings are
+     * not part of the state. A memory-only trade journal is included in full.
+     * A spilling one is saved as its file path, the count of records durable
+     * in it, and the few records still waiting for its writer.
+     */
+    std::string save_checkpoint() const;
+
+    /**
+     * Rebuild a trader from save_checkpoint() output, continuing under `config`
+     * (same rules as fork()). A spilling journal resumes its own file, cut back
+     * to the checkpoint; `config.trade_journal_path` is then ignored.
+     * @throws runtime_error on malformed checkpoints or incompatible configs
+     */
+    static std::unique_ptr<MultiSymbolTrader> restore_checkpoint(const std::string& checkpoint,
+                                                                 const TradingConfig& config);
 
 private:
     /**
      * Make trading decisions based on predictions
      */
-    void make_trades(const std::unordered_map<Symbol, PredictionData>& predictions,
+    void make_trades(const PredictionSet& predictions,
                     const std::unordered_map<Symbol, Bar>& market_data);
 
     /**
      * Update existing positions (check exit conditions with trade filter)
      */
     void update_positions(const std::unordered_map<Symbol, Bar>& market_data,
-                         const std::unordered_map<Symbol, PredictionData>& predictions);
+                         const PredictionSet& predictions);
 
     /**
      * Calculate position size for a symbol using Kelly Criterion and adaptive sizing
@@ -414,6 +575,13 @@ private:
      */
     void liquidate_all(const std::unordered_map<Symbol, Bar>& market_data, const std::string& reason);
 
+    /**
+     * Equity for drawdown tracking: like get_equity(), but a position whose
+     * symbol is missing from this snapshot is marked at its last known close
+     * instead of counting as zero
+     */
+    double mark_to_market(const std::unordered_map<Symbol, Bar>& market_data) const;
+
     /**
      * Update market context for cost calculations
      */
@@ -457,7 +625,7 @@ private:
      * Find weakest current position for rotation (from online_trader)
      * Returns symbol with lowest signal strength, or empty string if no positions
      */
-    Symbol find_weakest_position(const std::unordered_map<Symbol, PredictionData>& predictions) const;
+    Symbol find_weakest_position(const PredictionSet& predictions) const;
 
     /**
      * Update rotation cooldowns (decrement each bar)
@@ -0,0 +1,169 @@
+#pragma once
+#include "trading/param_registry.h"
+#include <Eigen/Dense>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace trading {
+
+/**
+ * Search Space - Bounded box over registry parameters
+ *
+ * Optimizers work in the unit cube [0,1]^n; the search space maps unit
+ * coordinates to parameter values (integer parameters are rounded) and back.
+ *
+ * Usage:
+ *   SearchSpace space;
+ *   space.add("w_rsi", 0.1, 2.0);
+ *   space.add("win_rsi", 5, 30);
+ *   TradingConfig cfg = space.apply(base, unit_point);
+ */
+class SearchSpace {
+public:
+    struct Dimension {
+        const ParamInfo* param;
+        double lo;
+        double hi;
+    };
+
+    /**
+     * Add a dimension
+     * @throws runtime_error if the name is not a tunable parameter or lo >= hi
+     */
+    void add(const std::string& name, double lo, double hi);
+
+    size_t size() const { return dims_.size(); }
+    const std::vector<Dimension>& dimensions() const { return dims_; }
+
+    /**
+     * Parameter values for a unit-cube point (clamped to bounds, ints rounded)
+     */
+    std::vector<double> decode(const std::vector<double>& unit) const;
+
+    /**
+     * Unit-cube point for a config's current values (clamped to bounds)
+     */
+    std::vector<double> encode(const TradingConfig& config) const;
+
+    /**
+     * Copy of base with every dimension set from a unit-cube point
+     */
+    TradingConfig apply(const TradingConfig& base, const std::vector<double>& unit) const;
+
+    /**
+     * SIGOR detector weights and windows (same ranges as optimize_with_validation.py)
+     */
+    static SearchSpace sigor_default();
+
+private:
+    std::vector<Dimension> dims_;
+};
+
+/**
+ * Black-Box Optimizer - Population-based ask/tell interface (maximization)
+ *
+ * Each ask() returns one generation of candidates in the unit cube; the caller
+ * evaluates them (in parallel, in any order) and passes the fitness values
+ * back through tell() in the same order.
+ */
+class BlackBoxOptimizer {
+public:
+    virtual ~BlackBoxOptimizer() = default;
+
+    virtual std::vector<std::vector<double>> ask() = 0;
+    virtual void tell(const std::vector<double>& fitness) = 0;
+
+    virtual size_t population_size() const = 0;
+    virtual const char* name() const = 0;
+};
+
+/**
+ * CMA-ES - Covariance Matrix Adaptation Evolution Strategy
+ * (mu/mu_w, lambda) with rank-one and rank-mu updates; candidates outside the
+ * unit cube are repaired by clamping before evaluation and update.
+ */
+class CmaEs : public BlackBoxOptimizer {
+public:
+    /**
+     * @param x0 Initial mean in the unit cube
+     * @param sigma0 Initial step size (fraction of the box)
+     * @param population Lambda (0 = 4 + 3 ln n)
+     */
+    CmaEs(const std::vector<double>& x0, double sigma0, size_t population, uint64_t seed);
+
+    std::vector<std::vector<double>> ask() override;
+    void tell(const std::vector<double>& fitness) override;
+
+    size_t population_size() const override { return lambda_; }
+    const char* name() const override { return "cmaes"; }
+
+    double sigma() const { return sigma_; }
+
+private:
+    size_t n_;
+    size_t lambda_;
+    size_t mu_;
+    Eigen::VectorXd weights_;
+    double mueff_, cc_, cs_, c1_, cmu_, damps_, chi_n_;
+
+    Eigen::VectorXd mean_;
+    double sigma_;
+    Eigen::VectorXd pc_, ps_;
+    Eigen::MatrixXd C_;             // Covariance
+    Eigen::MatrixXd B_;             // Eigenvectors of C (columns)
+    Eigen::VectorXd D_;             // Square roots of C's eigenvalues
+    Eigen::MatrixXd inv_sqrt_C_;    // C^(-1/2)
+    size_t generation_ = 0;
+
+    Eigen::MatrixXd candidates_;    // One candidate per column
+    std::mt19937_64 rng_;
+
+    void update_eigensystem();
+};
+
+/**
+ * Differential Evolution - DE/rand/1/bin
+ * The first generation is the initial point plus uniform samples; afterwards
+ * each member competes against one mutant trial vector per generation.
+ */
+class DifferentialEvolution : public BlackBoxOptimizer {
+public:
+    /**
+     * @param x0 Seed member in the unit cube
+     * @param population Members (0 = 20)
+     * @param F Differential weight
+     * @param CR Crossover probability
+     */
+    DifferentialEvolution(const std::vector<double>& x0, size_t population, uint64_t seed,
+                          double F = 0.7, double CR = 0.9);
+
+    std::vector<std::vector<double>> ask() override;
+    void tell(const std::vector<double>& fitness) override;
+
+    size_t population_size() const override { return members_.size(); }
+    const char* name() const override { return "de"; }
+
+private:
+    size_t n_;
+    double F_;
+    double CR_;
+    std::vector<std::vector<double>> members_;
+    std::vector<double> member_fitness_;
+    std::vector<std::vector<double>> trials_;
+    bool initialized_ = false;
+    std::mt19937_64 rng_;
+};
+
+/**
+ * Create an optimizer by name ("cmaes" or "de")
+ * @throws runtime_error for unknown names
+ */
+std::unique_ptr<BlackBoxOptimizer> make_optimizer(const std::string& algorithm,
+                                                  const std::vector<double>& x0,
+                                                  size_t population,
+                                                  uint64_t seed);
+
+} // namespace trading
@@ -0,0 +1,233 @@
+#pragma once
+#include "core/types.h"
+#include "utils/latency_histogram.h"
+#include "utils/spsc_queue.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace trading {
+
+/**
+ * One order of a batch (signed quantity: > 0 buys, < 0 sells)
+ */
+struct OrderLeg {
+    uint64_t order_id = 0;
+    Symbol symbol;
+    int qty = 0;
+    double ref_price = 0.0;
+};
+
+/**
+ * Every order decided for one minute, sent as a single message. Exit legs
+ * (sells) go first so the broker frees buying power before the entries.
+ */
+struct OrderBatch {
+    uint64_t batch_id = 0;
+    uint64_t bar_id = 0;
+    std::vector<OrderLeg> legs;
+
+    void sort_exits_first();
+};
+
+enum class OrderWireFormat { JSON, BINARY };
+
+enum class OrderStatus : uint8_t { QUEUED = 0, SENT = 1, FILLED = 2, PENDING = 3, REJECTED = 4 };
+
+const char* order_status_name(OrderStatus status);
+
+/**
+ * Order Wire Protocol - Encoding of batches and broker responses
+ *
+ * JSON (NDJSON, one batch per line):
+ *   {"batch_id":7,"bar_id":42,"orders":[{"order_id":13,"action":"SELL",
+ *     "symbol":"TQQQ","shares":100,"ref_price":55.1},...]}
+ *   response: {"order_id":13,"status":"filled","filled_price":55.08}
+ *
+ * BINARY (little-endian, packed, fixed layout):
+ *   batch    = BinaryBatchHeader + count × BinaryOrderRecord
+ *   response = BinaryOrderResponse
+ * Symbols are NUL-padded to 8 bytes.
+ */
+namespace order_wire {
+
+constexpr uint32_t BATCH_MAGIC = 0x3142'4F53;     // "SOB1"
+constexpr uint32_t RESPONSE_MAGIC = 0x3152'4F53;  // "SOR1"
+constexpr size_t SYMBOL_BYTES = 8;
+
+#pragma pack(push, 1)
+struct BinaryBatchHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t count;
+    uint64_t batch_id;
+    uint64_t bar_id;
+};
+
+struct BinaryOrderRecord {
+    char symbol[SYMBOL_BYTES];
+    uint64_t order_id;
+    int32_t qty;
+    uint32_t reserved;
+    double ref_price;
+};
+
+struct BinaryOrderResponse {
+    uint32_t magic;
+    uint8_t status;         // OrderStatus
+    uint8_t reserved[3];
+    uint64_t order_id;
+    int32_t filled_qty;
+    uint32_t reserved2;
+    double filled_price;
+};
+#pragma pack(pop)
+
+static_assert(sizeof(BinaryBatchHeader) == 24, "wire layout");
+static_assert(sizeof(BinaryOrderRecord) == 32, "wire layout");
+static_assert(sizeof(BinaryOrderResponse) == 32, "wire layout");
+
+/**
+ * Append the encoded batch to `out`
+ * @throws runtime_error if a symbol does not fit the binary layout
+ */
+void encode(const OrderBatch& batch, OrderWireFormat format, std::string& out);
+
+struct Response {
+    uint64_t order_id = 0;
+    OrderStatus status = OrderStatus::PENDING;
+    double filled_price = 0.0;
+};
+
+/**
+ * Decode every complete response at the front of `buffer` (consumed bytes
+ * are erased). Malformed JSON lines / bad magic are skipped and counted.
+ */
+size_t decode_responses(std::string& buffer, OrderWireFormat format,
+                        std::vector<Response>& out, size_t& malformed);
+
+} // namespace order_wire
+
+/**
+ * Order Gateway - Non-blocking order hand-off to the broker bridge
+ *
+ * The caller (the live report stage) submits one OrderBatch per minute; the
+ * gateway's own thread encodes it, writes it to the order FIFO with
+ * non-blocking I/O and reads broker responses from the response FIFO,
+ * updating per-order state. submit() never blocks: batches wait in a bounded
+ * SPSC queue, and once `max_pending` encoded batches are waiting on a slow or
+ * absent bridge, further submissions are rejected and counted.
+ *
+ * The order FIFO is (re)opened lazily, so the bridge may start late or
+ * restart. Counters are atomics, readable from any thread.
+ *
+ * Usage:
+ *   OrderGateway gateway({"/tmp/alpaca_orders.fifo", "/tmp/alpaca_responses.fifo",
+ *                         OrderWireFormat::BINARY});
+ *   gateway.start();
+ *   gateway.submit(std::move(batch));   // report thread
+ *   gateway.stop();                     // drains for up to drain_timeout
+ */
+class OrderGateway {
+public:
+    struct Options {
+        std::string order_path;
+        std::string response_path;
+        OrderWireFormat format = OrderWireFormat::JSON;
+        size_t queue_capacity = 256;        // Submitted batches not yet taken by the I/O thread
+        size_t max_pending = 64;            // Encoded batches waiting for the FIFO
+        std::chrono::milliseconds reopen_interval{1000};
+        std::chrono::milliseconds drain_timeout{2000};
+    };
+
+    struct Stats {
+        std::atomic<uint64_t> batches_submitted{0};
+        std::atomic<uint64_t> batches_sent{0};
+        std::atomic<uint64_t> batches_rejected{0};  // Backpressure: queue or pending limit full
+        std::atomic<uint64_t> orders_sent{0};
+        std::atomic<uint64_t> orders_filled{0};
+        std::atomic<uint64_t> orders_rejected{0};   // Broker rejections
+        std::atomic<uint64_t> responses_unmatched{0};
+        std::atomic<uint64_t> responses_malformed{0};
+        std::atomic<uint64_t> write_errors{0};
+        std::atomic<uint64_t> pending_batches{0};
+    };
+
+    explicit OrderGateway(Options options);
+    ~OrderGateway();
+
+    OrderGateway(const OrderGateway&) = delete;
+    OrderGateway& operator=(const OrderGateway&) = delete;
+
+    void start();
+
+    /**
+     * Stop the I/O thread once queued batches are written and every sent order
+     * has a response (bounded by drain_timeout)
+     */
+    void stop();
+
+    /**
+     * Hand a batch to the I/O thread (single producer; never blocks)
+     * @return false if the batch was rejected for backpressure (the batch is left untouched)
+     */
+    bool submit(OrderBatch&& batch);
+
+    const Stats& stats() const { return stats_; }
+    const Options& options() const { return options_; }
+
+    /**
+     * Orders sent without a final (filled/rejected) response. Call after stop().
+     */
+    size_t outstanding() const;
+
+    /**
+     * Sent → first response latency. Call after stop().
+     */
+    const utils::LatencyHistogram& ack_latency() const { return ack_latency_; }
+
+private:
+    struct TrackedOrder {
+        Symbol symbol;
+        int qty = 0;
+        OrderStatus status = OrderStatus::QUEUED;
+        double filled_price = 0.0;
+        uint64_t sent_ns = 0;
+        bool acked = false;
+    };
+
+    struct PendingWrite {
+        std::string bytes;
+        size_t written = 0;
+        std::vector<uint64_t> order_ids;
+    };
+
+    Options options_;
+    SpscQueue<OrderBatch> inbound_;
+    std::atomic<bool> stopping_{false};
+    std::thread thread_;
+    Stats stats_;
+
+    // I/O thread state
+    int order_fd_ = -1;
+    int response_fd_ = -1;
+    std::chrono::steady_clock::time_point next_open_attempt_{};
+    std::deque<PendingWrite> pending_;
+    std::string response_buffer_;
+    std::unordered_map<uint64_t, TrackedOrder> orders_;
+    utils::LatencyHistogram ack_latency_;
+
+    void run();
+    void open_fds();
+    void take_inbound();
+    void flush_pending();
+    void read_responses();
+    void close_order_fd();
+};
+
+} // namespace trading
@@ -0,0 +1,139 @@
+#pragma once
+#include "trading/multi_symbol_trader.h"
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace trading {
+
+/**
+ * Parameter Registry - Tunable TradingConfig/SigorConfig fields by name
+ *
+ * Gives batch evaluation modes (sweep, serve, optimizers) uniform get/set
+ * access to the parameters the Python optimizers tune. Names match the keys
+ * in trading_params.json and sigor_params.json, so a parameter set is just a
+ * flat {"name": value} object applied on top of the loaded base config.
+ *
+ * Usage:
+ *   TradingConfig cfg = base;
+ *   apply_param(cfg, "w_rsi", 1.4);
+ *   apply_param(cfg, "max_positions", 2);
+ *   double k = find_param("k")->get(cfg);
+ */
+struct ParamInfo {
+    const char* name;
+    bool is_int;                                    // Rounded on set
+    double (*get)(const TradingConfig&);
+    void (*set)(TradingConfig&, double);
+};
+
+#define SENTIO_PARAM_DOUBLE(key, field) \
+    ParamInfo{key, false, \
+              [](const TradingConfig& c) { return static_cast<double>(c.field); }, \
+              [](TradingConfig& c, double v) { c.field = v; }}
+
+#define SENTIO_PARAM_INT(key, field, type) \
+    ParamInfo{key, true, \
+              [](const TradingConfig& c) { return static_cast<double>(c.field); }, \
+              [](TradingConfig& c, double v) { c.field = static_cast<type>(std::lround(v)); }}
+
+/**
+ * All tunable parameters (stable order: SIGOR first, then trading)
+ */
+inline const std::vector<ParamInfo>& tunable_params() {
+    static const std::vector<ParamInfo> params = {
+        // SIGOR fusion and detector weights
+        SENTIO_PARAM_DOUBLE("k", sigor_config.k),
+        SENTIO_PARAM_DOUBLE("w_boll", sigor_config.w_boll),
+        SENTIO_PARAM_DOUBLE("w_rsi", sigor_config.w_rsi),
+        SENTIO_PARAM_DOUBLE("w_mom", sigor_config.w_mom),
+        SENTIO_PARAM_DOUBLE("w_vwap", sigor_config.w_vwap),
+        SENTIO_PARAM_DOUBLE("w_orb", sigor_config.w_orb),
+        SENTIO_PARAM_DOUBLE("w_ofi", sigor_config.w_ofi),
+        SENTIO_PARAM_DOUBLE("w_vol", sigor_config.w_vol),
+
+        // SIGOR windows
+        SENTIO_PARAM_INT("win_boll", sigor_config.win_boll, int),
+        SENTIO_PARAM_INT("win_rsi", sigor_config.win_rsi, int),
+        SENTIO_PARAM_INT("win_mom", sigor_config.win_mom, int),
+        SENTIO_PARAM_INT("win_vwap", sigor_config.win_vwap, int),
+        SENTIO_PARAM_INT("orb_opening_bars", sigor_config.orb_opening_bars, int),
+        SENTIO_PARAM_INT("vol_window", sigor_config.vol_window, int),
+        SENTIO_PARAM_INT("warmup_bars", sigor_config.warmup_bars, int),
+
+        // Position management and rotation
+        SENTIO_PARAM_INT("max_positions", max_positions, size_t),
+        SENTIO_PARAM_INT("min_bars_to_hold", filter_config.min_bars_to_hold, int),
+        SENTIO_PARAM_DOUBLE("rotation_strength_delta", rotation_strength_delta),
+        SENTIO_PARAM_DOUBLE("min_rank_strength", min_rank_strength),
+        SENTIO_PARAM_INT("rotation_cooldown_bars", rotation_cooldown_bars, int),
+        SENTIO_PARAM_DOUBLE("buy_threshold", buy_threshold),
+        SENTIO_PARAM_DOUBLE("sell_threshold", sell_threshold),
+
+        // Exits
+        SENTIO_PARAM_DOUBLE("profit_target_pct", profit_target_pct),
+        SENTIO_PARAM_DOUBLE("stop_loss_pct", stop_loss_pct),
+        SENTIO_PARAM_DOUBLE("trailing_stop_percentage", trailing_stop_percentage),
+        SENTIO_PARAM_INT("ma_exit_period", ma_exit_period, int),
+
+        // Sizing
+        SENTIO_PARAM_DOUBLE("win_multiplier", win_multiplier),
+        SENTIO_PARAM_DOUBLE("loss_multiplier", loss_multiplier),
+        SENTIO_PARAM_DOUBLE("expected_win_pct", position_sizing.expected_win_pct),
+        SENTIO_PARAM_DOUBLE("expected_loss_pct", position_sizing.expected_loss_pct),
+        SENTIO_PARAM_DOUBLE("fractional_kelly", position_sizing.fractional_kelly),
+        SENTIO_PARAM_DOUBLE("min_position_pct", position_sizing.min_position_pct),
+        SENTIO_PARAM_DOUBLE("max_position_pct", position_sizing.max_position_pct),
+        SENTIO_PARAM_INT("volatility_lookback", position_sizing.volatility_lookback, int),
+        SENTIO_PARAM_DOUBLE("max_volatility_reduce", position_sizing.max_volatility_reduce),
+    };
+    return params;
+}
+
+#undef SENTIO_PARAM_DOUBLE
+#undef SENTIO_PARAM_INT
+
+/**
+ * Look up a parameter by name
+ * @return nullptr if unknown
+ */
+inline const ParamInfo* find_param(const std::string& name) {
+    for (const auto& p : tunable_params()) {
+        if (name == p.name) return &p;
+    }
+    return nullptr;
+}
+
+/**
+ * Set a parameter by name
+ * @throws runtime_error if the name is not a tunable parameter
+ */
+inline void apply_param(TradingConfig& config, const std::string& name, double value) {
+    const ParamInfo* p = find_param(name);
+    if (!p) {
+        throw std::runtime_error("Unknown parameter: '" + name + "'");
+    }
+    p->set(config, value);
+}
+
+/**
+ * Copy every tunable parameter of `from` into `to` (other fields untouched)
+ */
+inline void copy_tunable_params(TradingConfig& to, const TradingConfig& from) {
+    for (const auto& p : tunable_params()) {
+        p.set(to, p.get(from));
+    }
+}
+
+/**
+ * True if both configs agree on every tunable parameter
+ */
+inline bool same_tunable_params(const TradingConfig& a, const TradingConfig& b) {
+    for (const auto& p : tunable_params()) {
+        if (p.get(a) != p.get(b)) return false;
+    }
+    return true;
+}
+
+} // namespace trading
@@ -0,0 +1,137 @@
+#pragma once
+#include "trading/trade_history.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+namespace trading {
+
+/**
+ * Performance Accumulator - Streaming backtest statistics
+ *
+ * Maintains running trade and equity statistics so results can be read
+ * in O(1) at any point in a session instead of rescanning the trade log.
+ *
+ * Tracks:
+ * - Trade counts, win/loss sums, profit factor inputs
+ * - Per-trade return mean/variance (Welford) for Sharpe
+ * - Traded volume and realized transaction costs
+ * - Per-bar equity high-water mark and maximum drawdown
+ *
+ * Usage:
+ *   PerformanceAccumulator perf;
+ *   perf.record_trade(trade, exit_cost);   // on every exit
+ *   perf.record_equity(equity);            // once per bar
+ *   double dd = perf.max_drawdown();
+ */
+class PerformanceAccumulator {
+public:
+    /**
+     * Record a completed trade
+     * @param trade Completed trade (net P&L already includes costs)
+     * @param transaction_cost Costs charged for this trade
+     */
+    void record_trade(const TradeRecord& trade, double transaction_cost = 0.0) {
+        total_trades_++;
+        if (trade.is_win()) {
+            winning_trades_++;
+            gross_profit_ += trade.pnl;
+        } else if (trade.is_loss()) {
+            losing_trades_++;
+            gross_loss_ += std::abs(trade.pnl);
+        }
+
+        volume_ += std::abs(trade.shares * trade.entry_price);
+        volume_ += std::abs(trade.shares * trade.exit_price);
+        transaction_costs_ += transaction_cost;
+
+        // Welford's online mean/variance of per-trade returns
+        double delta = trade.pnl_pct - return_mean_;
+        return_mean_ += delta / static_cast<double>(total_trades_);
+        return_m2_ += delta * (trade.pnl_pct - return_mean_);
+    }
+
+    /**
+     * Record marked-to-market equity for the current bar
+     * Updates the high-water mark and maximum drawdown.
+     */
+    void record_equity(double equity) {
+        current_equity_ = equity;
+        equity_samples_++;
+
+        if (equity > peak_equity_ || equity_samples_ == 1) {
+            peak_equity_ = equity;
+        }
+
+        double drawdown = (peak_equity_ > 0) ? (peak_equity_ - equity) / peak_equity_ : 0.0;
+        max_drawdown_ = std::max(max_drawdown_, drawdown);
+    }
+
+    int total_trades() const { return total_trades_; }
+    int winning_trades() const { return winning_trades_; }
+    int losing_trades() const { return losing_trades_; }
+    double gross_profit() const { return gross_profit_; }
+    double gross_loss() const { return gross_loss_; }
+    double volume() const { return volume_; }
+    double transaction_costs() const { return transaction_costs_; }
+
+    double win_rate() const {
+        return (total_trades_ > 0) ? static_cast<double>(winning_trades_) / total_trades_ : 0.0;
+    }
+
+    double avg_win() const {
+        return (winning_trades_ > 0) ? gross_profit_ / winning_trades_ : 0.0;
+    }
+
+    double avg_loss() const {
+        return (losing_trades_ > 0) ? gross_loss_ / losing_trades_ : 0.0;
+    }
+
+    double profit_factor() const {
+        return (gross_loss_ > 0) ? gross_profit_ / gross_loss_ : (gross_profit_ > 0 ? 999.0 : 0.0);
+    }
+
+    /**
+     * Population standard deviation of per-trade returns
+     */
+    double return_stddev() const {
+        return (total_trades_ > 0) ? std::sqrt(return_m2_ / total_trades_) : 0.0;
+    }
+
+    /**
+     * Annualized per-trade Sharpe (same convention as warmup validation)
+     */
+    double sharpe_ratio() const {
+        if (total_trades_ < 2) return 0.0;
+        double sd = return_stddev();
+        return (sd > 0) ? (return_mean_ / sd) * std::sqrt(252.0) : 0.0;
+    }
+
+    bool has_equity() const { return equity_samples_ > 0; }
+    double current_equity() const { return current_equity_; }
+    double peak_equity() const { return peak_equity_; }
+    double max_drawdown() const { return max_drawdown_; }
+
+    void reset() { *this = PerformanceAccumulator(); }
+
+private:
+    int total_trades_ = 0;
+    int winning_trades_ = 0;
+    int losing_trades_ = 0;
+    double gross_profit_ = 0.0;
+    double gross_loss_ = 0.0;
+    double volume_ = 0.0;
+    double transaction_costs_ = 0.0;
+
+    // Welford state for per-trade returns
+    double return_mean_ = 0.0;
+    double return_m2_ = 0.0;
+
+    // Equity curve state
+    uint64_t equity_samples_ = 0;
+    double current_equity_ = 0.0;
+    double peak_equity_ = 0.0;
+    double max_drawdown_ = 0.0;
+};
+
+} // namespace trading
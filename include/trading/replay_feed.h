@@ -0,0 +1,97 @@
+#pragma once
+#include "core/bar.h"
+#include "core/types.h"
+#include "trading/live_clock.h"
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace trading {
+
+/**
+ * Replay Feed - Serves stored snapshots as live bridge NDJSON lines
+ *
+ * Drop-in line source for the live ingest stage: each minute's bars come out
+ * in symbol order, in the same format the websocket bridge writes, so they go
+ * through the real parser, queues, snapshot assembler and report stage. The
+ * ReplayClock paces (or, at speed 0, merely stamps) each minute at its market
+ * time relative to the first replayed minute.
+ *
+ * Prices are written with 17 significant digits, so parsed bars are
+ * bit-identical to the stored ones.
+ *
+ * Usage:
+ *   ReplayClock clock(60.0);                      // 60× speed
+ *   ReplayFeed feed(window.snapshots, first, symbols, clock);
+ *   std::string line;
+ *   while (feed.next(line)) ingest(line);
+ */
+class ReplayFeed {
+public:
+    using Snapshot = std::unordered_map<Symbol, Bar>;
+
+    /**
+     * @param snapshots Stored minutes in time order (must outlive the feed)
+     * @param first     Index of the first minute to replay
+     */
+    ReplayFeed(const std::vector<Snapshot>& snapshots, size_t first,
+               const std::vector<Symbol>& symbols, ReplayClock& clock)
+        : snapshots_(snapshots), symbols_(symbols), clock_(clock), minute_(first) {
+        if (first < snapshots.size()) start_ = minute_time(snapshots[first]);
+    }
+
+    /**
+     * Next bar line; waits for its minute on a paced clock
+     * @return false once every minute has been served
+     */
+    bool next(std::string& line) {
+        while (minute_ < snapshots_.size()) {
+            const Snapshot& snap = snapshots_[minute_];
+            if (symbol_ == 0) {
+                clock_.wait_until(clock_.origin() +
+                                  std::chrono::duration_cast<LiveClock::Clock::duration>(minute_time(snap) - start_));
+            }
+            while (symbol_ < symbols_.size()) {
+                auto it = snap.find(symbols_[symbol_++]);
+                if (it == snap.end()) continue;
+                format(it->first, it->second, line);
+                return true;
+            }
+            symbol_ = 0;
+            minute_++;
+        }
+        return false;
+    }
+
+    size_t minutes_left() const { return snapshots_.size() - std::min(minute_, snapshots_.size()); }
+
+private:
+    const std::vector<Snapshot>& snapshots_;
+    const std::vector<Symbol>& symbols_;
+    ReplayClock& clock_;
+    size_t minute_;
+    size_t symbol_ = 0;
+    Timestamp start_{};
+    char buf_[512];
+
+    Timestamp minute_time(const Snapshot& snap) const {
+        Timestamp earliest = Timestamp::max();
+        for (const auto& [_, bar] : snap) earliest = std::min(earliest, bar.timestamp);
+        return snap.empty() ? start_ : earliest;
+    }
+
+    void format(const Symbol& symbol, const Bar& bar, std::string& line) {
+        int n = std::snprintf(buf_, sizeof(buf_),
+                              "{\"symbol\":\"%s\",\"timestamp_ms\":%" PRId64 ",\"open\":%.17g,\"high\":%.17g,"
+                              "\"low\":%.17g,\"close\":%.17g,\"volume\":%" PRId64 "}",
+                              symbol.c_str(), to_timestamp_ms(bar.timestamp), bar.open, bar.high, bar.low, bar.close,
+                              static_cast<int64_t>(bar.volume));
+        line.assign(buf_, n > 0 ? std::min<size_t>(static_cast<size_t>(n), sizeof(buf_) - 1) : 0);
+    }
+};
+
+} // namespace trading
@@ -0,0 +1,83 @@
+#pragma once
+#include "trading/multi_symbol_trader.h"
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace trading {
+
+struct ReplayWindow;
+
+/**
+ * Result Cache - Content-addressed store of BacktestResults
+ *
+ * A backtest is a pure function of (engine build, effective config, replayed
+ * bars, timezone). The cache key is a canonical text of exactly those inputs:
+ *   - engine fingerprint (hash of the running executable, so any rebuild
+ *     invalidates old entries)
+ *   - every result-affecting TradingConfig / SigorConfig field, after the
+ *     runner's warmup preparation
+ *   - content hash of the replay window's bars, symbol order, dates, warmup
+ *   - TZ (EOD detection uses local time)
+ *
+ * Entries live in <dir>/<hh>/<hash>.res and store the full key, so a hash
+ * collision can never return another configuration's results. Writes go
+ * through a temp file + rename, so concurrent processes can share one
+ * directory. Hits are also kept in memory for the life of the process.
+ *
+ * Usage:
+ *   ResultCache cache("data/cache/backtests");
+ *   auto results = BacktestRunner::run(window, config, &cache);
+ */
+class ResultCache {
+public:
+    struct Stats {
+        size_t memory_hits = 0;
+        size_t disk_hits = 0;
+        size_t misses = 0;
+        size_t stores = 0;
+        size_t store_errors = 0;
+    };
+
+    /**
+     * @throws runtime_error if the directory cannot be created
+     */
+    explicit ResultCache(const std::string& directory);
+
+    /**
+     * Canonical key for running `prepared_config` over `window`
+     */
+    static std::string make_key(const ReplayWindow& window, const TradingConfig& prepared_config);
+
+    /**
+     * Look up a key (memory first, then disk)
+     * @return false on miss (including unreadable or mismatching entries)
+     */
+    bool lookup(const std::string& key, MultiSymbolTrader::BacktestResults& out);
+
+    /**
+     * Store results for a key (best effort: failures are counted, not thrown)
+     */
+    void store(const std::string& key, const MultiSymbolTrader::BacktestResults& results);
+
+    Stats stats() const;
+    const std::string& directory() const { return directory_; }
+
+private:
+    std::string directory_;
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, MultiSymbolTrader::BacktestResults> memory_;
+
+    std::atomic<size_t> memory_hits_{0};
+    std::atomic<size_t> disk_hits_{0};
+    std::atomic<size_t> misses_{0};
+    std::atomic<size_t> stores_{0};
+    std::atomic<size_t> store_errors_{0};
+
+    std::string path_for(const std::string& key) const;
+};
+
+} // namespace trading
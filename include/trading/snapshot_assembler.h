@@ -0,0 +1,127 @@
+#pragma once
+#include "core/bar.h"
+#include "core/types.h"
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+namespace trading {
+
+/**
+ * Snapshot Assembler - Minute-barrier assembly of live per-symbol bars
+ *
+ * The live feed delivers one bar per symbol per minute, in arbitrary order.
+ * Running the trader on every individual bar re-feeds stale bars for all the
+ * other symbols into their indicators. The assembler instead buffers bars by
+ * minute `bar_id` and releases each minute exactly once, when either:
+ *   1. every expected symbol has reported for that minute, or
+ *   2. the minute's deadline (measured from its first bar) has passed.
+ *
+ * Symbols that did not report by release time are carried forward from their
+ * last known bar as a flat bar (O=H=L=C=last close, volume 0) restamped to the
+ * released minute and flagged `stale`, so the trader can mark positions but
+ * never feed duplicates into indicator windows. Symbols never seen are omitted.
+ *
+ * Minutes are released strictly in ascending bar_id order. Bars for a minute
+ * that was already released are dropped and counted as late. Bars for a
+ * symbol outside the expected set are dropped and counted as unknown, so
+ * they never reach the trader.
+ *
+ * Usage:
+ *   SnapshotAssembler assembler(symbols, std::chrono::milliseconds(5000));
+ *   assembler.add_bar(bar, SnapshotAssembler::Clock::now());
+ *   assembler.poll(SnapshotAssembler::Clock::now());   // deadline check
+ *   SnapshotAssembler::Snapshot snap;
+ *   while (assembler.pop_ready(snap)) trader.on_bar(snap.bars);
+ */
+class SnapshotAssembler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Snapshot {
+        uint64_t bar_id = 0;
+        std::unordered_map<Symbol, Bar> bars;
+        size_t fresh_count = 0;      // Symbols that reported this minute
+        size_t stale_count = 0;      // Symbols carried forward
+        bool complete = false;       // True if released by the all-reported barrier
+    };
+
+    struct Stats {
+        size_t snapshots_released = 0;
+        size_t released_complete = 0;
+        size_t released_by_deadline = 0;
+        size_t stale_bars = 0;
+        size_t late_bars = 0;        // Arrived after their minute was released
+        size_t duplicate_bars = 0;   // Same symbol reported twice for one minute
+        size_t unknown_bars = 0;     // Symbol not in the expected set
+    };
+
+    /**
+     * @param symbols Expected symbols (barrier set)
+     * @param deadline Max wait after a minute's first bar before releasing it
+     */
+    SnapshotAssembler(const std::vector<Symbol>& symbols, std::chrono::milliseconds deadline);
+
+    /**
+     * Buffer a bar; releases its minute (and any earlier pending minutes)
+     * immediately if all expected symbols have now reported. Bars for
+     * unexpected symbols or already released minutes are dropped.
+     */
+    void add_bar(const Bar& bar, Clock::time_point now);
+
+    /**
+     * Release pending minutes whose deadline has passed
+     */
+    void poll(Clock::time_point now);
+
+    /**
+     * Release every pending minute regardless of deadline (end of session)
+     */
+    void flush();
+
+    /**
+     * Pop the oldest released snapshot
+     * @return false if none is ready
+     */
+    bool pop_ready(Snapshot& out);
+
+    bool has_ready() const { return !ready_.empty(); }
+    size_t pending_minutes() const { return pending_.size(); }
+
+    /**
+     * Time until the oldest pending minute hits its deadline
+     * (zero if overdue, Clock::duration::max() if nothing is pending)
+     */
+    Clock::duration time_to_next_deadline(Clock::time_point now) const;
+
+    /**
+     * Latest fresh bar seen for each symbol (for marking equity at session end)
+     */
+    const std::unordered_map<Symbol, Bar>& last_bars() const { return last_bars_; }
+
+    const Stats& stats() const { return stats_; }
+
+private:
+    struct PendingMinute {
+        std::unordered_map<Symbol, Bar> bars;
+        Clock::time_point first_seen;
+    };
+
+    std::vector<Symbol> symbols_;
+    std::chrono::milliseconds deadline_;
+
+    std::map<uint64_t, PendingMinute> pending_;       // Ordered by bar_id
+    std::deque<Snapshot> ready_;
+    std::unordered_map<Symbol, Bar> last_bars_;
+    uint64_t last_released_id_ = 0;
+    bool released_any_ = false;
+    Stats stats_;
+
+    void release_through(uint64_t bar_id, bool complete);
+    void release(uint64_t bar_id, PendingMinute& minute, bool complete);
+};
+
+} // namespace trading
@@ -0,0 +1,124 @@
+#pragma once
+#include "utils/latency_histogram.h"
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <ostream>
+
+namespace trading {
+
+/**
+ * Stages of MultiSymbolTrader::on_bar, in execution order
+ */
+enum class BarStage : size_t {
+    VALIDATION,         // Symbol presence / sync checks
+    MARKET_CONTEXT,     // Volume/volatility context for cost model
+    PRICE_HISTORY,      // Rolling closes for multi-bar returns
+    PREDICTION,         // SIGOR update + signal
+    FILTER_UPDATE,      // Trade filter bars-held counters
+    UPDATE_POSITIONS,   // Exit checks on open positions
+    TRADING,            // Phase handling, rotation cooldowns, make_trades
+    EOD,                // Day boundary, liquidation, equity mark
+    COUNT
+};
+
+inline const char* bar_stage_name(BarStage stage) {
+    switch (stage) {
+        case BarStage::VALIDATION:       return "validation";
+        case BarStage::MARKET_CONTEXT:   return "market_context";
+        case BarStage::PRICE_HISTORY:    return "price_history";
+        case BarStage::PREDICTION:       return "prediction";
+        case BarStage::FILTER_UPDATE:    return "filter_update";
+        case BarStage::UPDATE_POSITIONS: return "update_positions";
+        case BarStage::TRADING:          return "trading";
+        case BarStage::EOD:              return "eod";
+        default:                         return "unknown";
+    }
+}
+
+/**
+ * Stage Profiler - Per-stage on_bar latency histograms
+ *
+ * on_bar calls begin() once, lap(stage) as each stage finishes and end() after
+ * the last lap. A lap records the time since the previous lap into that
+ * stage's histogram, so instrumentation costs one steady_clock read per stage.
+ *
+ * Compiled in when SENTIO_STAGE_TIMING is defined (CMake option, default ON);
+ * otherwise the SENTIO_STAGE_* macros expand to nothing and the histograms
+ * stay empty.
+ */
+class StageProfiler {
+public:
+    static constexpr size_t NUM_STAGES = static_cast<size_t>(BarStage::COUNT);
+
+    void begin() { bar_start_ = last_ = now_ns(); }
+
+    void lap(BarStage stage) {
+        uint64_t t = now_ns();
+        stages_[static_cast<size_t>(stage)].record(t - last_);
+        last_ = t;
+    }
+
+    void end() { total_.record(last_ - bar_start_); }
+
+    const utils::LatencyHistogram& stage(BarStage s) const { return stages_[static_cast<size_t>(s)]; }
+    const utils::LatencyHistogram& total() const { return total_; }
+    bool empty() const { return total_.count() == 0; }
+
+    void reset() {
+        for (auto& h : stages_) h.reset();
+        total_.reset();
+    }
+
+    /**
+     * Table of per-stage percentiles (microseconds) and share of on_bar time
+     */
+    void print(std::ostream& out) const {
+        if (empty()) return;
+        auto flags = out.flags();
+        auto precision = out.precision();
+        out << "on_bar Stage Latency (" << total_.count() << " bars, µs):\n";
+        out << "  Stage                 p50       p90       p99       max     share\n";
+        auto row = [&](const char* name, const utils::LatencyHistogram& h) {
+            double share = total_.total_ns() ? 100.0 * h.total_ns() / total_.total_ns() : 0.0;
+            out << "  " << std::left << std::setw(18) << name << std::right << std::fixed
+                << std::setprecision(1)
+                << std::setw(8) << h.percentile(0.50) / 1000.0
+                << std::setw(10) << h.percentile(0.90) / 1000.0
+                << std::setw(10) << h.percentile(0.99) / 1000.0
+                << std::setw(10) << h.max() / 1000.0
+                << std::setw(9) << share << "%\n";
+        };
+        for (size_t i = 0; i < NUM_STAGES; ++i) {
+            row(bar_stage_name(static_cast<BarStage>(i)), stages_[i]);
+        }
+        row("total", total_);
+        out.flags(flags);
+        out.precision(precision);
+    }
+
+private:
+    std::array<utils::LatencyHistogram, NUM_STAGES> stages_;
+    utils::LatencyHistogram total_;
+    uint64_t bar_start_ = 0;
+    uint64_t last_ = 0;
+
+    static uint64_t now_ns() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+};
+
+#ifdef SENTIO_STAGE_TIMING
+#define SENTIO_STAGE_BEGIN(profiler) (profiler).begin()
+#define SENTIO_STAGE_LAP(profiler, stage) (profiler).lap(BarStage::stage)
+#define SENTIO_STAGE_END(profiler) (profiler).end()
+#else
+#define SENTIO_STAGE_BEGIN(profiler) ((void)0)
+#define SENTIO_STAGE_LAP(profiler, stage) ((void)0)
+#define SENTIO_STAGE_END(profiler) ((void)0)
+#endif
+
+} // namespace trading
@@ -0,0 +1,142 @@
+#pragma once
+#include "core/bar.h"
+#include "core/types.h"
+#include "trading/multi_symbol_trader.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace trading {
+
+/**
+ * State Journal - Crash-safe live trader state for intraday restart
+ *
+ * Two files in one directory:
+ *   checkpoint.bin  The latest full trader checkpoint
+ *                   (MultiSymbolTrader::save_checkpoint). It also stores the
+ *                   minute it covers and the tunable parameters in force.
+ *                   Replaced atomically: write tmp, fsync, rename.
+ *   journal.wal     Write-ahead log since that checkpoint. It has one record
+ *                   per minute the trader processed: the minute's bars plus
+ *                   a digest of cash, positions and trade count after on_bar.
+ *                   It also has one record per parameter reload. Each record
+ *                   is appended and fdatasync'd before the minute's orders
+ *                   are emitted.
+ *
+ * The trader is deterministic in its inputs. Replaying the logged minutes on
+ * top of the checkpoint therefore rebuilds the exact pre-crash state,
+ * indicator history included. The digest makes any divergence an error
+ * rather than silently wrong positions. Records are length-prefixed and
+ * checksummed, so a record torn by a crash mid-write is dropped. Records of
+ * either type at or before the checkpoint's minute are skipped; they appear
+ * if the process died between the checkpoint rename and the log truncation.
+ * A reload is logged under the minute it precedes, so the checkpoint of that
+ * minute already includes it.
+ *
+ * Usage:
+ *   StateJournal journal("logs/live/state");          // Writer (one thread)
+ *   journal.write_checkpoint(StateJournal::encode_checkpoint(0, trader));
+ *   journal.append(StateJournal::encode_minute(bar_id, snapshot, trader));
+ *
+ *   uint64_t last_bar_id;                              // After a crash
+ *   auto trader = StateJournal::restore(StateJournal::load("logs/live/state"),
+ *                                       config.trading, last_bar_id);
+ */
+class StateJournal {
+public:
+    enum class RecordType : uint8_t { MINUTE = 1, RELOAD = 2 };
+
+    /**
+     * Trader state after a minute, checked on replay
+     */
+    struct Digest {
+        double cash = 0.0;
+        uint64_t positions = 0;
+        int64_t trades = 0;
+        int64_t position_shares = 0;    // Signed sum over open positions
+
+        static Digest of(const MultiSymbolTrader& trader);
+        bool operator==(const Digest& o) const {
+            return cash == o.cash && positions == o.positions && trades == o.trades &&
+                   position_shares == o.position_shares;
+        }
+    };
+
+    struct Record {
+        RecordType type = RecordType::MINUTE;
+        uint64_t bar_id = 0;
+        std::unordered_map<Symbol, Bar> bars;   // MINUTE
+        Digest digest;                          // MINUTE
+        std::vector<double> params;             // RELOAD: tunable_params() values, in order
+    };
+
+    struct Recovery {
+        uint64_t checkpoint_bar_id = 0;
+        std::vector<double> params;             // Tunable parameters at the checkpoint
+        std::string trader_state;               // save_checkpoint() bytes
+        std::vector<Record> records;            // Logged after the checkpoint, in order
+        size_t skipped_records = 0;             // Minutes and reloads already covered by the checkpoint
+        size_t torn_bytes = 0;                  // Incomplete or corrupt tail dropped
+    };
+
+    // ---- Encoding (pure; the decision stage builds records) ----
+    static std::string encode_minute(uint64_t bar_id, const std::unordered_map<Symbol, Bar>& bars,
+                                     const MultiSymbolTrader& trader);
+    static std::string encode_reload(uint64_t bar_id, const TradingConfig& config);
+    static std::string encode_checkpoint(uint64_t bar_id, const MultiSymbolTrader& trader);
+
+    // ---- Writer (owned by one thread) ----
+
+    /**
+     * Create the directory if needed and open the log for appending
+     * @throws runtime_error if the directory or log cannot be opened
+     */
+    explicit StateJournal(std::string directory);
+    ~StateJournal();
+
+    StateJournal(const StateJournal&) = delete;
+    StateJournal& operator=(const StateJournal&) = delete;
+
+    /**
+     * Append one encoded record and flush it to disk
+     * @throws runtime_error on write failure
+     */
+    void append(const std::string& record);
+
+    /**
+     * Replace the checkpoint atomically, then truncate the log it covers
+     * @throws runtime_error on write failure
+     */
+    void write_checkpoint(const std::string& checkpoint);
+
+    const std::string& directory() const { return directory_; }
+    uint64_t records_appended() const { return records_appended_; }
+    uint64_t checkpoints_written() const { return checkpoints_written_; }
+
+    // ---- Recovery ----
+
+    /**
+     * Read the checkpoint and every intact log record after it
+     * @throws runtime_error if there is no valid checkpoint
+     */
+    static Recovery load(const std::string& directory);
+
+    /**
+     * Rebuild the trader: checkpoint under `base` (with the checkpoint's
+     * tunable parameters), then every logged minute and reload replayed in order
+     * @param last_bar_id Set to the last minute the trader has processed
+     * @throws runtime_error if replay does not reproduce a logged digest
+     */
+    static std::unique_ptr<MultiSymbolTrader> restore(const Recovery& recovery, const TradingConfig& base,
+                                                      uint64_t& last_bar_id);
+
+private:
+    std::string directory_;
+    int wal_fd_ = -1;
+    uint64_t records_appended_ = 0;
+    uint64_t checkpoints_written_ = 0;
+};
+
+} // namespace trading
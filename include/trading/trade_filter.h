@@ -1,9 +1,10 @@
 #pragma once
 #include "core/types.h"
 #include "predictor/multi_horizon_predictor.h"
+#include "utils/binary_io.h"
+#include "utils/circular_buffer.h"
 #include <string>
 #include <unordered_map>
-#include <deque>
 
 namespace trading {
 
@@ -162,6 +163,11 @@ public:
      */
     const Config& config() const { return config_; }
 
+    /**
+     * Replace thresholds and limits; position and frequency state are kept
+     */
+    void set_config(const Config& config) { config_ = config; }
+
     /**
      * Get trade statistics
      */
@@ -174,12 +180,24 @@ public:
 
     TradeStats get_trade_stats(int current_bar) const;
 
+    /**
+     * Take over another filter's position and frequency state (keeps this config)
+     */
+    void copy_state_from(const TradeFilter& other);
+
+    /**
+     * Write / restore position and frequency state for a checkpoint (config excluded)
+     */
+    void save_state(utils::BinaryWriter& out) const;
+    void load_state(utils::BinaryReader& in);
+
 private:
     Config config_;
     std::unordered_map<Symbol, PositionState> position_states_;
 
     // Trade history for frequency management
-    std::deque<int> trade_bars_;    // Bar numbers when trades occurred
+    static constexpr size_t MAX_TRADE_BARS = 500;  // ~1 day of minute data
+    CircularBuffer<int> trade_bars_{MAX_TRADE_BARS};  // Bar numbers when trades occurred (oldest first)
     int last_day_reset_ = 0;        // Last bar when daily counter was reset
 
     /**
@@ -0,0 +1,219 @@
+#pragma once
+#include "trading/trade_history.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace trading {
+
+/**
+ * Trade Journal - Append-only log of completed trades
+ *
+ * Replaces the old in-memory trade vector that erased its oldest half past
+ * 10,000 trades. Trades are stored as fixed-size binary records; none is
+ * ever dropped. Two modes, chosen when the owner is built:
+ *   Memory only (no spill path; backtest, sweep and serve trials): records
+ *       go into an array that starts at `ring_capacity` slots and doubles
+ *       when full. append() never touches the disk or starts a thread.
+ *   Spilling (open_spill(), called once at construction in live mode): the
+ *       array becomes a ring of fixed size, and a background writer thread
+ *       streams records to an on-disk log, so memory stays constant.
+ *
+ * File format (little-endian):
+ *   Header:  magic "SLTJ" | uint32 version | uint32 record_size | uint32 reserved
+ *   Records: Record[ ] (96 bytes each, see below)
+ *
+ * Usage:
+ *   TradeJournal journal;                     // memory only
+ *   journal.open_spill("logs/live/trades.bin"); // optional: persist from now on
+ *   journal.append(trade);
+ *   for (const TradeRecord& t : journal) { ... }  // full history, oldest first
+ *
+ * Threading: append() and iteration are called from the trading thread only;
+ * the writer thread never touches the trader.
+ *
+ * Blocking: when spilling, append() waits for the writer only if it has
+ * fallen a full ring of records behind the disk. Iteration and flush() wait
+ * until every record is on disk. In memory-only mode nothing blocks.
+ *
+ * Write errors (disk full, EIO): a record counts as on disk only after its
+ * write and fdatasync succeeded. Until then it stays in memory - the ring
+ * grows instead of blocking append() - and the writer retries every second.
+ * write_error() reports the failure; checkpoint() stays exact throughout.
+ */
+class TradeJournal {
+public:
+    /**
+     * Fixed-size on-disk/in-ring trade record
+     */
+    struct Record {
+        int64_t entry_time_ms;
+        int64_t exit_time_ms;
+        uint64_t entry_bar_id;
+        uint64_t exit_bar_id;
+        uint64_t exit_bar_index;
+        double pnl;
+        double pnl_pct;
+        double entry_price;
+        double exit_price;
+        int32_t shares;
+        char symbol[20];         // NUL-terminated, truncated if longer
+
+        static Record from_trade(const TradeRecord& trade);
+        TradeRecord to_trade() const;
+    };
+
+    static constexpr uint32_t kFileVersion = 1;
+    static constexpr size_t kHeaderSize = 16;
+
+    /**
+     * @param ring_capacity Initial in-memory slots. Once spilling, this is the
+     *                      most records that can wait for the writer.
+     */
+    explicit TradeJournal(size_t ring_capacity = 4096);
+    ~TradeJournal();
+
+    TradeJournal(const TradeJournal&) = delete;
+    TradeJournal& operator=(const TradeJournal&) = delete;
+
+    /**
+     * Start persisting records to `path` from a background writer.
+     * Records already in memory are written first, and the array stops
+     * growing. Must be called at most once.
+     * @throws runtime_error if the file cannot be created
+     */
+    void open_spill(const std::string& path);
+
+    /**
+     * Continue the spill file of an earlier journal (restart after a crash).
+     * The file is cut back to its first `persisted` records, which drops
+     * whatever was written after the checkpoint, and appending resumes there.
+     * Must be called on an empty journal that is not spilling yet.
+     * @throws runtime_error if the file is missing, not a trade journal or
+     *         shorter than `persisted` records
+     */
+    void resume_spill(const std::string& path, uint64_t persisted);
+
+    /**
+     * Where the journal stands, for a trader checkpoint
+     */
+    struct Checkpoint {
+        std::string spill_path;         // Empty for a memory-only journal
+        uint64_t persisted = 0;         // Records already durable in spill_path
+        std::vector<Record> pending;    // Records after those (every record when memory-only)
+    };
+
+    /**
+     * Take a checkpoint without waiting on the writer or reading the file
+     * back: only the records still in memory are copied (O(ring) at most).
+     * While the writer is failing, every record it could not write is in
+     * `pending`.
+     */
+    Checkpoint checkpoint() const;
+
+    /**
+     * Append a completed trade (amortized O(1); when spilling, blocks only if
+     * the writer falls a full ring behind while its writes succeed)
+     */
+    void append(const TradeRecord& trade);
+
+    /**
+     * Block until every appended record has been written to disk (no-op when not spilling)
+     * @throws runtime_error if a write attempt made meanwhile failed (the
+     *         records stay in memory and the writer keeps retrying)
+     */
+    void flush() const;
+
+    /**
+     * Why the last spill write failed; empty when the last write succeeded
+     */
+    std::string write_error() const;
+
+    /**
+     * Total number of trades ever appended
+     */
+    size_t size() const { return static_cast<size_t>(appended_.load(std::memory_order_acquire)); }
+    bool empty() const { return size() == 0; }
+
+    /**
+     * True once records are being streamed to disk
+     */
+    bool spilling() const { return writer_.joinable(); }
+    const std::string& spill_path() const { return spill_path_; }
+    size_t ring_capacity() const { return ring_.size(); }
+
+    /**
+     * Input iterator over the full history (oldest first)
+     *
+     * Reads spilled records back from disk in chunks, so iterating a journal of
+     * any length uses constant memory. Records appended after begin() is called
+     * are not visited.
+     */
+    class Iterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = TradeRecord;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const TradeRecord*;
+        using reference = const TradeRecord&;
+
+        Iterator() = default;
+
+        reference operator*() const { return current_; }
+        pointer operator->() const { return &current_; }
+        Iterator& operator++();
+        bool operator==(const Iterator& other) const { return index_ == other.index_; }
+        bool operator!=(const Iterator& other) const { return index_ != other.index_; }
+
+    private:
+        friend class TradeJournal;
+        struct Source;
+
+        Iterator(std::shared_ptr<Source> source, uint64_t index, uint64_t end);
+        void load();
+
+        std::shared_ptr<Source> source_;
+        uint64_t index_ = 0;
+        uint64_t end_ = 0;
+        TradeRecord current_;
+    };
+
+    Iterator begin() const;
+    Iterator end() const;
+
+private:
+    std::vector<Record> ring_;
+
+    // Sequence numbers (monotonic record counts)
+    std::atomic<uint64_t> appended_{0};   // Records written into the ring
+    std::atomic<uint64_t> flushed_{0};    // Records written and fdatasync'd to disk
+
+    // Background writer state
+    std::string spill_path_;
+    std::FILE* file_ = nullptr;
+    std::thread writer_;
+    mutable std::mutex mutex_;
+    mutable std::condition_variable writer_cv_;   // Wakes the writer
+    mutable std::condition_variable space_cv_;    // Wakes producers / flush waiters
+    bool stop_ = false;
+    mutable bool flush_requested_ = false;
+    bool writing_ = false;              // Writer is reading the ring outside the lock
+    uint64_t write_attempts_ = 0;
+    std::string write_error_;           // Last attempt's failure (empty if it succeeded)
+
+    void start_writer(const std::string& path);
+    void writer_loop();
+    bool write_range(uint64_t from, uint64_t to, std::string& error);
+    void grow_ring();
+    size_t flush_batch() const { return std::max<size_t>(1, ring_.size() / 4); }
+};
+
+} // namespace trading
@@ -0,0 +1,117 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace utils {
+
+/**
+ * Binary Writer - Appends native-layout values to a byte string
+ *
+ * Used for in-process state checkpoints: values are written with the host's
+ * size and endianness, so a checkpoint is only readable by the same build.
+ *
+ * Usage:
+ *   utils::BinaryWriter out;
+ *   out.put(bar_count);
+ *   out.put_vector(closes);
+ *   std::string bytes = out.take();
+ */
+class BinaryWriter {
+public:
+    void put_bytes(const void* data, size_t size) {
+        buffer_.append(static_cast<const char*>(data), size);
+    }
+
+    template<typename T>
+    void put(const T& value) {
+        static_assert(std::is_trivially_copyable<T>::value, "put needs a trivially copyable type");
+        put_bytes(&value, sizeof(T));
+    }
+
+    void put_string(const std::string& s) {
+        put<uint64_t>(s.size());
+        put_bytes(s.data(), s.size());
+    }
+
+    template<typename T>
+    void put_vector(const std::vector<T>& v) {
+        static_assert(std::is_trivially_copyable<T>::value, "put_vector needs a trivially copyable type");
+        put<uint64_t>(v.size());
+        if (!v.empty()) put_bytes(v.data(), v.size() * sizeof(T));
+    }
+
+    size_t size() const { return buffer_.size(); }
+    const std::string& data() const { return buffer_; }
+    std::string take() { return std::move(buffer_); }
+
+private:
+    std::string buffer_;
+};
+
+/**
+ * Binary Reader - Reads values written by BinaryWriter
+ * @throws runtime_error on reads past the end of the buffer
+ */
+class BinaryReader {
+public:
+    explicit BinaryReader(const std::string& data)
+        : data_(data.data()), size_(data.size()) {}
+
+    void get_bytes(void* out, size_t size) {
+        if (size > size_ - pos_) {
+            throw std::runtime_error("Binary data truncated");
+        }
+        std::memcpy(out, data_ + pos_, size);
+        pos_ += size;
+    }
+
+    template<typename T>
+    T get() {
+        static_assert(std::is_trivially_copyable<T>::value, "get needs a trivially copyable type");
+        T value;
+        get_bytes(&value, sizeof(T));
+        return value;
+    }
+
+    template<typename T>
+    void get(T& value) { value = get<T>(); }
+
+    std::string get_string() {
+        size_t n = length(1);
+        std::string s(n, '\0');
+        get_bytes(&s[0], n);
+        return s;
+    }
+
+    template<typename T>
+    void get_vector(std::vector<T>& v) {
+        static_assert(std::is_trivially_copyable<T>::value, "get_vector needs a trivially copyable type");
+        v.resize(length(sizeof(T)));
+        if (!v.empty()) get_bytes(v.data(), v.size() * sizeof(T));
+    }
+
+    /**
+     * Element count prefix, validated against the bytes left
+     */
+    size_t length(size_t element_size) {
+        uint64_t n = get<uint64_t>();
+        if (element_size > 0 && n > (size_ - pos_) / element_size) {
+            throw std::runtime_error("Binary data truncated");
+        }
+        return static_cast<size_t>(n);
+    }
+
+    bool at_end() const { return pos_ == size_; }
+
+private:
+    const char* data_;
+    size_t size_;
+    size_t pos_ = 0;
+};
+
+} // namespace utils
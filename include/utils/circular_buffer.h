@@ -77,6 +77,23 @@ public:
      */
     bool full() const { return size_ == capacity_; }
 
+    /**
+     * Access oldest element
+     */
+    const T& front() const {
+        if (empty()) throw std::runtime_error("Buffer is empty");
+        return buffer_[head_];
+    }
+
+    /**
+     * Drop oldest element
+     */
+    void pop_front() {
+        if (empty()) throw std::runtime_error("Buffer is empty");
+        head_ = (head_ + 1) % capacity_;
+        size_--;
+    }
+
     /**
      * Access most recent element
      */
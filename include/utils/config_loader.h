@@ -1,6 +1,7 @@
 #pragma once
 
 #include "trading/multi_symbol_trader.h"
+#include "trading/param_registry.h"
 #include "strategy/sigor_strategy.h"
 // Removed unused AWR loader and Williams RSI config
 #include <string>
@@ -8,6 +9,7 @@
 #include <sstream>
 #include <stdexcept>
 #include <iostream>
+#include <cmath>
 
 namespace trading {
 
@@ -182,6 +184,55 @@ public:
         std::cout << "═══════════════════════════════════════════════════════\n\n";
     }
 
+    /**
+     * Sanity-check tunable parameters before they reach a running trader
+     * (live hot reload and every batch-mode parameter set; the loaders
+     * themselves only parse)
+     *
+     * @throws runtime_error naming the first offending parameter
+     */
+    static void validate(const TradingConfig& config) {
+        for (const auto& p : tunable_params()) {
+            if (!std::isfinite(p.get(config))) {
+                throw std::runtime_error(std::string("Parameter '") + p.name + "' is not a finite number");
+            }
+        }
+        auto require = [](bool ok, const std::string& what) {
+            if (!ok) throw std::runtime_error("Invalid parameter: " + what);
+        };
+
+        const SigorConfig& s = config.sigor_config;
+        require(s.k > 0.0, "k must be > 0");
+        require(s.w_boll >= 0 && s.w_rsi >= 0 && s.w_mom >= 0 && s.w_vwap >= 0 &&
+                s.w_orb >= 0 && s.w_ofi >= 0 && s.w_vol >= 0, "SIGOR weights must be >= 0");
+        require(s.w_boll + s.w_rsi + s.w_mom + s.w_vwap + s.w_orb + s.w_ofi + s.w_vol > 0.0,
+                "at least one SIGOR weight must be > 0");
+        for (int window : {s.win_boll, s.win_rsi, s.win_mom, s.win_vwap, s.orb_opening_bars, s.vol_window}) {
+            require(window >= 1 && static_cast<size_t>(window) < SigorStrategy::max_window(),
+                    "SIGOR windows must be in [1, " + std::to_string(SigorStrategy::max_window() - 1) + "]");
+        }
+        require(s.warmup_bars >= 0, "warmup_bars must be >= 0");
+
+        require(config.max_positions >= 1, "max_positions must be >= 1");
+        require(config.filter_config.min_bars_to_hold >= 0, "min_bars_to_hold must be >= 0");
+        require(config.rotation_cooldown_bars >= 0, "rotation_cooldown_bars must be >= 0");
+        require(config.buy_threshold > 0.0 && config.buy_threshold < 1.0 &&
+                config.sell_threshold > 0.0 && config.sell_threshold < 1.0,
+                "buy/sell thresholds must be in (0, 1)");
+        require(config.sell_threshold <= config.buy_threshold, "sell_threshold must be <= buy_threshold");
+        require(config.profit_target_pct > 0.0 && config.stop_loss_pct > 0.0 && config.stop_loss_pct < 1.0,
+                "profit_target_pct and stop_loss_pct must be > 0 (stop < 1)");
+        require(config.trailing_stop_percentage >= 0.0 && config.trailing_stop_percentage <= 1.0,
+                "trailing_stop_percentage must be in [0, 1]");
+        require(config.ma_exit_period >= 1, "ma_exit_period must be >= 1");
+
+        const auto& ps = config.position_sizing;
+        require(ps.min_position_pct > 0.0 && ps.min_position_pct <= ps.max_position_pct &&
+                ps.max_position_pct <= 1.0, "position sizing needs 0 < min_position_pct <= max_position_pct <= 1");
+        require(ps.fractional_kelly > 0.0, "fractional_kelly must be > 0");
+        require(ps.volatility_lookback >= 1, "volatility_lookback must be >= 1");
+    }
+
 private:
 
     /**
@@ -0,0 +1,51 @@
+#pragma once
+#include <cerrno>
+#include <poll.h>
+#include <string>
+#include <unistd.h>
+
+namespace trading {
+
+/**
+ * Line reader over a raw file descriptor with a poll() timeout
+ * Lets the live loop wake up for snapshot deadlines while the feed is idle.
+ */
+class FdLineReader {
+public:
+    enum class Status { LINE, TIMEOUT, CLOSED };
+
+    explicit FdLineReader(int fd) : fd_(fd) {}
+
+    Status next(std::string& line, int timeout_ms) {
+        while (true) {
+            auto nl = buffer_.find('\n');
+            if (nl != std::string::npos) {
+                line.assign(buffer_, 0, nl);
+                buffer_.erase(0, nl + 1);
+                return Status::LINE;
+            }
+
+            struct pollfd pfd = {fd_, POLLIN, 0};
+            int ready = ::poll(&pfd, 1, timeout_ms);
+            if (ready < 0 && errno == EINTR) continue;
+            if (ready == 0) return Status::TIMEOUT;
+
+            char chunk[4096];
+            ssize_t n = ::read(fd_, chunk, sizeof(chunk));
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) {
+                if (buffer_.empty()) return Status::CLOSED;
+                line.swap(buffer_);  // Final unterminated line
+                buffer_.clear();
+                return Status::LINE;
+            }
+            buffer_.append(chunk, static_cast<size_t>(n));
+        }
+    }
+
+private:
+    int fd_;
+    std::string buffer_;
+};
+
+} // namespace trading
@@ -0,0 +1,56 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <type_traits>
+
+namespace utils {
+
+/**
+ * Fingerprint - Incremental 64-bit FNV-1a hash
+ *
+ * Stable across runs and platforms of the same endianness; used to address
+ * cached results and to fingerprint market data. Not cryptographic - callers
+ * that need exactness (e.g. ResultCache) also compare the full key.
+ *
+ * Usage:
+ *   utils::Fingerprint fp;
+ *   fp.add_string(symbol);
+ *   fp.add_value(bar.close);
+ *   std::string hex = fp.hex();
+ */
+class Fingerprint {
+public:
+    void add_bytes(const void* data, size_t size) {
+        const auto* p = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            hash_ ^= p[i];
+            hash_ *= 0x100000001b3ULL;
+        }
+    }
+
+    template<typename T>
+    void add_value(const T& value) {
+        static_assert(std::is_trivially_copyable<T>::value, "add_value needs a trivially copyable type");
+        add_bytes(&value, sizeof(T));
+    }
+
+    void add_string(const std::string& s) {
+        add_value(s.size());   // Length prefix: "ab"+"c" != "a"+"bc"
+        add_bytes(s.data(), s.size());
+    }
+
+    uint64_t value() const { return hash_; }
+
+    std::string hex() const {
+        char buf[17];
+        std::snprintf(buf, sizeof(buf), "%016llx", static_cast<unsigned long long>(hash_));
+        return buf;
+    }
+
+private:
+    uint64_t hash_ = 0xcbf29ce484222325ULL;
+};
+
+} // namespace utils
@@ -0,0 +1,110 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace utils {
+
+/**
+ * Latency Histogram - Fixed-size log-linear (HDR-style) histogram of nanoseconds
+ *
+ * Values below 32ns get exact buckets; above that every power of two is split
+ * into 32 linear sub-buckets, so any reported percentile is within ~3% of the
+ * true value. Covers up to ~2^41 ns (~36 min); larger values land in the top
+ * bucket. Recording is O(1) with no allocation, so it is safe on hot paths.
+ * Not thread-safe: use one per thread and merge().
+ *
+ * Usage:
+ *   utils::LatencyHistogram h;
+ *   h.record(elapsed_ns);
+ *   double p99 = h.percentile(0.99);
+ */
+class LatencyHistogram {
+public:
+    static constexpr int SUB_BITS = 5;
+    static constexpr uint64_t SUB_COUNT = uint64_t(1) << SUB_BITS;   // 32
+    static constexpr int MAX_SHIFT = 36;
+    static constexpr size_t NUM_BUCKETS = SUB_COUNT * (MAX_SHIFT + 2);
+
+    void record(uint64_t ns) {
+        counts_[bucket_of(ns)]++;
+        count_++;
+        sum_ += ns;
+        min_ = std::min(min_, ns);
+        max_ = std::max(max_, ns);
+    }
+
+    void merge(const LatencyHistogram& other) {
+        for (size_t i = 0; i < NUM_BUCKETS; ++i) counts_[i] += other.counts_[i];
+        count_ += other.count_;
+        sum_ += other.sum_;
+        min_ = std::min(min_, other.min_);
+        max_ = std::max(max_, other.max_);
+    }
+
+    void reset() { *this = LatencyHistogram(); }
+
+    uint64_t count() const { return count_; }
+    uint64_t total_ns() const { return sum_; }
+    uint64_t min() const { return count_ ? min_ : 0; }
+    uint64_t max() const { return max_; }
+    double mean() const { return count_ ? static_cast<double>(sum_) / count_ : 0.0; }
+
+    /**
+     * Value at quantile q in [0, 1] (bucket midpoint, clamped to the observed range)
+     */
+    double percentile(double q) const {
+        if (count_ == 0) return 0.0;
+        q = std::min(1.0, std::max(0.0, q));
+        uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(q * static_cast<double>(count_) + 0.5));
+        uint64_t seen = 0;
+        for (size_t i = 0; i < NUM_BUCKETS; ++i) {
+            seen += counts_[i];
+            if (seen >= rank) {
+                double mid = (static_cast<double>(lower_bound(i)) + static_cast<double>(upper_bound(i))) / 2.0;
+                return std::min(static_cast<double>(max_), std::max(static_cast<double>(min()), mid));
+            }
+        }
+        return static_cast<double>(max_);
+    }
+
+private:
+    std::array<uint64_t, NUM_BUCKETS> counts_{};
+    uint64_t count_ = 0;
+    uint64_t sum_ = 0;
+    uint64_t min_ = std::numeric_limits<uint64_t>::max();
+    uint64_t max_ = 0;
+
+    static int msb(uint64_t v) {
+#if defined(__GNUC__) || defined(__clang__)
+        return 63 - __builtin_clzll(v);
+#else
+        int bit = 0;
+        while (v >>= 1) bit++;
+        return bit;
+#endif
+    }
+
+    static size_t bucket_of(uint64_t v) {
+        if (v < SUB_COUNT) return static_cast<size_t>(v);
+        int shift = std::min(msb(v) - SUB_BITS, MAX_SHIFT);
+        uint64_t sub = std::min<uint64_t>(v >> shift, 2 * SUB_COUNT - 1) - SUB_COUNT;
+        return static_cast<size_t>(SUB_COUNT * (shift + 1) + sub);
+    }
+
+    static uint64_t lower_bound(size_t idx) {
+        if (idx < SUB_COUNT) return idx;
+        size_t shift = idx / SUB_COUNT - 1;
+        return (SUB_COUNT + idx % SUB_COUNT) << shift;
+    }
+
+    static uint64_t upper_bound(size_t idx) {
+        if (idx < SUB_COUNT) return idx;
+        size_t shift = idx / SUB_COUNT - 1;
+        return ((SUB_COUNT + idx % SUB_COUNT + 1) << shift) - 1;
+    }
+};
+
+} // namespace utils
@@ -0,0 +1,41 @@
+#pragma once
+#include "core/bar.h"
+#include <nlohmann/json.hpp>
+#include <chrono>
+#include <ctime>
+#include <string>
+
+namespace trading {
+
+/**
+ * Parse one NDJSON bar line from the live websocket bridge
+ *
+ * Expects {"symbol", "timestamp_ms", "open", "high", "low", "close", "volume"};
+ * optional Alpaca fields (vwap, trade_count) are ignored. bar_id is the minute
+ * of the session in local (ET) time, 9:30 = 1 - the key the snapshot assembler
+ * synchronizes on.
+ *
+ * @throws nlohmann::json::exception on malformed lines or missing fields
+ */
+inline void parse_live_bar(const std::string& line, Bar& bar) {
+    nlohmann::json bar_json = nlohmann::json::parse(line);
+
+    bar.symbol = bar_json["symbol"].get<std::string>();
+    int64_t timestamp_ms = bar_json["timestamp_ms"];
+    bar.timestamp = std::chrono::system_clock::time_point(
+        std::chrono::milliseconds(timestamp_ms));
+    bar.open = bar_json["open"];
+    bar.high = bar_json["high"];
+    bar.low = bar_json["low"];
+    bar.close = bar_json["close"];
+    bar.volume = bar_json["volume"];
+
+    // Minutes since midnight ET; market opens at 9:30 (570 minutes) = bar 1
+    time_t time = static_cast<time_t>(timestamp_ms / 1000);
+    struct tm tm_info;
+    localtime_r(&time, &tm_info);
+    int minutes_since_midnight = tm_info.tm_hour * 60 + tm_info.tm_min;
+    bar.bar_id = minutes_since_midnight - 569;
+}
+
+} // namespace trading
@@ -0,0 +1,126 @@
+#pragma once
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace utils {
+
+/**
+ * Node Pool - Free lists of fixed-size blocks for node-based containers
+ *
+ * Blocks are carved from chunks that are only released when the pool is
+ * destroyed, so a map that keeps inserting and erasing keys reuses the same
+ * memory instead of going back to the heap. One pool can serve several
+ * containers; each node size gets its own free list.
+ * Not thread-safe: a pool belongs to one owner (e.g. one trader).
+ */
+class NodePool {
+public:
+    static constexpr size_t ALIGN = alignof(std::max_align_t);
+    static constexpr size_t MAX_BLOCK = 256;          // Larger requests go to operator new
+    static constexpr size_t BLOCKS_PER_CHUNK = 16;
+
+    NodePool() = default;
+    NodePool(const NodePool&) = delete;
+    NodePool& operator=(const NodePool&) = delete;
+
+    ~NodePool() {
+        for (void* chunk : chunks_) ::operator delete(chunk);
+    }
+
+    static bool pooled(size_t bytes) { return bytes <= MAX_BLOCK; }
+
+    void* allocate(size_t bytes) {
+        if (!pooled(bytes)) return ::operator new(bytes);
+        size_t cls = size_class(bytes);
+        if (!free_[cls]) grow(cls);
+        FreeBlock* block = free_[cls];
+        free_[cls] = block->next;
+        return block;
+    }
+
+    void deallocate(void* p, size_t bytes) {
+        if (!pooled(bytes)) {
+            ::operator delete(p);
+            return;
+        }
+        size_t cls = size_class(bytes);
+        auto* block = static_cast<FreeBlock*>(p);
+        block->next = free_[cls];
+        free_[cls] = block;
+    }
+
+private:
+    struct FreeBlock { FreeBlock* next; };
+    static constexpr size_t NUM_CLASSES = MAX_BLOCK / ALIGN;
+
+    FreeBlock* free_[NUM_CLASSES] = {};
+    std::vector<void*> chunks_;
+
+    static size_t size_class(size_t bytes) { return bytes ? (bytes - 1) / ALIGN : 0; }
+
+    void grow(size_t cls) {
+        size_t block_size = (cls + 1) * ALIGN;
+        char* chunk = static_cast<char*>(::operator new(block_size * BLOCKS_PER_CHUNK));
+        chunks_.push_back(chunk);
+        for (size_t i = 0; i < BLOCKS_PER_CHUNK; ++i) {
+            auto* block = reinterpret_cast<FreeBlock*>(chunk + i * block_size);
+            block->next = free_[cls];
+            free_[cls] = block;
+        }
+    }
+};
+
+/**
+ * Pool Allocator - Standard allocator backed by a NodePool
+ *
+ * Single-object allocations (container nodes) come from the pool; arrays
+ * (e.g. hash bucket tables) go to operator new. The allocator stays with its
+ * container on copy/move assignment, so copied nodes land in the destination
+ * container's pool.
+ *
+ * Usage:
+ *   utils::NodePool pool;
+ *   std::unordered_map<K, V, std::hash<K>, std::equal_to<K>,
+ *                      utils::PoolAllocator<std::pair<const K, V>>> map(
+ *       utils::PoolAllocator<std::pair<const K, V>>(&pool));
+ */
+template <typename T>
+class PoolAllocator {
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::false_type;
+    using propagate_on_container_move_assignment = std::false_type;
+    using propagate_on_container_swap = std::false_type;
+
+    explicit PoolAllocator(NodePool* pool) noexcept : pool_(pool) {}
+
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U>& other) noexcept : pool_(other.pool()) {}
+
+    T* allocate(size_t n) {
+        if (n == 1) return static_cast<T*>(pool_->allocate(sizeof(T)));
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, size_t n) noexcept {
+        if (n == 1) {
+            pool_->deallocate(p, sizeof(T));
+        } else {
+            ::operator delete(p);
+        }
+    }
+
+    NodePool* pool() const noexcept { return pool_; }
+
+    template <typename U>
+    bool operator==(const PoolAllocator<U>& other) const noexcept { return pool_ == other.pool(); }
+    template <typename U>
+    bool operator!=(const PoolAllocator<U>& other) const noexcept { return pool_ != other.pool(); }
+
+private:
+    NodePool* pool_;
+};
+
+} // namespace utils
@@ -58,7 +58,8 @@ public:
         file << "    \"avg_win\": " << results.avg_win << ",\n";
         file << "    \"avg_loss\": " << results.avg_loss << ",\n";
         file << "    \"profit_factor\": " << results.profit_factor << ",\n";
-        file << "    \"max_drawdown\": " << results.max_drawdown << "\n";
+        file << "    \"max_drawdown\": " << results.max_drawdown << ",\n";
+        file << "    \"sharpe_ratio\": " << results.sharpe_ratio << "\n";
         file << "  },\n";
 
         file << "  \"config\": {\n";
@@ -96,11 +97,34 @@ public:
         }
         file << "  },\n";
 
+        // ===== STAGE LATENCY (per-stage on_bar timing, microseconds) =====
+        const StageProfiler& profile = trader.stage_profile();
+        if (!profile.empty()) {
+            auto write_stage = [&](const char* name, const utils::LatencyHistogram& h, bool last) {
+                file << "    \"" << name << "\": {"
+                     << "\"count\":" << h.count() << ","
+                     << "\"mean_us\":" << h.mean() / 1000.0 << ","
+                     << "\"p50_us\":" << h.percentile(0.50) / 1000.0 << ","
+                     << "\"p90_us\":" << h.percentile(0.90) / 1000.0 << ","
+                     << "\"p99_us\":" << h.percentile(0.99) / 1000.0 << ","
+                     << "\"max_us\":" << h.max() / 1000.0 << "}"
+                     << (last ? "\n" : ",\n");
+            };
+            file << "  \"stage_latency\": {\n";
+            for (size_t i = 0; i < StageProfiler::NUM_STAGES; ++i) {
+                auto stage = static_cast<BarStage>(i);
+                write_stage(bar_stage_name(stage), profile.stage(stage), false);
+            }
+            write_stage("total", profile.total(), true);
+            file << "  },\n";
+        }
+
         // ===== TRADES (embed complete trade log) =====
         file << "  \"trades\": [\n";
-        const auto all_trades = trader.get_all_trades();
-        for (size_t i = 0; i < all_trades.size(); ++i) {
-            const auto& t = all_trades[i];
+        bool first_trade = true;
+        for (const auto& t : trader.trade_journal()) {
+            if (!first_trade) file << ",\n";
+            first_trade = false;
             auto entry_ms = std::chrono::duration_cast<std::chrono::milliseconds>(t.entry_time.time_since_epoch()).count();
             auto exit_ms = std::chrono::duration_cast<std::chrono::milliseconds>(t.exit_time.time_since_epoch()).count();
             file << "    {"
@@ -114,9 +138,8 @@ public:
             file << "\"shares\":" << t.shares << ",";
             file << "\"pnl\":" << t.pnl << ",";
             file << "\"pnl_pct\":" << t.pnl_pct << "}";
-            if (i + 1 < all_trades.size()) file << ",";
-            file << "\n";
         }
+        if (!first_trade) file << "\n";
         file << "  ],\n";
 
         // ===== PRICE DATA (embed per-symbol OHLCV for filtered window) =====
@@ -151,6 +174,62 @@ public:
         file.close();
     }
 
+    /**
+     * Export every trade as an ENTRY and an EXIT line (JSONL, exit order)
+     * @throws runtime_error if the file cannot be created
+     */
+    static void export_trades_jsonl(const MultiSymbolTrader& trader, const std::string& filename) {
+        std::ofstream file(filename);
+        if (!file.is_open()) {
+            throw std::runtime_error("Cannot open trades file: " + filename);
+        }
+
+        // Export each trade as ENTRY and EXIT (streamed from the journal in exit order)
+        for (const auto& trade : trader.trade_journal()) {
+            // Entry trade
+            auto entry_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                trade.entry_time.time_since_epoch()).count();
+            auto exit_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                trade.exit_time.time_since_epoch()).count();
+
+            double bars_held = (exit_ms - entry_ms) / 60000.0; // Assuming 1-minute bars
+            double entry_value = trade.shares * trade.entry_price;
+            double exit_value = trade.shares * trade.exit_price;
+
+            // ENTRY record
+            file << "{"
+                 << "\"symbol\":\"" << trade.symbol << "\","
+                 << "\"action\":\"ENTRY\","
+                 << "\"timestamp_ms\":" << entry_ms << ","
+                 << "\"bar_id\":" << trade.entry_bar_id << ","
+                 << "\"price\":" << trade.entry_price << ","
+                 << "\"shares\":" << trade.shares << ","
+                 << "\"value\":" << entry_value << ","
+                 << "\"pnl\":0,"
+                 << "\"pnl_pct\":0,"
+                 << "\"bars_held\":0,"
+                 << "\"reason\":\"Rotation\""
+                 << "}\n";
+
+            // EXIT record
+            file << "{"
+                 << "\"symbol\":\"" << trade.symbol << "\","
+                 << "\"action\":\"EXIT\","
+                 << "\"timestamp_ms\":" << exit_ms << ","
+                 << "\"bar_id\":" << trade.exit_bar_id << ","
+                 << "\"price\":" << trade.exit_price << ","
+                 << "\"shares\":" << trade.shares << ","
+                 << "\"value\":" << exit_value << ","
+                 << "\"pnl\":" << trade.pnl << ","
+                 << "\"pnl_pct\":" << (trade.pnl_pct * 100) << ","
+                 << "\"bars_held\":" << static_cast<int>(bars_held) << ","
+                 << "\"reason\":\"Rotation\""
+                 << "}\n";
+        }
+
+        file.close();
+    }
+
 private:
     static std::string get_current_timestamp() {
         auto now = std::chrono::system_clock::now();
@@ -0,0 +1,129 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <chrono>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace trading {
+
+/**
+ * SPSC Queue - Bounded lock-free single-producer/single-consumer ring
+ *
+ * Connects two pipeline stages without locks or per-message allocation:
+ * - All slots are preallocated at construction (capacity rounded up to a power of 2)
+ * - try_push()/try_pop() never block; callers choose to spin, back off or drop
+ * - Head and tail live on separate cache lines to avoid false sharing
+ *
+ * Exactly one thread may call try_push() and exactly one thread may call
+ * try_pop(). Slots are move-assigned, so element types that own buffers
+ * (e.g. std::string) keep reusing capacity once warmed up.
+ *
+ * Usage:
+ *   SpscQueue<Event> queue(1024);
+ *   // producer                       // consumer
+ *   queue.try_push(std::move(ev));    Event ev; if (queue.try_pop(ev)) { ... }
+ */
+template<typename T>
+class SpscQueue {
+public:
+    explicit SpscQueue(size_t capacity)
+        : slots_(round_up_pow2(capacity)),
+          mask_(slots_.size() - 1) {}
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    /**
+     * Enqueue (producer thread only)
+     * @return false if the queue is full (item is left untouched)
+     */
+    bool try_push(T&& item) {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - head_cache_ > mask_) {
+            head_cache_ = head_.load(std::memory_order_acquire);
+            if (tail - head_cache_ > mask_) return false;
+        }
+        slots_[tail & mask_] = std::move(item);
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Dequeue (consumer thread only)
+     * @return false if the queue is empty
+     */
+    bool try_pop(T& out) {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tail_cache_) {
+            tail_cache_ = tail_.load(std::memory_order_acquire);
+            if (head == tail_cache_) return false;
+        }
+        out = std::move(slots_[head & mask_]);
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Approximate number of queued items (exact when called from either end while the other is idle)
+     *
+     * Safe from any thread: head_ is loaded before tail_, and both only grow,
+     * so the difference never goes negative. Items pushed between the two
+     * loads can make it overshoot, so it is capped at capacity().
+     */
+    size_t size_approx() const {
+        const size_t head = head_.load(std::memory_order_acquire);
+        const size_t tail = tail_.load(std::memory_order_acquire);
+        return std::min(tail - head, slots_.size());
+    }
+
+    bool empty_approx() const { return size_approx() == 0; }
+    size_t capacity() const { return slots_.size(); }
+
+private:
+    static constexpr size_t kCacheLine = 64;
+
+    static size_t round_up_pow2(size_t n) {
+        if (n < 2) n = 2;
+        size_t p = 1;
+        while (p < n) p <<= 1;
+        return p;
+    }
+
+    std::vector<T> slots_;
+    const size_t mask_;
+
+    alignas(kCacheLine) std::atomic<size_t> head_{0};   // Next slot to pop (consumer-owned)
+    size_t tail_cache_ = 0;                             // Consumer's view of tail_
+    alignas(kCacheLine) std::atomic<size_t> tail_{0};   // Next slot to fill (producer-owned)
+    size_t head_cache_ = 0;                             // Producer's view of head_
+};
+
+/**
+ * Idle backoff for pipeline consumers polling an SpscQueue
+ * Spins briefly, then yields, then sleeps in short naps so an idle stage costs
+ * almost no CPU while a busy one reacts within microseconds. Call reset()
+ * after each successful pop.
+ */
+class SpinBackoff {
+public:
+    void idle() {
+        if (spins_ < 64) {
+            spins_++;
+        } else if (spins_ < 128) {
+            spins_++;
+            std::this_thread::yield();
+        } else {
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+    }
+
+    void reset() { spins_ = 0; }
+
+private:
+    int spins_ = 0;
+};
+
+} // namespace trading
@@ -0,0 +1,40 @@
+#pragma once
+#include <string>
+#include <thread>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace utils {
+
+/**
+ * Pin the calling thread to a single CPU core
+ * @param core Core index; negative means "don't pin"
+ * @return true if pinned (always false on non-Linux builds)
+ */
+inline bool pin_current_thread(int core) {
+    if (core < 0) return false;
+#ifdef __linux__
+    if (core >= static_cast<int>(std::thread::hardware_concurrency())) return false;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(core, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    return false;
+#endif
+}
+
+/**
+ * Name the calling thread (visible in top -H, gdb, perf); truncated to 15 chars
+ */
+inline void set_current_thread_name(const std::string& name) {
+#ifdef __linux__
+    pthread_setname_np(pthread_self(), name.substr(0, 15).c_str());
+#else
+    (void)name;
+#endif
+}
+
+} // namespace utils
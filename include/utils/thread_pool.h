@@ -0,0 +1,105 @@
+#pragma once
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace utils {
+
+/**
+ * Thread Pool - Fixed set of workers draining a FIFO task queue
+ *
+ * Used by batch evaluation modes (sweep, serve, walk-forward) to spread
+ * independent backtests across cores.
+ *
+ * Usage:
+ *   utils::ThreadPool pool(utils::ThreadPool::default_threads());
+ *   for (auto& job : jobs) pool.submit([&job] { job.run(); });
+ *   pool.wait_idle();
+ */
+class ThreadPool {
+public:
+    explicit ThreadPool(size_t num_threads) {
+        num_threads = std::max<size_t>(1, num_threads);
+        workers_.reserve(num_threads);
+        for (size_t i = 0; i < num_threads; ++i) {
+            workers_.emplace_back([this] { worker_loop(); });
+        }
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        task_cv_.notify_all();
+        for (auto& w : workers_) w.join();
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * Queue a task (tasks must not throw; wrap and record errors yourself)
+     */
+    void submit(std::function<void()> task) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            tasks_.push_back(std::move(task));
+            pending_++;
+        }
+        task_cv_.notify_one();
+    }
+
+    /**
+     * Block until every submitted task has finished
+     */
+    void wait_idle() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        idle_cv_.wait(lock, [this] { return pending_ == 0; });
+    }
+
+    size_t size() const { return workers_.size(); }
+
+    /**
+     * Hardware concurrency, or 1 if unknown
+     */
+    static size_t default_threads() {
+        return std::max(1u, std::thread::hardware_concurrency());
+    }
+
+private:
+    void worker_loop() {
+        while (true) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                task_cv_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+                if (tasks_.empty()) return;  // stopping_ and drained
+                task = std::move(tasks_.front());
+                tasks_.pop_front();
+            }
+
+            task();
+
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (--pending_ == 0) idle_cv_.notify_all();
+            }
+        }
+    }
+
+    std::vector<std::thread> workers_;
+    std::deque<std::function<void()>> tasks_;
+    std::mutex mutex_;
+    std::condition_variable task_cv_;
+    std::condition_variable idle_cv_;
+    size_t pending_ = 0;
+    bool stopping_ = false;
+};
+
+} // namespace utils
@@ -5,7 +5,7 @@ Alpaca Order Client for C++ Trading System
 Listens on a FIFO pipe for order commands from C++ and submits them to Alpaca.
 Provides feedback on order status via a response FIFO.
 
-Order Format (JSON):
+Order Format (JSON, one per line):
 {
     "action": "BUY" | "SELL",
     "symbol": "TQQQ",
@@ -13,6 +13,9 @@ Order Format (JSON):
     "order_id": "unique_id"  // For tracking
 }
 
+Batch Format (JSON, one per line; sentio_lite --order-gateway json):
+{"batch_id": 7, "bar_id": 42, "orders": [<order>, ...]}   // exits first
+
 Response Format (JSON):
 {
     "order_id": "unique_id",
@@ -20,13 +23,26 @@ Response Format (JSON):
     "filled_price": 45.23,
     "message": "Order filled successfully"
 }
+
+With --format binary (sentio_lite --order-gateway binary) batches and
+responses use the fixed little-endian layout of include/trading/order_gateway.h:
+    batch    = header <IHHQQ (24 bytes) + count x record <8sQiId (32 bytes)
+    response = <IB3xQiId (32 bytes)
+
+--dry-run fills every order at its reference price without calling Alpaca.
+
+--instance NAME serves the extra trader started with sentio_lite
+--instance NAME=DIR: FIFOs /tmp/alpaca_{orders,responses}_NAME.fifo and
+credentials ALPACA_PAPER_API_KEY_NAME / ALPACA_PAPER_SECRET_KEY_NAME
+(NAME upper-cased), so each instance can trade its own paper account.
 """
 
 import os
 import sys
 import json
 import signal
-import requests
+import struct
+import argparse
 from datetime import datetime
 
 # FIFO pipes for C++ communication
@@ -36,6 +52,14 @@ RESPONSE_FIFO = "/tmp/alpaca_responses.fifo"  # We write responses here
 # Alpaca Paper Trading API
 BASE_URL = "https://paper-api.alpaca.markets"
 
+# Binary wire format (must match include/trading/order_gateway.h)
+BATCH_MAGIC = 0x31424F53      # "SOB1"
+RESPONSE_MAGIC = 0x31524F53   # "SOR1"
+BATCH_HEADER = struct.Struct("<IHHQQ")
+ORDER_RECORD = struct.Struct("<8sQiId")
+ORDER_RESPONSE = struct.Struct("<IB3xQiId")
+STATUS_CODES = {"filled": 2, "pending": 3, "rejected": 4}
+
 # Track connection
 running = True
 orders_processed = 0
@@ -71,6 +95,8 @@ def submit_order(api_key, secret_key, order_data):
     Returns:
         dict: Response with status, filled_price, etc.
     """
+    import requests
+
     headers = {
         "APCA-API-KEY-ID": api_key,
         "APCA-API-SECRET-KEY": secret_key,
@@ -153,9 +179,89 @@ def submit_order(api_key, secret_key, order_data):
         }
 
 
+def read_orders_json(order_fifo):
+    """Yield order dicts from NDJSON lines (single orders or batches)"""
+    for line in order_fifo:
+        if not line.strip():
+            continue
+        try:
+            data = json.loads(line)
+        except json.JSONDecodeError as e:
+            print(f"[ORDER CLIENT] ❌ Invalid JSON: {e}")
+            continue
+        if "orders" in data:
+            yield from data["orders"]
+        else:
+            yield data
+
+
+def read_orders_binary(order_fifo):
+    """Yield order dicts from binary batches"""
+    while True:
+        header = order_fifo.read(BATCH_HEADER.size)
+        if len(header) < BATCH_HEADER.size:
+            return
+        magic, _version, count, _batch_id, _bar_id = BATCH_HEADER.unpack(header)
+        if magic != BATCH_MAGIC:
+            print("[ORDER CLIENT] ❌ Bad batch magic, dropping stream")
+            return
+        for _ in range(count):
+            record = order_fifo.read(ORDER_RECORD.size)
+            if len(record) < ORDER_RECORD.size:
+                return
+            symbol, order_id, qty, _reserved, ref_price = ORDER_RECORD.unpack(record)
+            yield {
+                "action": "BUY" if qty > 0 else "SELL",
+                "symbol": symbol.rstrip(b"\0").decode(),
+                "shares": abs(qty),
+                "order_id": order_id,
+                "ref_price": ref_price,
+            }
+
+
+def dry_run_fill(order_data):
+    """Fill at the reference price (no broker)"""
+    return {
+        "order_id": order_data.get("order_id", "unknown"),
+        "status": "filled",
+        "filled_price": float(order_data.get("ref_price", 0.0)),
+        "message": f"{order_data['action']} {order_data['shares']} {order_data['symbol']} - dry run"
+    }
+
+
+def send_response(response, fmt, shares):
+    """Write one response to the response FIFO"""
+    if fmt == "binary":
+        payload = ORDER_RESPONSE.pack(RESPONSE_MAGIC, STATUS_CODES.get(response["status"], 3),
+                                      int(response["order_id"]), shares if response["status"] == "filled" else 0,
+                                      0, float(response["filled_price"]))
+        with open(RESPONSE_FIFO, 'wb') as response_fifo:
+            response_fifo.write(payload)
+    else:
+        with open(RESPONSE_FIFO, 'w') as response_fifo:
+            json.dump(response, response_fifo)
+            response_fifo.write('\n')
+            response_fifo.flush()
+
+
 def main():
     """Main order processing loop"""
-    global running, orders_processed
+    global running, orders_processed, ORDER_FIFO, RESPONSE_FIFO
+
+    parser = argparse.ArgumentParser(description="Alpaca order client for sentio_lite")
+    parser.add_argument("--format", choices=["json", "binary"], default="json",
+                        help="Order/response wire format (match sentio_lite --order-gateway)")
+    parser.add_argument("--dry-run", action="store_true",
+                        help="Fill orders at their reference price without calling Alpaca")
+    parser.add_argument("--instance", metavar="NAME",
+                        help="Serve sentio_lite --instance NAME (its own FIFOs and credentials)")
+    args = parser.parse_args()
+
+    key_suffix = ""
+    if args.instance:
+        ORDER_FIFO = f"/tmp/alpaca_orders_{args.instance}.fifo"
+        RESPONSE_FIFO = f"/tmp/alpaca_responses_{args.instance}.fifo"
+        key_suffix = "_" + args.instance.upper().replace("-", "_")
 
     # Set up signal handler
     signal.signal(signal.SIGINT, signal_handler)
@@ -166,15 +272,19 @@ def main():
     print("=" * 70)
 
     # Get credentials from environment
-    api_key = os.getenv('ALPACA_PAPER_API_KEY')
-    api_secret = os.getenv('ALPACA_PAPER_SECRET_KEY')
-
-    if not api_key or not api_secret:
-        print("[ORDER CLIENT] ❌ ERROR: ALPACA_PAPER_API_KEY and ALPACA_PAPER_SECRET_KEY must be set")
+    api_key = os.getenv('ALPACA_PAPER_API_KEY' + key_suffix)
+    api_secret = os.getenv('ALPACA_PAPER_SECRET_KEY' + key_suffix)
+
+    if args.dry_run:
+        print("[ORDER CLIENT] Dry run: orders fill at their reference price")
+    elif not api_key or not api_secret:
+        print(f"[ORDER CLIENT] ❌ ERROR: ALPACA_PAPER_API_KEY{key_suffix} and "
+              f"ALPACA_PAPER_SECRET_KEY{key_suffix} must be set")
         sys.exit(1)
-
-    print(f"[ORDER CLIENT] API Key: {api_key[:8]}...")
-    print(f"[ORDER CLIENT] Using Alpaca Paper Trading")
+    else:
+        print(f"[ORDER CLIENT] API Key: {api_key[:8]}...")
+        print(f"[ORDER CLIENT] Using Alpaca Paper Trading")
+    print(f"[ORDER CLIENT] Wire format: {args.format}")
     print()
 
     # Create FIFO pipes
@@ -191,21 +301,20 @@ def main():
     try:
         while running:
             # Open FIFO for reading (blocks until C++ writes)
-            with open(ORDER_FIFO, 'r') as order_fifo:
-                for line in order_fifo:
-                    if not line.strip():
-                        continue
-
+            mode = 'rb' if args.format == "binary" else 'r'
+            with open(ORDER_FIFO, mode) as order_fifo:
+                reader = read_orders_binary if args.format == "binary" else read_orders_json
+                for order_data in reader(order_fifo):
                     try:
-                        # Parse order from C++
-                        order_data = json.loads(line)
-
                         timestamp = datetime.now().strftime('%H:%M:%S')
                         print(f"[ORDER CLIENT] {timestamp} | Received: {order_data['action']} "
                               f"{order_data['shares']} {order_data['symbol']}")
 
                         # Submit to Alpaca
-                        response = submit_order(api_key, api_secret, order_data)
+                        if args.dry_run:
+                            response = dry_run_fill(order_data)
+                        else:
+                            response = submit_order(api_key, api_secret, order_data)
 
                         # Log result
                         status_symbol = "✓" if response["status"] == "filled" else "⚠"
@@ -215,16 +324,11 @@ def main():
                             print(f"[ORDER CLIENT] {timestamp} | Fill Price: ${response['filled_price']:.2f}")
 
                         # Send response back to C++
-                        with open(RESPONSE_FIFO, 'w') as response_fifo:
-                            json.dump(response, response_fifo)
-                            response_fifo.write('\n')
-                            response_fifo.flush()
+                        send_response(response, args.format, int(order_data["shares"]))
 
                         orders_processed += 1
                         print()
 
-                    except json.JSONDecodeError as e:
-                        print(f"[ORDER CLIENT] ❌ Invalid JSON: {e}")
                     except Exception as e:
                         print(f"[ORDER CLIENT] ❌ Error processing order: {e}")
 
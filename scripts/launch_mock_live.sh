@@ -41,7 +41,7 @@ BRIDGE_PID=$!
 echo "Replay bridge PID: $BRIDGE_PID"
 
 # Start live trader (consumes FIFO exactly like real live)
-./build/sentio_lite mock-live --date "${DATE:-2000-01-01}" || true
+./build/sentio_lite mock-live --feed fifo --date "${DATE:-2000-01-01}" || true
 
 # Build dashboard from exported results and optionally email it
 if [[ -f results.json ]]; then
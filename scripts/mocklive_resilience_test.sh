@@ -76,7 +76,7 @@ stop_replayer() {
 start_engine() {
   local logf="$1"
   log "Starting engine → $logf"
-  ./build/sentio_lite mock-live --date 2000-01-01 > "$logf" 2>&1 &
+  ./build/sentio_lite mock-live --feed fifo --date 2000-01-01 > "$logf" 2>&1 &
   echo $! > /tmp/engine_pid
 }
 
@@ -1,11 +1,19 @@
 #include "trading/multi_symbol_trader.h"
+#include "trading/live_pipeline.h"
+#include "trading/backtest_runner.h"
+#include "trading/param_registry.h"
+#include "trading/optimizer.h"
+#include "trading/median_pruner.h"
+#include "trading/result_cache.h"
 #include "trading/trading_mode.h"
 #include "trading/trading_strategy.h"
 #include "utils/data_loader.h"
 #include "utils/date_filter.h"
+#include "utils/fd_line_reader.h"
 #include "utils/results_exporter.h"
 #include "utils/config_reader.h"
 #include "utils/config_loader.h"
+#include "utils/thread_pool.h"
 #include <nlohmann/json.hpp>
 #include <iostream>
 #include <iomanip>
@@ -16,13 +24,22 @@
 #include <sstream>
 #include <cstdlib>
 #include <algorithm>
+#include <cctype>
 #include <filesystem>
 #include <set>
-#include <deque>
-#ifdef ENABLE_ZMQ
-#include <zmq.h>
-#include <zmq.hpp>
-#endif
+#include <limits>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
 
 using namespace trading;
 
@@ -67,8 +84,58 @@ struct Config {
     std::string config_dir = "config";
 
     // Live feed selection
-    std::string feed = "fifo";           // fifo | zmq
+    std::string feed;                    // fifo | zmq | replay (default: fifo live, replay mock-live)
+    double replay_speed = 0.0;           // Replay feed: N× market speed (0 = as fast as possible)
     std::string zmq_url = "tcp://127.0.0.1:5555";
+    int snapshot_deadline_ms = 5000;     // Max wait for all symbols before releasing a minute
+    double latency_budget_ms = 50.0;     // Flag minutes whose bar-read → decision latency exceeds this
+    std::string metrics_file = "logs/live/metrics.prom";  // Prometheus text, rewritten atomically
+    int metrics_interval_ms = 1000;      // Metrics file rewrite period (0 = off)
+    std::string order_gateway = "off";   // off | json | binary: send order batches to the broker FIFO
+    bool hot_reload = true;              // Watch config_dir and swap in new parameters between bars
+    std::string state_dir = "logs/live/state";  // Checkpoint + write-ahead log (empty = off)
+    int checkpoint_interval = 30;        // Minutes between full checkpoints
+    bool resume = false;                 // Rebuild the trader from state_dir instead of warming up
+    std::vector<std::pair<std::string, std::string>> instances;  // Extra live traders: (name, config dir)
+
+    // Batch evaluation (sweep mode)
+    std::string params_file;             // JSONL: one parameter set per line
+    std::string output_file;             // Batch results (default depends on mode)
+    int threads = 0;                     // Worker threads (0 = all cores)
+    bool prune = false;                  // Median-prune configs from intermediate returns
+    int prune_startup = 5;               // Completed configs before pruning starts
+    int prune_interval = 60;             // Trading bars between intermediate reports
+    int prune_warmup = 0;                // Checks before pruning may stop a config
+
+    // Multi-day walk-forward (walkforward mode)
+    std::string start_date;              // YYYY-MM-DD, inclusive
+    std::string end_date;                // YYYY-MM-DD, inclusive
+
+    // Native parameter search (optimize mode; --end-date shared with walkforward)
+    std::string algorithm = "cmaes";     // cmaes | de
+    int trials = 200;                    // Total evaluations (rounded up to whole generations)
+    int population = 0;                  // Candidates per generation (0 = algorithm default)
+    uint64_t seed = 42;
+    int train_days = 5;                  // Most recent days: fitness
+    int val_days = 10;                   // Days before them: overfitting check (0 = off)
+    double overfit_threshold = 0.20;     // Max train→validation MRD degradation
+    std::string space_file;              // JSON {"name": [lo, hi]} (default: SIGOR weights + windows)
+
+    // Parameter sensitivity (sensitivity mode; dates shared with mock/walkforward)
+    double delta = 0.10;                 // Relative perturbation per step
+    int steps = 1;                       // Perturb by ±1..steps × delta
+
+    // Backtest result cache (sweep, walkforward, optimize, serve)
+    bool use_cache = true;
+    std::string cache_dir = "data/cache/backtests";
+
+    // Persistent evaluation server (serve mode)
+    std::string serve_socket;            // Unix socket path (empty = stdin/stdout)
+
+    // Live pipeline core pinning (-1 = let the OS schedule)
+    int pin_ingest_core = -1;
+    int pin_decision_core = -1;
+    int pin_report_core = -1;
 
     // Trading parameters
     TradingConfig trading;
@@ -77,12 +144,19 @@ struct Config {
 void print_usage(const char* program_name) {
     std::cout << "Sentio Lite - SIGOR Intraday Trading\n\n"
               << "Philosophy: Rule-based intraday ensemble with live/replay support\n\n"
-              << "Usage: " << program_name << " mock --date MM-DD [options]\n\n"
+              << "Usage: " << program_name << " mock --date MM-DD [options]\n"
+              << "       " << program_name << " mock-live [--date MM-DD] [--replay-speed N] [options]\n"
+              << "       " << program_name << " sweep --date MM-DD --params FILE [options]\n"
+              << "       " << program_name << " walkforward --start-date MM-DD --end-date MM-DD [options]\n"
+              << "       " << program_name << " optimize [--end-date MM-DD] [--algo cmaes|de] [options]\n"
+              << "       " << program_name << " sensitivity [--date MM-DD | --start-date MM-DD --end-date MM-DD] [options]\n"
+              << "       " << program_name << " serve [--date MM-DD] [--socket PATH] [options]\n\n"
               << "Required Options:\n"
               << "  --date MM-DD         Test date (year is fixed to 2025)\n\n"
               << "Common Options:\n"
               << "  (SIGOR-only build)\n"
-              << "  --warmup-bars N      Warmup bars (default: 100, from previous day)\n"
+              << "  --warmup-bars N      Warmup bars (default: 100, from previous day; live:\n"
+              << "                       the last N minutes of --data-dir)\n"
               << "  --intraday-warmup    Use first N bars of TEST DAY as warmup (not prev day)\n"
               << "                       Example: --warmup-bars 50 --intraday-warmup\n"
               << "                       → Warmup on bars 1-50, trade on bars 51-391\n"
@@ -92,8 +166,81 @@ void print_usage(const char* program_name) {
               << "  --data-dir DIR       Data directory (default: data)\n"
               << "  --extension EXT      File extension: .bin or .csv (default: .bin)\n\n"
               << "Live Feed Options:\n"
-              << "  --feed {fifo,zmq}    Live input: named pipe (default) or ZeroMQ SUB\n"
-              << "  --zmq-url URL        ZMQ endpoint (default: tcp://127.0.0.1:5555)\n\n"
+              << "  --feed {fifo,zmq,replay}\n"
+              << "                       Live input: named pipe (live default), ZeroMQ SUB, or\n"
+              << "                       in-process replay of --date from --data-dir (mock-live default)\n"
+              << "  --replay-speed N     Replay at N× market speed; 0 = as fast as possible (default: 0)\n"
+              << "  --zmq-url URL        ZMQ endpoint (default: tcp://127.0.0.1:5555)\n"
+              << "  --snapshot-deadline-ms N\n"
+              << "                       Release a minute after N ms even if some symbols\n"
+              << "                       have not reported (default: 5000)\n"
+              << "  --latency-budget-ms N\n"
+              << "                       Flag minutes whose bar-read → on_bar-end latency\n"
+              << "                       exceeds N ms (default: 50)\n"
+              << "  --order-gateway {off,json,binary}\n"
+              << "                       Send each minute's orders as one batch to the broker\n"
+              << "                       bridge FIFO in the given wire format (default: off)\n"
+              << "  --metrics-file PATH  Prometheus text metrics, rewritten atomically\n"
+              << "                       (default: logs/live/metrics.prom)\n"
+              << "  --metrics-interval-ms N\n"
+              << "                       Metrics rewrite period; 0 disables (default: 1000)\n"
+              << "  --no-hot-reload      Do not watch --config for parameter changes (by default,\n"
+              << "                       edited params are swapped in between bars)\n"
+              << "  --state-dir DIR      Crash-safe trader state: checkpoint + per-minute log\n"
+              << "                       (default: logs/live/state; \"\" disables)\n"
+              << "  --checkpoint-interval N\n"
+              << "                       Minutes between full checkpoints (default: 30)\n"
+              << "  --resume             Restart mid-session from --state-dir instead of warming up\n"
+              << "  --instance NAME=DIR  Run another trader on the same feed with the params in DIR\n"
+              << "                       (own capital, trade journal, orders file and order FIFOs\n"
+              << "                       /tmp/alpaca_{orders,responses}_NAME.fifo; repeatable)\n"
+              << "  --pin-cores I,D,R    Pin ingest/decision/report threads to CPU cores\n"
+              << "                       (-1 leaves a stage unpinned; default: none)\n\n"
+              << "Sweep Mode Options (load data once, evaluate many configs in parallel):\n"
+              << "  --params FILE        JSONL file, one parameter set per line, e.g.\n"
+              << "                       {\"id\": 7, \"w_rsi\": 1.4, \"max_positions\": 2}\n"
+              << "                       Keys override trading_params.json / sigor_params.json\n"
+              << "  --output FILE        Results JSONL, one row per config (default: sweep_results.jsonl)\n"
+              << "  --threads N          Worker threads (default: all cores)\n"
+              << "  --prune              Stop configs whose running return trails the median of\n"
+              << "                       completed configs at the same point (row gets \"pruned\")\n"
+              << "  --prune-startup N    Completed configs before pruning starts (default: 5)\n"
+              << "  --prune-interval N   Trading bars between checks; day closes always check (default: 60)\n"
+              << "  --prune-warmup N     Checks passed before a config can be pruned (default: 0)\n\n"
+              << "Walk-Forward Mode Options (load data once, test days in parallel):\n"
+              << "  --start-date MM-DD   First test day (inclusive)\n"
+              << "  --end-date MM-DD     Last test day (inclusive)\n"
+              << "  --output FILE        Aggregated JSON report (default: walkforward_results.json)\n"
+              << "  --threads N          Worker threads (default: all cores)\n\n"
+              << "Optimize Mode Options (in-process CMA-ES / differential evolution):\n"
+              << "  --end-date MM-DD     Last training day (default: latest in data)\n"
+              << "  --algo {cmaes,de}    Optimizer (default: cmaes)\n"
+              << "  --trials N           Total evaluations, whole generations (default: 200)\n"
+              << "  --population N       Candidates per generation (default: algorithm's own)\n"
+              << "  --train-days N       Most recent days optimized on (default: 5)\n"
+              << "  --val-days N         Prior days for the overfitting check (default: 10, 0 = off)\n"
+              << "  --overfit-threshold X  Max train→validation MRD degradation (default: 0.20)\n"
+              << "  --space FILE         JSON {\"w_rsi\": [0.1, 2.0], ...} (default: SIGOR weights + windows)\n"
+              << "  --seed N             Random seed (default: 42)\n"
+              << "  --output FILE        JSON report (default: optimize_results.json)\n\n"
+              << "Sensitivity Mode Options (perturb every parameter of --config, one parallel batch):\n"
+              << "  --date MM-DD         Test day (default: latest in data), or a range with\n"
+              << "  --start-date/--end-date  MRD averaged over the days\n"
+              << "  --delta X            Relative step per perturbation (default: 0.10; integers move\n"
+              << "                       by at least 1)\n"
+              << "  --steps N            Variants at ±1..N steps per parameter (default: 1)\n"
+              << "  --output FILE        JSON report (default: sensitivity_results.json)\n\n"
+              << "Serve Mode Options (resident data, NDJSON requests → streamed metrics):\n"
+              << "  --date MM-DD         Default test date for requests (default: latest in data)\n"
+              << "  --socket PATH        Listen on a Unix domain socket (default: stdin/stdout)\n"
+              << "  --threads N          Worker threads (default: all cores)\n"
+              << "                       Request: {\"id\": 7, \"params\": {\"w_rsi\": 1.4}, \"date\": \"10-21\"}\n"
+              << "                       Progress: add \"report_every\": BARS (or \"progress\": true)\n"
+              << "                       Commands: {\"cmd\": \"ping\" | \"params\" | \"shutdown\"},\n"
+              << "                                 {\"cmd\": \"abort\", \"target\": 7}\n\n"
+              << "Batch Mode Options (sweep, walkforward, optimize, sensitivity, serve):\n"
+              << "  --cache-dir DIR      Backtest result cache (default: data/cache/backtests)\n"
+              << "  --no-cache           Always re-run backtests\n\n"
               << "Configuration:\n"
               << "  --config DIR         Config directory containing trading_params.json and sigor_params.json\n"
               << "                       (default: config)\n"
@@ -120,6 +267,16 @@ void print_usage(const char* program_name) {
 }
 
 
+/**
+ * Expand an MM-DD date argument to YYYY-MM-DD (year fixed to 2025, as --date)
+ */
+std::string expand_date_arg(const std::string& date_input) {
+    if (date_input.length() == 5 && date_input[2] == '-') {
+        return "2025-" + date_input;
+    }
+    return date_input;
+}
+
 bool parse_args(int argc, char* argv[], Config& config) {
     if (argc < 2) {
         return false;
@@ -131,8 +288,11 @@ bool parse_args(int argc, char* argv[], Config& config) {
         return false;
     }
 
-    if (mode_arg != "mock" && mode_arg != "live" && mode_arg != "mock-live") {
-        std::cerr << "Error: First argument must be 'mock' or 'live'\n";
+    if (mode_arg != "mock" && mode_arg != "live" && mode_arg != "mock-live" &&
+        mode_arg != "sweep" && mode_arg != "walkforward" && mode_arg != "optimize" &&
+        mode_arg != "sensitivity" && mode_arg != "serve") {
+        std::cerr << "Error: First argument must be 'mock', 'live', 'mock-live', 'sweep', "
+                  << "'walkforward', 'optimize', 'sensitivity' or 'serve'\n";
         return false;
     }
 
@@ -181,13 +341,14 @@ bool parse_args(int argc, char* argv[], Config& config) {
         // Date option (mock mode) - SINGLE DAY ONLY
         // Accept MM-DD format and automatically prepend "2025-"
         else if (arg == "--date" && i + 1 < argc) {
-            std::string date_input = argv[++i];
-            // If input is MM-DD format (5 chars), prepend "2025-"
-            if (date_input.length() == 5 && date_input[2] == '-') {
-                config.test_date = "2025-" + date_input;
-            } else {
-                config.test_date = date_input;  // Accept full format for backwards compatibility
-            }
+            // MM-DD gets "2025-" prepended; full format accepted for backwards compatibility
+            config.test_date = expand_date_arg(argv[++i]);
+        }
+        else if (arg == "--start-date" && i + 1 < argc) {
+            config.start_date = expand_date_arg(argv[++i]);
+        }
+        else if (arg == "--end-date" && i + 1 < argc) {
+            config.end_date = expand_date_arg(argv[++i]);
         }
         // Simulation period removed (SIGOR-only)
         // Warmup period (bars before test day)
@@ -207,9 +368,80 @@ bool parse_args(int argc, char* argv[], Config& config) {
         else if (arg == "--feed" && i + 1 < argc) {
             config.feed = argv[++i];
         }
+        else if (arg == "--replay-speed" && i + 1 < argc) {
+            config.replay_speed = std::stod(argv[++i]);
+        }
         else if (arg == "--zmq-url" && i + 1 < argc) {
             config.zmq_url = argv[++i];
         }
+        else if (arg == "--snapshot-deadline-ms" && i + 1 < argc) {
+            config.snapshot_deadline_ms = std::stoi(argv[++i]);
+        }
+        else if (arg == "--latency-budget-ms" && i + 1 < argc) {
+            config.latency_budget_ms = std::stod(argv[++i]);
+        }
+        else if (arg == "--order-gateway" && i + 1 < argc) {
+            config.order_gateway = argv[++i];
+            if (config.order_gateway != "off" && config.order_gateway != "json" &&
+                config.order_gateway != "binary") {
+                std::cerr << "--order-gateway expects off, json or binary\n";
+                return false;
+            }
+        }
+        else if (arg == "--metrics-file" && i + 1 < argc) {
+            config.metrics_file = argv[++i];
+        }
+        else if (arg == "--metrics-interval-ms" && i + 1 < argc) {
+            config.metrics_interval_ms = std::stoi(argv[++i]);
+        }
+        else if (arg == "--no-hot-reload") {
+            config.hot_reload = false;
+        }
+        else if (arg == "--state-dir" && i + 1 < argc) {
+            config.state_dir = argv[++i];
+        }
+        else if (arg == "--checkpoint-interval" && i + 1 < argc) {
+            config.checkpoint_interval = std::stoi(argv[++i]);
+            if (config.checkpoint_interval < 1) {
+                std::cerr << "--checkpoint-interval must be at least 1\n";
+                return false;
+            }
+        }
+        else if (arg == "--resume") {
+            config.resume = true;
+        }
+        else if (arg == "--instance" && i + 1 < argc) {
+            const std::string spec = argv[++i];
+            const size_t eq = spec.find('=');
+            const std::string name = spec.substr(0, eq);
+            const bool valid_name = !name.empty() && std::all_of(name.begin(), name.end(), [](char c) {
+                return std::isalnum(static_cast<unsigned char>(c)) || c == '_' || c == '-';
+            });
+            if (eq == std::string::npos || eq + 1 == spec.size() || !valid_name) {
+                std::cerr << "--instance expects NAME=CONFIG_DIR (NAME: letters, digits, _ or -)\n";
+                return false;
+            }
+            for (const auto& [existing, _] : config.instances) {
+                if (existing == name) {
+                    std::cerr << "--instance " << name << " given twice\n";
+                    return false;
+                }
+            }
+            config.instances.emplace_back(name, spec.substr(eq + 1));
+        }
+        else if (arg == "--pin-cores" && i + 1 < argc) {
+            std::stringstream ss(argv[++i]);
+            std::string core;
+            std::vector<int> cores;
+            while (std::getline(ss, core, ',')) cores.push_back(std::stoi(core));
+            if (cores.size() != 3) {
+                std::cerr << "--pin-cores expects three comma-separated cores (ingest,decision,report)\n";
+                return false;
+            }
+            config.pin_ingest_core = cores[0];
+            config.pin_decision_core = cores[1];
+            config.pin_report_core = cores[2];
+        }
         // Output options
         else if (arg == "--no-dashboard") {
             config.generate_dashboard = false;
@@ -217,6 +449,71 @@ bool parse_args(int argc, char* argv[], Config& config) {
         else if (arg == "--results-file" && i + 1 < argc) {
             config.results_file = argv[++i];
         }
+        // Sweep options
+        else if (arg == "--params" && i + 1 < argc) {
+            config.params_file = argv[++i];
+        }
+        else if (arg == "--output" && i + 1 < argc) {
+            config.output_file = argv[++i];
+        }
+        else if (arg == "--threads" && i + 1 < argc) {
+            config.threads = std::stoi(argv[++i]);
+        }
+        else if (arg == "--prune") {
+            config.prune = true;
+        }
+        else if (arg == "--prune-startup" && i + 1 < argc) {
+            config.prune_startup = std::stoi(argv[++i]);
+        }
+        else if (arg == "--prune-interval" && i + 1 < argc) {
+            config.prune_interval = std::stoi(argv[++i]);
+        }
+        else if (arg == "--prune-warmup" && i + 1 < argc) {
+            config.prune_warmup = std::stoi(argv[++i]);
+        }
+        // Optimize options
+        else if (arg == "--algo" && i + 1 < argc) {
+            config.algorithm = argv[++i];
+        }
+        else if (arg == "--trials" && i + 1 < argc) {
+            config.trials = std::stoi(argv[++i]);
+        }
+        else if (arg == "--population" && i + 1 < argc) {
+            config.population = std::stoi(argv[++i]);
+        }
+        else if (arg == "--seed" && i + 1 < argc) {
+            config.seed = std::stoull(argv[++i]);
+        }
+        else if (arg == "--train-days" && i + 1 < argc) {
+            config.train_days = std::stoi(argv[++i]);
+        }
+        else if (arg == "--val-days" && i + 1 < argc) {
+            config.val_days = std::stoi(argv[++i]);
+        }
+        else if (arg == "--overfit-threshold" && i + 1 < argc) {
+            config.overfit_threshold = std::stod(argv[++i]);
+        }
+        else if (arg == "--space" && i + 1 < argc) {
+            config.space_file = argv[++i];
+        }
+        // Sensitivity options
+        else if (arg == "--delta" && i + 1 < argc) {
+            config.delta = std::stod(argv[++i]);
+        }
+        else if (arg == "--steps" && i + 1 < argc) {
+            config.steps = std::stoi(argv[++i]);
+        }
+        // Result cache
+        else if (arg == "--cache-dir" && i + 1 < argc) {
+            config.cache_dir = argv[++i];
+        }
+        else if (arg == "--no-cache") {
+            config.use_cache = false;
+        }
+        // Serve options
+        else if (arg == "--socket" && i + 1 < argc) {
+            config.serve_socket = argv[++i];
+        }
         else if (arg == "--verbose") {
             config.verbose = true;
         }
@@ -253,6 +550,11 @@ bool parse_args(int argc, char* argv[], Config& config) {
         return false;
     }
 
+    // Mock-live replays the binary store in-process unless a feed is named
+    if (config.feed.empty()) {
+        config.feed = (config.mode == TradingMode::MOCK_LIVE) ? "replay" : "fifo";
+    }
+
     // Calculate bars
     // Warmup: Use specified bars (default 100), always ends at bar 391
     config.warmup_bars = config.warmup_bars_specified;
@@ -334,9 +636,10 @@ std::vector<std::string> get_trading_days(const std::vector<Bar>& bars) {
         auto duration = bar.timestamp.time_since_epoch();
         auto seconds = std::chrono::duration_cast<std::chrono::seconds>(duration).count();
         time_t time = static_cast<time_t>(seconds);
-        struct tm* timeinfo = gmtime(&time);  // Use GMT/UTC instead of localtime
+        struct tm timeinfo;
+        gmtime_r(&time, &timeinfo);  // Use GMT/UTC instead of localtime (reentrant: serve builds windows concurrently)
         char buffer[11];
-        strftime(buffer, sizeof(buffer), "%Y-%m-%d", timeinfo);
+        strftime(buffer, sizeof(buffer), "%Y-%m-%d", &timeinfo);
         unique_days.insert(buffer);
     }
 
@@ -525,64 +828,983 @@ void filter_to_date(std::unordered_map<Symbol, std::vector<Bar>>& all_data,
     }
 }
 
-void export_trades_jsonl(const MultiSymbolTrader& trader, const std::string& filename) {
-    std::ofstream file(filename);
-    if (!file.is_open()) {
-        throw std::runtime_error("Cannot open trades file: " + filename);
+/**
+ * Slice the bars for one test day (sim + warmup prefix + test day) out of the
+ * full history without copying the rest of it. Selects exactly what
+ * filter_to_date keeps: the last `total_bars` bars at or before the test day's
+ * 4:00 PM close. Read-only, so concurrent tasks can slice one resident dataset.
+ * @throws runtime_error if the date is not a trading day or history is too short
+ */
+std::unordered_map<Symbol, std::vector<Bar>> slice_to_date(
+        const std::unordered_map<Symbol, std::vector<Bar>>& all_data,
+        const std::vector<Symbol>& symbols,
+        const std::string& date_str,
+        size_t total_bars) {
+    int year, month, day;
+    if (sscanf(date_str.c_str(), "%d-%d-%d", &year, &month, &day) != 3) {
+        throw std::runtime_error("Invalid date: " + date_str);
+    }
+
+    struct tm end_timeinfo = {};
+    end_timeinfo.tm_year = year - 1900;
+    end_timeinfo.tm_mon = month - 1;
+    end_timeinfo.tm_mday = day;
+    end_timeinfo.tm_hour = 16;  // 4 PM ET (market close)
+    end_timeinfo.tm_min = 0;
+    end_timeinfo.tm_sec = 0;
+    end_timeinfo.tm_isdst = -1;
+    Timestamp end_timestamp = std::chrono::system_clock::from_time_t(mktime(&end_timeinfo));
+
+    std::unordered_map<Symbol, std::vector<Bar>> sliced;
+    for (const auto& symbol : symbols) {
+        auto it = all_data.find(symbol);
+        if (it == all_data.end()) {
+            throw std::runtime_error("No data loaded for " + symbol);
+        }
+        const auto& bars = it->second;
+
+        auto end = std::upper_bound(bars.begin(), bars.end(), end_timestamp,
+                                    [](const Timestamp& t, const Bar& bar) { return t < bar.timestamp; });
+        size_t available = static_cast<size_t>(end - bars.begin());
+        if (available < total_bars) {
+            throw std::runtime_error(
+                "Insufficient data for " + symbol + ": need " +
+                std::to_string(total_bars) + " bars, have " + std::to_string(available));
+        }
+        sliced.emplace(symbol, std::vector<Bar>(end - total_bars, end));
+    }
+
+    // The last bar must fall on the test day itself (otherwise it is not a trading day)
+    if (!symbols.empty()) {
+        const Bar& last = sliced.at(symbols.front()).back();
+        time_t t = std::chrono::system_clock::to_time_t(last.timestamp);
+        struct tm last_tm;
+        gmtime_r(&t, &last_tm);
+        char buffer[11];
+        strftime(buffer, sizeof(buffer), "%Y-%m-%d", &last_tm);
+        if (date_str != buffer) {
+            throw std::runtime_error("Test date not found: " + date_str);
+        }
+    }
+    return sliced;
+}
+
+/**
+ * Build the replay window for one test date from already-loaded data
+ * (same bar selection as mock mode's filter_to_date), so one resident dataset
+ * can serve any number of dates, concurrently.
+ * @throws runtime_error if the date is missing or history is too short
+ */
+ReplayWindow build_replay_window(const Config& config,
+                                 const std::unordered_map<Symbol, std::vector<Bar>>& all_data,
+                                 const std::string& test_date) {
+    size_t warmup_in_window = config.intraday_warmup ? 0 : config.warmup_bars;
+    size_t required_bars = config.sim_bars + warmup_in_window + config.trading.bars_per_day;
+
+    auto bars = slice_to_date(all_data, config.symbols, test_date, required_bars);
+    return ReplayWindow::from_bars(config.symbols, bars, config.warmup_bars,
+                                   test_date, config.sim_days);
+}
+
+/**
+ * Load market data once and build the shared replay window for config.test_date
+ */
+bool load_replay_window(Config& config, ReplayWindow& window) {
+    std::cout << "Loading market data from " << config.data_dir << "...\n";
+    auto start_load = std::chrono::steady_clock::now();
+
+    auto all_data = DataLoader::load_from_directory(config.data_dir, config.symbols, config.extension);
+
+    try {
+        window = build_replay_window(config, all_data, config.test_date);
+    } catch (const std::exception& e) {
+        std::cerr << "❌ " << e.what() << "\n";
+        return false;
+    }
+
+    auto load_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start_load).count();
+    std::cout << "✅ Replay window ready: " << window.size() << " bars × "
+              << config.symbols.size() << " symbols (" << load_ms << "ms)\n";
+    return true;
+}
+
+/**
+ * Build a results row (metrics + echoed parameters) for batch modes
+ */
+nlohmann::json results_to_json(const MultiSymbolTrader::BacktestResults& results) {
+    return {
+        {"total_return", results.total_return},
+        {"mrd", results.mrd},
+        {"final_equity", results.final_equity},
+        {"total_trades", results.total_trades},
+        {"win_rate", results.win_rate},
+        {"profit_factor", results.profit_factor},
+        {"max_drawdown", results.max_drawdown},
+        {"sharpe_ratio", results.sharpe_ratio},
+        {"total_transaction_costs", results.total_transaction_costs}
+    };
+}
+
+/**
+ * Apply a flat {"param": value} object on top of a base config
+ * Non-numeric keys (e.g. "id") are ignored; unknown numeric keys throw, and
+ * so does a merged config that fails ConfigLoader::validate.
+ */
+TradingConfig apply_param_set(const TradingConfig& base, const nlohmann::json& params) {
+    TradingConfig cfg = base;
+    for (const auto& [key, value] : params.items()) {
+        if (key == "id") continue;
+        if (!value.is_number()) {
+            throw std::runtime_error("Parameter '" + key + "' must be numeric");
+        }
+        apply_param(cfg, key, value.get<double>());
+    }
+    ConfigLoader::validate(cfg);
+    return cfg;
+}
+
+/**
+ * Open the result cache for batch modes (nullptr if disabled or unusable)
+ */
+std::unique_ptr<ResultCache> open_result_cache(const Config& config) {
+    if (!config.use_cache) return nullptr;
+    try {
+        return std::make_unique<ResultCache>(config.cache_dir);
+    } catch (const std::exception& e) {
+        std::cerr << "⚠️  Result cache disabled: " << e.what() << "\n";
+        return nullptr;
+    }
+}
+
+void print_cache_stats(const ResultCache* cache) {
+    if (!cache) return;
+    auto st = cache->stats();
+    size_t hits = st.memory_hits + st.disk_hits;
+    std::cout << "   Cache: " << hits << " hits (" << st.disk_hits << " from disk), "
+              << st.misses << " misses, " << st.stores << " stored";
+    if (st.store_errors > 0) std::cout << ", " << st.store_errors << " write errors";
+    std::cout << " [" << cache->directory() << "]\n";
+}
+
+int run_sweep_mode(Config& config) {
+    try {
+        if (config.params_file.empty()) {
+            std::cerr << "❌ ERROR: sweep mode requires --params FILE\n";
+            return 1;
+        }
+
+        // Read parameter sets (one JSON object per line)
+        std::ifstream params_in(config.params_file);
+        if (!params_in.is_open()) {
+            std::cerr << "❌ ERROR: Cannot open params file: " << config.params_file << "\n";
+            return 1;
+        }
+        std::vector<std::string> param_lines;
+        std::string line;
+        while (std::getline(params_in, line)) {
+            if (line.find_first_not_of(" \t\r") == std::string::npos) continue;
+            param_lines.push_back(line);
+        }
+        if (param_lines.empty()) {
+            std::cerr << "❌ ERROR: No parameter sets in " << config.params_file << "\n";
+            return 1;
+        }
+
+        // Load data and assemble snapshots exactly once
+        ReplayWindow window;
+        if (!load_replay_window(config, window)) {
+            return 1;
+        }
+
+        std::string output_file = config.output_file.empty() ? "sweep_results.jsonl" : config.output_file;
+        std::ofstream out(output_file);
+        if (!out.is_open()) {
+            std::cerr << "❌ ERROR: Cannot open output file: " << output_file << "\n";
+            return 1;
+        }
+
+        auto cache = open_result_cache(config);
+        size_t num_threads = (config.threads > 0)
+            ? static_cast<size_t>(config.threads)
+            : utils::ThreadPool::default_threads();
+        std::cout << "\n🔁 Sweeping " << param_lines.size() << " configs on " << config.test_date
+                  << " with " << num_threads << " threads → " << output_file << "\n";
+
+        // Configs sharing SIGOR settings fork one warmup replay
+        PrefixCache prefixes;
+        std::unique_ptr<MedianPruner> pruner;
+        if (config.prune) {
+            pruner = std::make_unique<MedianPruner>(static_cast<size_t>(std::max(0, config.prune_startup)),
+                                                    static_cast<size_t>(std::max(0, config.prune_warmup)));
+            std::cout << "   Pruning below the running median after " << config.prune_startup
+                      << " completed configs (checked every " << config.prune_interval
+                      << " bars and at day closes)\n";
+        }
+        std::mutex out_mutex;
+        size_t completed = 0;
+        size_t failed = 0;
+        size_t pruned = 0;
+        size_t progress_every = std::max<size_t>(1, param_lines.size() / 20);
+        auto sweep_start = std::chrono::steady_clock::now();
+
+        {
+            utils::ThreadPool pool(num_threads);
+            for (size_t idx = 0; idx < param_lines.size(); ++idx) {
+                pool.submit([&, idx]() {
+                    auto t0 = std::chrono::steady_clock::now();
+                    nlohmann::json row;
+                    row["index"] = idx;
+                    bool ok = true;
+                    try {
+                        nlohmann::json params = nlohmann::json::parse(param_lines[idx]);
+                        if (!params.is_object()) {
+                            throw std::runtime_error("parameter set must be a JSON object");
+                        }
+                        if (params.contains("id")) row["id"] = params["id"];
+                        row["params"] = params;
+
+                        TradingConfig cfg = apply_param_set(config.trading, params);
+                        RunOptions options;
+                        options.cache = cache.get();
+                        options.prefixes = &prefixes;
+
+                        // Running return at every check, for the median of completed configs
+                        std::vector<double> intermediate;
+                        size_t last_bar = 0;
+                        if (pruner) {
+                            options.report_every_bars = static_cast<size_t>(std::max(0, config.prune_interval));
+                            options.on_progress = [&](const RunProgress& progress) {
+                                intermediate.push_back(progress.total_return);
+                                last_bar = progress.bar;
+                                return !pruner->should_prune(progress.step, progress.total_return);
+                            };
+                        }
+
+                        RunInfo info;
+                        row.update(results_to_json(BacktestRunner::run(window, cfg, options, &info)));
+                        row["cached"] = info.from_cache;
+                        if (info.aborted) {
+                            row["pruned"] = true;
+                            row["pruned_at_bar"] = last_bar;
+                            std::lock_guard<std::mutex> lock(out_mutex);
+                            pruned++;
+                        } else if (pruner && !info.from_cache) {
+                            pruner->complete_trial(intermediate);
+                        }
+                    } catch (const std::exception& e) {
+                        row["error"] = e.what();
+                        ok = false;
+                    }
+                    row["elapsed_ms"] = std::chrono::duration_cast<std::chrono::milliseconds>(
+                        std::chrono::steady_clock::now() - t0).count();
+
+                    // Stream rows as they complete (partial results survive interruption)
+                    std::string text = row.dump();
+                    std::lock_guard<std::mutex> lock(out_mutex);
+                    out << text << "\n";
+                    out.flush();
+                    completed++;
+                    if (!ok) failed++;
+                    if (completed % progress_every == 0 || completed == param_lines.size()) {
+                        double secs = std::chrono::duration<double>(
+                            std::chrono::steady_clock::now() - sweep_start).count();
+                        std::cout << "  [" << completed << "/" << param_lines.size() << "] "
+                                  << std::fixed << std::setprecision(1)
+                                  << (secs > 0 ? completed / secs : 0.0) << " configs/s\n";
+                    }
+                });
+            }
+            pool.wait_idle();
+        }
+
+        double total_secs = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - sweep_start).count();
+        std::cout << "\n✅ Sweep complete: " << completed << " configs in "
+                  << std::fixed << std::setprecision(2) << total_secs << "s";
+        if (failed > 0) std::cout << " (" << failed << " failed - see \"error\" rows)";
+        if (pruner) std::cout << " (" << pruned << " pruned)";
+        std::cout << "\n   Results: " << output_file << "\n";
+        auto prefix_stats = prefixes.stats();
+        std::cout << "   Warmup prefixes: " << prefix_stats.misses << " replayed, "
+                  << prefix_stats.hits << " forked\n";
+        print_cache_stats(cache.get());
+        return failed == completed ? 1 : 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "\n❌ Error in sweep mode: " << e.what() << "\n\n";
+        return 1;
+    }
+}
+
+int run_walkforward_mode(Config& config) {
+    try {
+        if (config.start_date.empty() || config.end_date.empty()) {
+            std::cerr << "❌ ERROR: walkforward mode requires --start-date MM-DD and --end-date MM-DD\n";
+            return 1;
+        }
+        if (config.start_date > config.end_date) {
+            std::cerr << "❌ ERROR: --start-date " << config.start_date
+                      << " is after --end-date " << config.end_date << "\n";
+            return 1;
+        }
+
+        // Load the full history once; every day slices it read-only
+        std::cout << "Loading market data from " << config.data_dir << "...\n";
+        auto start_load = std::chrono::steady_clock::now();
+        auto all_data = DataLoader::load_from_directory(config.data_dir, config.symbols, config.extension);
+        if (config.symbols.empty() || all_data[config.symbols.front()].empty()) {
+            std::cerr << "❌ ERROR: No data loaded\n";
+            return 1;
+        }
+
+        std::vector<std::string> test_days;
+        for (const auto& day : get_trading_days(all_data[config.symbols.front()])) {
+            if (day >= config.start_date && day <= config.end_date) {
+                test_days.push_back(day);
+            }
+        }
+        if (test_days.empty()) {
+            std::cerr << "❌ ERROR: No trading days between " << config.start_date
+                      << " and " << config.end_date << "\n";
+            return 1;
+        }
+        auto load_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start_load).count();
+        std::cout << "✅ Loaded " << config.symbols.size() << " symbols (" << load_ms << "ms)\n";
+
+        size_t num_threads = (config.threads > 0)
+            ? static_cast<size_t>(config.threads)
+            : utils::ThreadPool::default_threads();
+        std::string output_file = config.output_file.empty() ? "walkforward_results.json" : config.output_file;
+        auto cache = open_result_cache(config);
+        std::cout << "\n📅 Walk-forward " << test_days.front() << " → " << test_days.back()
+                  << ": " << test_days.size() << " days on " << num_threads << " threads\n";
+
+        // Each day (warmup + sim prefix + test day) is an independent task
+        std::vector<MultiSymbolTrader::BacktestResults> day_results(test_days.size());
+        std::vector<std::string> day_errors(test_days.size());
+        std::mutex progress_mutex;
+        size_t completed = 0;
+        auto wf_start = std::chrono::steady_clock::now();
+
+        {
+            utils::ThreadPool pool(num_threads);
+            for (size_t idx = 0; idx < test_days.size(); ++idx) {
+                pool.submit([&, idx]() {
+                    const std::string& date = test_days[idx];
+                    try {
+                        ReplayWindow window = build_replay_window(config, all_data, date);
+                        day_results[idx] = BacktestRunner::run(window, config.trading, cache.get());
+                    } catch (const std::exception& e) {
+                        day_errors[idx] = e.what();
+                    }
+
+                    std::lock_guard<std::mutex> lock(progress_mutex);
+                    completed++;
+                    std::cout << "  [" << completed << "/" << test_days.size() << "] " << date;
+                    if (!day_errors[idx].empty()) {
+                        std::cout << "  ❌ " << day_errors[idx] << "\n";
+                    } else {
+                        std::cout << "  " << std::showpos << std::fixed << std::setprecision(2)
+                                  << (day_results[idx].total_return * 100) << "%" << std::noshowpos
+                                  << "  (" << day_results[idx].total_trades << " trades)\n";
+                    }
+                });
+            }
+            pool.wait_idle();
+        }
+        auto wf_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - wf_start).count();
+
+        // Aggregate the days that ran (in date order)
+        std::vector<std::string> ok_dates;
+        std::vector<MultiSymbolTrader::BacktestResults> ok_results;
+        nlohmann::json errors = nlohmann::json::array();
+        for (size_t i = 0; i < test_days.size(); ++i) {
+            if (day_errors[i].empty()) {
+                ok_dates.push_back(test_days[i]);
+                ok_results.push_back(day_results[i]);
+            } else {
+                errors.push_back({{"date", test_days[i]}, {"error", day_errors[i]}});
+            }
+        }
+        if (ok_dates.empty()) {
+            std::cerr << "\n❌ ERROR: Every day failed - nothing to aggregate\n";
+            return 1;
+        }
+        auto wf = WalkForwardResults::aggregate(ok_dates, ok_results, config.trading.initial_capital);
+
+        // Report
+        std::cout << "\n";
+        std::cout << "╔════════════════════════════════════════════════════════════╗\n";
+        std::cout << "║                  WALK-FORWARD RESULTS                      ║\n";
+        std::cout << "╚════════════════════════════════════════════════════════════╝\n\n";
+        std::cout << "  Date         Return   Trades   Win%    MaxDD     PF\n";
+        std::cout << "  ──────────   ──────   ──────   ─────   ─────   ────\n";
+        for (size_t i = 0; i < wf.days.size(); ++i) {
+            const auto& d = wf.days[i];
+            std::cout << "  " << wf.dates[i] << "  "
+                      << std::showpos << std::fixed << std::setprecision(2) << std::setw(6)
+                      << (d.total_return * 100) << "%" << std::noshowpos
+                      << std::setw(9) << d.total_trades
+                      << std::setw(7) << std::setprecision(1) << (d.win_rate * 100) << "%"
+                      << std::setw(7) << std::setprecision(2) << (d.max_drawdown * 100) << "%"
+                      << std::setw(7) << d.profit_factor << "\n";
+        }
+
+        std::cout << "\n  Days:               " << wf.dates.size();
+        if (!errors.empty()) std::cout << " (" << errors.size() << " failed)";
+        std::cout << "\n";
+        std::cout << "  Profitable Days:    " << wf.profitable_days << "/" << wf.dates.size() << "\n";
+        std::cout << "  MRD:                " << std::showpos << std::setprecision(3)
+                  << (wf.mrd * 100) << "%" << std::noshowpos << "\n";
+        std::cout << "  Compounded Return:  " << std::showpos << std::setprecision(2)
+                  << (wf.compounded_return * 100) << "%" << std::noshowpos << "\n";
+        std::cout << "  Final Equity:       $" << wf.final_equity << "\n";
+        std::cout << "  Best / Worst Day:   " << std::showpos << (wf.best_day_return * 100) << "% / "
+                  << (wf.worst_day_return * 100) << "%" << std::noshowpos << "\n";
+        std::cout << "  Max Drawdown:       " << (wf.max_drawdown * 100) << "% (day-end), "
+                  << (wf.worst_intraday_drawdown * 100) << "% (worst intraday)\n";
+        std::cout << "  Daily Sharpe:       " << wf.daily_sharpe << "\n";
+        std::cout << "  Total Trades:       " << wf.total_trades << " (win rate "
+                  << std::setprecision(1) << (wf.win_rate * 100) << "%)\n";
+        std::cout << "  Wall Time:          " << std::setprecision(2) << (wf_ms / 1000.0) << "s\n";
+        print_cache_stats(cache.get());
+
+        nlohmann::json report;
+        report["start_date"] = config.start_date;
+        report["end_date"] = config.end_date;
+        report["threads"] = num_threads;
+        report["elapsed_ms"] = wf_ms;
+        report["summary"] = {
+            {"days", wf.dates.size()},
+            {"profitable_days", wf.profitable_days},
+            {"mrd", wf.mrd},
+            {"compounded_return", wf.compounded_return},
+            {"final_equity", wf.final_equity},
+            {"max_drawdown", wf.max_drawdown},
+            {"worst_intraday_drawdown", wf.worst_intraday_drawdown},
+            {"daily_sharpe", wf.daily_sharpe},
+            {"best_day_return", wf.best_day_return},
+            {"worst_day_return", wf.worst_day_return},
+            {"total_trades", wf.total_trades},
+            {"winning_trades", wf.winning_trades},
+            {"losing_trades", wf.losing_trades},
+            {"win_rate", wf.win_rate},
+            {"total_transaction_costs", wf.total_transaction_costs}
+        };
+        nlohmann::json days = nlohmann::json::array();
+        for (size_t i = 0; i < wf.days.size(); ++i) {
+            nlohmann::json row = results_to_json(wf.days[i]);
+            const auto& daily = wf.daily[i];
+            row["date"] = wf.dates[i];
+            row["day_number"] = daily.day_number;
+            row["start_equity"] = daily.start_equity;
+            row["end_equity"] = daily.end_equity;
+            row["daily_return"] = daily.daily_return;
+            row["trades_today"] = daily.trades_today;
+            row["winning_trades_today"] = daily.winning_trades_today;
+            row["losing_trades_today"] = daily.losing_trades_today;
+            days.push_back(row);
+        }
+        report["days"] = days;
+        report["errors"] = errors;
+
+        std::ofstream out(output_file);
+        if (!out.is_open()) {
+            std::cerr << "❌ ERROR: Cannot open output file: " << output_file << "\n";
+            return 1;
+        }
+        out << report.dump(2) << "\n";
+        std::cout << "\n   Report: " << output_file << "\n";
+        return errors.empty() ? 0 : 1;
+
+    } catch (const std::exception& e) {
+        std::cerr << "\n❌ Error in walkforward mode: " << e.what() << "\n\n";
+        return 1;
+    }
+}
+
+/**
+ * One perturbed parameter value in sensitivity mode
+ */
+struct SensitivityVariant {
+    const ParamInfo* param;
+    int step;                 // Signed multiple of delta
+    double value;
+    TradingConfig config;
+};
+
+/**
+ * Perturb every tunable parameter of `base` by ±1..steps × delta
+ * Doubles scale relatively (zero stays zero and is skipped); integers move by
+ * max(1, round(|base| × delta)) per step and never drop below 1 (0 if base is 0).
+ * Duplicate values (after rounding) are dropped.
+ */
+std::vector<SensitivityVariant> make_sensitivity_variants(const TradingConfig& base,
+                                                          double delta, int steps) {
+    std::vector<SensitivityVariant> variants;
+    for (const auto& p : tunable_params()) {
+        double base_value = p.get(base);
+        if (!p.is_int && base_value == 0.0) continue;
+
+        std::vector<double> seen = {base_value};
+        for (int k = -steps; k <= steps; ++k) {
+            if (k == 0) continue;
+            double value;
+            if (p.is_int) {
+                double unit = std::max(1.0, std::round(std::abs(base_value) * delta));
+                value = base_value + k * unit;
+                if (value < (base_value >= 1.0 ? 1.0 : 0.0)) continue;
+            } else {
+                value = base_value * (1.0 + k * delta);
+            }
+            if (std::find(seen.begin(), seen.end(), value) != seen.end()) continue;
+            seen.push_back(value);
+
+            TradingConfig cfg = base;
+            p.set(cfg, value);
+            variants.push_back({&p, k, value, cfg});
+        }
+    }
+    return variants;
+}
+
+int run_sensitivity_mode(Config& config) {
+    try {
+        if (config.delta <= 0.0 || config.steps < 1) {
+            std::cerr << "❌ ERROR: sensitivity mode needs --delta > 0 and --steps >= 1\n";
+            return 1;
+        }
+
+        // Load the full history once; every (variant, day) task shares the windows
+        std::cout << "Loading market data from " << config.data_dir << "...\n";
+        auto all_data = DataLoader::load_from_directory(config.data_dir, config.symbols, config.extension);
+        if (config.symbols.empty() || all_data[config.symbols.front()].empty()) {
+            std::cerr << "❌ ERROR: No data loaded\n";
+            return 1;
+        }
+
+        // Single day (--date) or a range (--start-date/--end-date, MRD over days)
+        std::vector<std::string> test_days;
+        if (!config.start_date.empty() || !config.end_date.empty()) {
+            std::string end = config.end_date.empty() ? get_most_recent_date(all_data) : config.end_date;
+            for (const auto& day : get_trading_days(all_data[config.symbols.front()])) {
+                if (day >= config.start_date && day <= end) test_days.push_back(day);
+            }
+        } else {
+            test_days.push_back(config.test_date.empty() ? get_most_recent_date(all_data) : config.test_date);
+        }
+        if (test_days.empty()) {
+            std::cerr << "❌ ERROR: No trading days between " << config.start_date
+                      << " and " << config.end_date << "\n";
+            return 1;
+        }
+        std::vector<ReplayWindow> windows;
+        for (const auto& d : test_days) windows.push_back(build_replay_window(config, all_data, d));
+        all_data.clear();
+
+        auto variants = make_sensitivity_variants(config.trading, config.delta, config.steps);
+        size_t num_threads = (config.threads > 0)
+            ? static_cast<size_t>(config.threads)
+            : utils::ThreadPool::default_threads();
+        std::string output_file = config.output_file.empty() ? "sensitivity_results.json" : config.output_file;
+        auto cache = open_result_cache(config);
+
+        std::cout << "\n🎚  Sensitivity: " << variants.size() << " variants (±" << config.steps << " × "
+                  << std::fixed << std::setprecision(0) << (config.delta * 100) << "%) + base over "
+                  << test_days.size() << " day(s) " << test_days.front();
+        if (test_days.size() > 1) std::cout << " → " << test_days.back();
+        std::cout << " on " << num_threads << " threads\n";
+
+        // Config 0 is the base; one task per (config, day)
+        std::vector<const TradingConfig*> configs = {&config.trading};
+        for (const auto& v : variants) configs.push_back(&v.config);
+        std::vector<std::vector<MultiSymbolTrader::BacktestResults>> results(
+            configs.size(), std::vector<MultiSymbolTrader::BacktestResults>(windows.size()));
+        std::vector<std::string> errors(configs.size());
+        std::mutex error_mutex;
+        PrefixCache prefixes;
+        auto start = std::chrono::steady_clock::now();
+        {
+            utils::ThreadPool pool(num_threads);
+            for (size_t c = 0; c < configs.size(); ++c) {
+                for (size_t d = 0; d < windows.size(); ++d) {
+                    pool.submit([&, c, d]() {
+                        try {
+                            ConfigLoader::validate(*configs[c]);
+                            results[c][d] = BacktestRunner::run(windows[d], *configs[c], cache.get(),
+                                                                nullptr, &prefixes);
+                        } catch (const std::exception& e) {
+                            std::lock_guard<std::mutex> lock(error_mutex);
+                            errors[c] = e.what();
+                        }
+                    });
+                }
+            }
+            pool.wait_idle();
+        }
+        auto elapsed_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start).count();
+
+        // MRD (%) = mean daily return; trades summed over days
+        auto mrd_of = [&](size_t c) {
+            double sum = 0.0;
+            for (const auto& r : results[c]) sum += r.total_return;
+            return sum / windows.size() * 100.0;
+        };
+        auto trades_of = [&](size_t c) {
+            int sum = 0;
+            for (const auto& r : results[c]) sum += r.total_trades;
+            return sum;
+        };
+        if (!errors[0].empty()) {
+            std::cerr << "❌ ERROR: Base config failed: " << errors[0] << "\n";
+            return 1;
+        }
+        const double base_mrd = mrd_of(0);
+        const int base_trades = trades_of(0);
+
+        // Group variants by parameter (registry order), then rank by fragility
+        struct Row {
+            const ParamInfo* param;
+            std::vector<size_t> configs;   // Indices into `configs`
+            double max_abs_delta = 0.0;
+        };
+        std::vector<Row> rows;
+        for (size_t i = 0; i < variants.size(); ++i) {
+            if (rows.empty() || rows.back().param != variants[i].param) {
+                rows.push_back({variants[i].param, {}, 0.0});
+            }
+            rows.back().configs.push_back(i + 1);
+            if (errors[i + 1].empty()) {
+                rows.back().max_abs_delta = std::max(rows.back().max_abs_delta,
+                                                     std::abs(mrd_of(i + 1) - base_mrd));
+            }
+        }
+        std::stable_sort(rows.begin(), rows.end(), [](const Row& a, const Row& b) {
+            return a.max_abs_delta > b.max_abs_delta;
+        });
+
+        // Report
+        std::cout << "\n";
+        std::cout << "╔════════════════════════════════════════════════════════════╗\n";
+        std::cout << "║                  SENSITIVITY ANALYSIS                      ║\n";
+        std::cout << "╚════════════════════════════════════════════════════════════╝\n\n";
+        std::cout << "  Base: MRD " << std::showpos << std::setprecision(3) << base_mrd << "%"
+                  << std::noshowpos << " (" << base_trades << " trades)\n\n";
+        std::cout << "  Parameter                     Base   max|ΔMRD|   Variants: value → MRD% (trades)\n";
+        std::cout << "  ────────────────────────   ───────   ─────────   ──────────────────────────────\n";
+        for (const auto& row : rows) {
+            std::cout << "  " << std::left << std::setw(25) << row.param->name << std::right
+                      << std::setw(10) << std::setprecision(row.param->is_int ? 0 : 4)
+                      << row.param->get(config.trading)
+                      << std::setw(11) << std::setprecision(3) << row.max_abs_delta << "%  ";
+            for (size_t c : row.configs) {
+                const auto& v = variants[c - 1];
+                std::cout << "  " << std::setprecision(v.param->is_int ? 0 : 4) << v.value << "→";
+                if (!errors[c].empty()) {
+                    std::cout << "error";
+                } else {
+                    std::cout << std::showpos << std::setprecision(3) << mrd_of(c) << std::noshowpos
+                              << " (" << trades_of(c) << ")";
+                }
+            }
+            std::cout << "\n";
+        }
+        std::cout << "\n  Backtests: " << configs.size() * windows.size() << " in "
+                  << std::setprecision(2) << (elapsed_ms / 1000.0) << "s\n";
+        auto prefix_stats = prefixes.stats();
+        std::cout << "   Warmup prefixes: " << prefix_stats.misses << " replayed, "
+                  << prefix_stats.hits << " forked\n";
+        print_cache_stats(cache.get());
+
+        nlohmann::json base_params = nlohmann::json::object();
+        for (const auto& p : tunable_params()) base_params[p.name] = p.get(config.trading);
+
+        nlohmann::json parameters = nlohmann::json::array();
+        size_t failed = 0;
+        for (const auto& row : rows) {
+            nlohmann::json vs = nlohmann::json::array();
+            for (size_t c : row.configs) {
+                const auto& v = variants[c - 1];
+                nlohmann::json entry = {{"step", v.step}, {"value", v.value}};
+                if (errors[c].empty()) {
+                    entry["mrd"] = mrd_of(c);
+                    entry["delta_mrd"] = mrd_of(c) - base_mrd;
+                    entry["total_trades"] = trades_of(c);
+                } else {
+                    entry["error"] = errors[c];
+                    failed++;
+                }
+                vs.push_back(entry);
+            }
+            parameters.push_back({
+                {"name", row.param->name},
+                {"base_value", row.param->get(config.trading)},
+                {"max_abs_delta_mrd", row.max_abs_delta},
+                {"variants", vs}
+            });
+        }
+
+        nlohmann::json report;
+        report["dates"] = test_days;
+        report["delta"] = config.delta;
+        report["steps"] = config.steps;
+        report["threads"] = num_threads;
+        report["elapsed_ms"] = elapsed_ms;
+        report["base"] = {{"params", base_params}, {"mrd", base_mrd}, {"total_trades", base_trades}};
+        report["parameters"] = parameters;
+
+        std::ofstream out(output_file);
+        if (!out.is_open()) {
+            std::cerr << "❌ ERROR: Cannot open output file: " << output_file << "\n";
+            return 1;
+        }
+        out << report.dump(2) << "\n";
+        std::cout << "\n   Report: " << output_file << "\n";
+        return failed == 0 ? 0 : 1;
+
+    } catch (const std::exception& e) {
+        std::cerr << "\n❌ Error in sensitivity mode: " << e.what() << "\n\n";
+        return 1;
+    }
+}
+
+/**
+ * Load an optimizer search space: {"w_rsi": [0.1, 2.0], "win_rsi": [5, 30], ...}
+ */
+SearchSpace load_search_space(const std::string& path) {
+    std::ifstream in(path);
+    if (!in.is_open()) {
+        throw std::runtime_error("Cannot open search space file: " + path);
+    }
+    nlohmann::json spec = nlohmann::json::parse(in);
+    if (!spec.is_object()) {
+        throw std::runtime_error("Search space must be a JSON object of name: [lo, hi]");
     }
 
-    auto all_trades = trader.get_all_trades();
-
-    // Sort trades by entry time
-    std::sort(all_trades.begin(), all_trades.end(),
-              [](const TradeRecord& a, const TradeRecord& b) {
-                  return a.entry_time < b.entry_time;
-              });
-
-    // Export each trade as ENTRY and EXIT
-    for (const auto& trade : all_trades) {
-        // Entry trade
-        auto entry_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
-            trade.entry_time.time_since_epoch()).count();
-        auto exit_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
-            trade.exit_time.time_since_epoch()).count();
-
-        double bars_held = (exit_ms - entry_ms) / 60000.0; // Assuming 1-minute bars
-        double entry_value = trade.shares * trade.entry_price;
-        double exit_value = trade.shares * trade.exit_price;
-
-        // ENTRY record
-        file << "{"
-             << "\"symbol\":\"" << trade.symbol << "\","
-             << "\"action\":\"ENTRY\","
-             << "\"timestamp_ms\":" << entry_ms << ","
-             << "\"bar_id\":" << trade.entry_bar_id << ","
-             << "\"price\":" << trade.entry_price << ","
-             << "\"shares\":" << trade.shares << ","
-             << "\"value\":" << entry_value << ","
-             << "\"pnl\":0,"
-             << "\"pnl_pct\":0,"
-             << "\"bars_held\":0,"
-             << "\"reason\":\"Rotation\""
-             << "}\n";
-
-        // EXIT record
-        file << "{"
-             << "\"symbol\":\"" << trade.symbol << "\","
-             << "\"action\":\"EXIT\","
-             << "\"timestamp_ms\":" << exit_ms << ","
-             << "\"bar_id\":" << trade.exit_bar_id << ","
-             << "\"price\":" << trade.exit_price << ","
-             << "\"shares\":" << trade.shares << ","
-             << "\"value\":" << exit_value << ","
-             << "\"pnl\":" << trade.pnl << ","
-             << "\"pnl_pct\":" << (trade.pnl_pct * 100) << ","
-             << "\"bars_held\":" << static_cast<int>(bars_held) << ","
-             << "\"reason\":\"Rotation\""
-             << "}\n";
+    SearchSpace space;
+    for (const auto& [name, range] : spec.items()) {
+        if (!range.is_array() || range.size() != 2 || !range[0].is_number() || !range[1].is_number()) {
+            throw std::runtime_error("Search space entry '" + name + "' must be [lo, hi]");
+        }
+        space.add(name, range[0].get<double>(), range[1].get<double>());
     }
+    return space;
+}
+
+int run_optimize_mode(Config& config) {
+    try {
+        SearchSpace space = config.space_file.empty()
+            ? SearchSpace::sigor_default()
+            : load_search_space(config.space_file);
+
+        // Load the full history once; train/validation windows are built once and shared
+        std::cout << "Loading market data from " << config.data_dir << "...\n";
+        auto all_data = DataLoader::load_from_directory(config.data_dir, config.symbols, config.extension);
+        if (config.symbols.empty() || all_data[config.symbols.front()].empty()) {
+            std::cerr << "❌ ERROR: No data loaded\n";
+            return 1;
+        }
+        std::string end_date = config.end_date.empty() ? get_most_recent_date(all_data) : config.end_date;
+
+        // Day split (as evaluate_config.py): [validation days][train days] ending at end_date
+        std::vector<std::string> history;
+        for (const auto& day : get_trading_days(all_data[config.symbols.front()])) {
+            if (day <= end_date) history.push_back(day);
+        }
+        size_t needed = static_cast<size_t>(config.train_days + config.val_days);
+        if (config.train_days <= 0 || history.size() < needed) {
+            std::cerr << "❌ ERROR: Need " << needed << " trading days up to " << end_date
+                      << " (have " << history.size() << ")\n";
+            return 1;
+        }
+        std::vector<std::string> val_dates(history.end() - needed, history.end() - config.train_days);
+        std::vector<std::string> train_dates(history.end() - config.train_days, history.end());
+
+        std::vector<ReplayWindow> windows;   // Train days first, then validation days
+        for (const auto& d : train_dates) windows.push_back(build_replay_window(config, all_data, d));
+        for (const auto& d : val_dates) windows.push_back(build_replay_window(config, all_data, d));
+        all_data.clear();
+        const size_t num_train = train_dates.size();
+
+        size_t num_threads = (config.threads > 0)
+            ? static_cast<size_t>(config.threads)
+            : utils::ThreadPool::default_threads();
+        auto optimizer = make_optimizer(config.algorithm, space.encode(config.trading),
+                                        static_cast<size_t>(config.population), config.seed);
+        size_t pop = optimizer->population_size();
+        size_t generations = (static_cast<size_t>(std::max(config.trials, 1)) + pop - 1) / pop;
+        std::string output_file = config.output_file.empty() ? "optimize_results.json" : config.output_file;
+        auto cache = open_result_cache(config);
+
+        std::cout << "\n🧬 " << optimizer->name() << " over " << space.size() << " parameters: "
+                  << generations << " generations × " << pop << " candidates on "
+                  << num_threads << " threads\n";
+        std::cout << "   Train: " << train_dates.front() << " → " << train_dates.back()
+                  << " (" << train_dates.size() << " days)";
+        if (!val_dates.empty()) {
+            std::cout << "   Validation: " << val_dates.front() << " → " << val_dates.back()
+                      << " (" << val_dates.size() << " days, max "
+                      << std::fixed << std::setprecision(0) << (config.overfit_threshold * 100)
+                      << "% degradation)";
+        }
+        std::cout << "\n\n";
+
+        // Same acceptance rule as optimize_with_validation.py (MRD in percent)
+        constexpr double REJECT_FITNESS = -999.0;
+        auto check_overfit = [&](double train_mrd, double val_mrd, double& degradation) {
+            if (train_mrd <= 0.0) {
+                degradation = 0.0;
+                return val_mrd < train_mrd;
+            }
+            degradation = (train_mrd - val_mrd) / train_mrd;
+            return degradation > config.overfit_threshold;
+        };
+
+        nlohmann::json trials = nlohmann::json::array();
+        nlohmann::json best;
+        double best_fitness = -std::numeric_limits<double>::infinity();
+        size_t evaluated = 0;
+        auto opt_start = std::chrono::steady_clock::now();
+        utils::ThreadPool pool(num_threads);
+
+        for (size_t gen = 0; gen < generations; ++gen) {
+            auto candidates = optimizer->ask();
+            const size_t n_cand = candidates.size();
+
+            // One task per (candidate, day)
+            std::vector<std::vector<MultiSymbolTrader::BacktestResults>> results(
+                n_cand, std::vector<MultiSymbolTrader::BacktestResults>(windows.size()));
+            std::vector<std::string> errors(n_cand);
+            std::mutex error_mutex;
+            std::vector<TradingConfig> configs;
+            configs.reserve(n_cand);
+            for (const auto& c : candidates) configs.push_back(space.apply(config.trading, c));
+
+            for (size_t c = 0; c < n_cand; ++c) {
+                for (size_t d = 0; d < windows.size(); ++d) {
+                    pool.submit([&, c, d]() {
+                        try {
+                            ConfigLoader::validate(configs[c]);
+                            results[c][d] = BacktestRunner::run(windows[d], configs[c], cache.get());
+                        } catch (const std::exception& e) {
+                            std::lock_guard<std::mutex> lock(error_mutex);
+                            errors[c] = e.what();
+                        }
+                    });
+                }
+            }
+            pool.wait_idle();
+
+            std::vector<double> fitness(n_cand);
+            size_t accepted = 0;
+            for (size_t c = 0; c < n_cand; ++c) {
+                double train_mrd = 0.0, val_mrd = 0.0;
+                int train_trades = 0, val_trades = 0;
+                for (size_t d = 0; d < windows.size(); ++d) {
+                    double r = results[c][d].total_return * 100.0;
+                    if (d < num_train) {
+                        train_mrd += r;
+                        train_trades += results[c][d].total_trades;
+                    } else {
+                        val_mrd += r;
+                        val_trades += results[c][d].total_trades;
+                    }
+                }
+                train_mrd /= num_train;
+                if (!val_dates.empty()) val_mrd /= val_dates.size();
+
+                double degradation = 0.0;
+                bool overfit = !val_dates.empty() && check_overfit(train_mrd, val_mrd, degradation);
+                bool ok = errors[c].empty() && !overfit;
+                fitness[c] = ok ? train_mrd : REJECT_FITNESS;
+                if (ok) accepted++;
+
+                nlohmann::json params = nlohmann::json::object();
+                std::vector<double> values = space.decode(candidates[c]);
+                for (size_t i = 0; i < space.size(); ++i) {
+                    params[space.dimensions()[i].param->name] = values[i];
+                }
+
+                nlohmann::json row = {
+                    {"trial", evaluated++},
+                    {"generation", gen},
+                    {"params", params},
+                    {"train_mrd", train_mrd},
+                    {"train_trades", train_trades},
+                    {"fitness", fitness[c]}
+                };
+                if (!val_dates.empty()) {
+                    row["val_mrd"] = val_mrd;
+                    row["val_trades"] = val_trades;
+                    row["degradation_pct"] = degradation;
+                    row["verdict"] = overfit ? "REJECT" : "ACCEPT";
+                }
+                if (!errors[c].empty()) row["error"] = errors[c];
+
+                if (fitness[c] > best_fitness) {
+                    best_fitness = fitness[c];
+                    best = row;
+                }
+                trials.push_back(std::move(row));
+            }
+
+            optimizer->tell(fitness);
+
+            double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - opt_start).count();
+            std::cout << "  Gen " << std::setw(3) << (gen + 1) << "/" << generations
+                      << "  best " << std::showpos << std::fixed << std::setprecision(3)
+                      << best_fitness << "%" << std::noshowpos;
+            if (!val_dates.empty() && best.contains("val_mrd")) {
+                std::cout << " (val " << std::showpos << best["val_mrd"].get<double>()
+                          << "%" << std::noshowpos << ")";
+            }
+            std::cout << "  accepted " << accepted << "/" << n_cand
+                      << "  " << std::setprecision(1) << (secs > 0 ? evaluated / secs : 0.0)
+                      << " trials/s\n";
+        }
+
+        double total_secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - opt_start).count();
+        std::cout << "\n✅ " << evaluated << " trials in " << std::setprecision(2) << total_secs << "s\n";
+        print_cache_stats(cache.get());
+        if (best_fitness <= REJECT_FITNESS) {
+            std::cout << "⚠️  No candidate passed validation - best row is a rejected trial\n";
+        }
+        std::cout << "   Best params:";
+        for (const auto& [name, value] : best["params"].items()) {
+            std::cout << " " << name << "=" << std::setprecision(4) << value.get<double>();
+        }
+        std::cout << "\n";
 
-    file.close();
+        nlohmann::json report = {
+            {"algorithm", optimizer->name()},
+            {"seed", config.seed},
+            {"trials", evaluated},
+            {"population", pop},
+            {"generations", generations},
+            {"train_dates", train_dates},
+            {"val_dates", val_dates},
+            {"overfit_threshold", config.overfit_threshold},
+            {"elapsed_ms", static_cast<int64_t>(total_secs * 1000.0)},
+            {"best", best},
+            {"history", trials}
+        };
+        std::ofstream out(output_file);
+        if (!out.is_open()) {
+            std::cerr << "❌ ERROR: Cannot open output file: " << output_file << "\n";
+            return 1;
+        }
+        out << report.dump(2) << "\n";
+        std::cout << "   Report: " << output_file << " (best params apply directly as a sweep/serve parameter set)\n";
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "\n❌ Error in optimize mode: " << e.what() << "\n\n";
+        return 1;
+    }
 }
 
 int run_mock_mode(Config& config) {
@@ -829,7 +2051,7 @@ int run_mock_mode(Config& config) {
 
         // Export trades for dashboard (only if dashboard enabled)
         if (config.generate_dashboard) {
-            export_trades_jsonl(trader, "trades.jsonl");
+            ResultsExporter::export_trades_jsonl(trader, "trades.jsonl");
             std::cout << "\n✅ Results exported to: " << config.results_file << "\n";
             std::cout << "✅ Trades exported to: trades.jsonl\n";
         }
@@ -855,6 +2077,7 @@ int run_mock_mode(Config& config) {
                   << std::noshowpos << "%\n";
         std::cout << "  MRD (Daily):        " << std::showpos << (results.mrd * 100)
                   << std::noshowpos << "% per day\n";
+        std::cout << "  Max Drawdown:       " << (results.max_drawdown * 100) << "%\n";
         std::cout << "\n";
 
         std::cout << "Trade Statistics:\n";
@@ -878,6 +2101,11 @@ int run_mock_mode(Config& config) {
         std::cout << "  Total Time:         " << (load_duration + trading_duration) << "ms\n";
         std::cout << "\n";
 
+        if (!trader.stage_profile().empty()) {
+            trader.stage_profile().print(std::cout);
+            std::cout << "\n";
+        }
+
         // Performance assessment
         std::cout << "Assessment: ";
         if (results.total_return > 0.02 && results.win_rate > 0.55) {
@@ -934,486 +2162,475 @@ int run_mock_mode(Config& config) {
     }
 }
 
-int run_live_mode(Config& config) {
-    try {
-        std::cout << "\n";
-        std::cout << "╔════════════════════════════════════════════════════════════╗\n";
-        std::cout << "║         LIVE MODE - Real-Time Paper Trading                ║\n";
-        std::cout << "╚════════════════════════════════════════════════════════════╝\n";
-        std::cout << "\n";
-
-        std::cout << "🟢 Starting LIVE trading session...\n\n";
-
-        // FIFO pipes for communication
-        const std::string bar_fifo = "/tmp/alpaca_bars.fifo";
-        const std::string order_fifo = "/tmp/alpaca_orders.fifo";
-        const std::string response_fifo = "/tmp/alpaca_responses.fifo";
-
-        std::cout << "Configuration:\n";
-        std::cout << "  Data Source:     Alpaca WebSocket (IEX)\n";
-        std::cout << "  Order Submission: Alpaca REST API\n";
-        std::cout << "  Bar FIFO:        " << bar_fifo << "\n";
-        std::cout << "  Order FIFO:      " << order_fifo << "\n";
-        std::cout << "  Response FIFO:   " << response_fifo << "\n";
-        std::cout << "\n";
-
-        // Initialize trader with SIGOR configuration
-        std::cout << "Initializing trader...\n";
-        MultiSymbolTrader trader(config.symbols, config.trading);
-        std::cout << "✅ Trader initialized\n\n";
-
-        // SIGOR Warmup Strategy:
-        // SIGOR is rule-based (no learning), but needs lookback bars for indicators:
-        //   - RSI(14) needs 14 bars
-        //   - Bollinger(20) needs 20 bars
-        //   - Momentum(10) needs 10 bars
-        //   - ORB needs first 30 bars of day
-        //   - Volume surge needs 20-bar window
-        //
-        // Solution: Load today's historical bars (9:30 ET to now) before live trading
-        // This gives SIGOR the lookback data it needs to calculate indicators
-
-        std::cout << "🔄 Checking for warmup bars (today's historical data)...\n";
-
-        // Try to load warmup bars from JSON (optional - created by fetch_today_bars.py)
-        [[maybe_unused]] bool has_warmup = false;
-        const std::string warmup_file = "warmup_bars.json";
-        size_t warmup_bars_loaded = 0;
-
-        if (std::filesystem::exists(warmup_file)) {
-            try {
-                std::cout << "   Found warmup_bars.json - loading historical bars...\n";
-
-                std::ifstream warmup_stream(warmup_file);
-                nlohmann::json warmup_json;
-                warmup_stream >> warmup_json;
-
-                // Feed warmup bars to trader (last 50 bars per symbol)
-                // No need for perfect alignment - system handles mismatches naturally
-                constexpr size_t MIN_WARMUP_BARS = 50;
-
-                // Load last 50 bars per symbol, group by bar_id
-                std::map<int, std::unordered_map<Symbol, Bar>> bars_by_id;
-
-                for (const auto& [symbol, bars_array] : warmup_json.items()) {
-                    size_t total_bars = bars_array.size();
-                    size_t start_idx = (total_bars > MIN_WARMUP_BARS)
-                                        ? (total_bars - MIN_WARMUP_BARS)
-                                        : 0;
-
-                    for (size_t i = start_idx; i < total_bars; i++) {
-                        const auto& bar_data = bars_array[i];
+// ============================================================================
+// Serve mode (persistent evaluation server)
+// ============================================================================
+
+/**
+ * One serve-mode client: NDJSON requests in, NDJSON responses out
+ * Responses are written by worker threads as evaluations finish, so they can
+ * arrive out of request order - clients correlate them by "id". The socket is
+ * closed when the reader and every in-flight evaluation have let go of it.
+ */
+class ServeConnection {
+public:
+    ServeConnection(int in_fd, int out_fd, bool owns_fd)
+        : in_fd_(in_fd), out_fd_(out_fd), owns_fd_(owns_fd), reader_(in_fd) {}
+
+    ~ServeConnection() {
+        if (owns_fd_) ::close(in_fd_);
+    }
 
-                        Bar bar;
-                        bar.symbol = symbol;
+    ServeConnection(const ServeConnection&) = delete;
+    ServeConnection& operator=(const ServeConnection&) = delete;
+
+    FdLineReader& reader() { return reader_; }
+
+    /**
+     * Write one response line (thread-safe; gives up silently once the peer is gone)
+     */
+    void send(const nlohmann::json& response) {
+        std::string text = response.dump();
+        text.push_back('\n');
+
+        std::lock_guard<std::mutex> lock(write_mutex_);
+        if (broken_) return;
+        size_t off = 0;
+        while (off < text.size()) {
+            ssize_t n = ::write(out_fd_, text.data() + off, text.size() - off);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) {
+                broken_ = true;
+                return;
+            }
+            off += static_cast<size_t>(n);
+        }
+    }
 
-                        int64_t timestamp_ms = bar_data.value("t_ms", 0);
-                        if (timestamp_ms == 0) continue;
+    /**
+     * True once a write failed (peer gone): its in-flight trials can stop
+     */
+    bool broken() {
+        std::lock_guard<std::mutex> lock(write_mutex_);
+        return broken_;
+    }
 
-                        bar.timestamp = std::chrono::system_clock::time_point(
-                            std::chrono::milliseconds(timestamp_ms));
-                        bar.open = bar_data["o"];
-                        bar.high = bar_data["h"];
-                        bar.low = bar_data["l"];
-                        bar.close = bar_data["c"];
-                        bar.volume = bar_data["v"];
-                        bar.bar_id = bar_data.value("bar_id", -1);
+    /**
+     * Abort flag for an in-flight request (registered when it is queued)
+     */
+    std::shared_ptr<std::atomic<bool>> track(const std::string& request_key) {
+        auto flag = std::make_shared<std::atomic<bool>>(false);
+        std::lock_guard<std::mutex> lock(inflight_mutex_);
+        inflight_[request_key] = flag;
+        return flag;
+    }
 
-                        if (bar.bar_id < 0) continue;
+    void untrack(const std::string& request_key, const std::shared_ptr<std::atomic<bool>>& flag) {
+        std::lock_guard<std::mutex> lock(inflight_mutex_);
+        auto it = inflight_.find(request_key);
+        if (it != inflight_.end() && it->second == flag) inflight_.erase(it);
+    }
 
-                        bars_by_id[bar.bar_id][symbol] = bar;
-                    }
-                }
+    /**
+     * Signal an in-flight request to stop
+     * @return false if no request with that id is queued or running
+     */
+    bool abort(const std::string& request_key) {
+        std::lock_guard<std::mutex> lock(inflight_mutex_);
+        auto it = inflight_.find(request_key);
+        if (it == inflight_.end()) return false;
+        it->second->store(true);
+        return true;
+    }
 
-                // Process bars in chronological order (by bar_id)
-                for (const auto& [bar_id, snapshot] : bars_by_id) {
-                    trader.on_bar(snapshot);
-                    warmup_bars_loaded++;
-                }
+private:
+    int in_fd_;
+    int out_fd_;
+    bool owns_fd_;
+    FdLineReader reader_;
+    std::mutex write_mutex_;
+    bool broken_ = false;
 
-                has_warmup = true;
-                std::cout << "   ✅ Loaded " << warmup_bars_loaded << " warmup bars\n";
-                std::cout << "   → SIGOR ready to trade immediately with indicator lookback\n\n";
+    std::mutex inflight_mutex_;
+    std::unordered_map<std::string, std::shared_ptr<std::atomic<bool>>> inflight_;   // By request id (JSON text)
+};
 
-            } catch (const std::exception& e) {
-                std::cerr << "   ⚠️  Failed to load warmup bars: " << e.what() << "\n";
-                std::cout << "   → SIGOR will start trading after collecting enough bars\n\n";
+/**
+ * State shared by every serve-mode connection and worker
+ * Market data stays resident; each test date's replay window is built once on
+ * first use (by whichever worker needs it first) and then shared read-only.
+ */
+struct ServeContext {
+    const Config& config;
+    std::unordered_map<Symbol, std::vector<Bar>> all_data;
+    std::string default_date;
+
+    std::mutex windows_mutex;
+    std::unordered_map<std::string, std::shared_future<std::shared_ptr<const ReplayWindow>>> windows;
+
+    std::atomic<bool> stopping{false};
+    std::atomic<size_t> evaluated{0};
+    std::atomic<size_t> aborted{0};
+    std::atomic<size_t> failed{0};
+    std::unique_ptr<ResultCache> cache;
+    PrefixCache prefixes;     // Shared warmup state per (date, SIGOR settings)
+
+    utils::ThreadPool pool;   // Declared last: joined before the state its tasks use
+
+    ServeContext(const Config& cfg, size_t threads) : config(cfg), pool(threads) {}
+
+    /**
+     * Replay window for a date (built on first request, then cached)
+     * @throws runtime_error if the window cannot be built for that date
+     */
+    std::shared_ptr<const ReplayWindow> window_for(const std::string& date) {
+        std::promise<std::shared_ptr<const ReplayWindow>> promise;
+        std::shared_future<std::shared_ptr<const ReplayWindow>> future;
+        bool build = false;
+        {
+            std::lock_guard<std::mutex> lock(windows_mutex);
+            auto it = windows.find(date);
+            if (it == windows.end()) {
+                future = promise.get_future().share();
+                windows.emplace(date, future);
+                build = true;
+            } else {
+                future = it->second;
             }
-        } else {
-            std::cout << "   No warmup_bars.json found\n";
-            std::cout << "   → SIGOR will start trading after collecting ~30 bars (~30 minutes)\n";
-            std::cout << "   TIP: Run scripts/fetch_today_bars.py to get immediate trading\n\n";
         }
 
-        // Market snapshot buffer - accumulate bars until all symbols updated
-        std::unordered_map<Symbol, Bar> market_snapshot;
-        std::unordered_map<Symbol, Timestamp> last_update_time;
-
-        // Tracking
-        size_t bars_processed = 0;
-        size_t snapshots_processed = 0;
-        bool running = true;
-
-        // Keep last N raw JSON lines to include in failure reports
-        std::deque<std::string> recent_raw_lines;
-        const size_t MAX_RECENT_LINES = 50;
-
-        auto write_runtime_failure_report = [&](const std::string& severity,
-                                                const std::string& message,
-                                                const std::string& offending_line) {
+        if (build) {
             try {
-                std::filesystem::create_directories("logs/live");
-                auto now = std::chrono::system_clock::now();
-                std::time_t tnow = std::chrono::system_clock::to_time_t(now);
-                char tsbuf[20];
-                std::strftime(tsbuf, sizeof(tsbuf), "%Y%m%d_%H%M%S", std::localtime(&tnow));
-                std::string path = std::string("logs/live/failure_") + severity + "_" + tsbuf + ".log";
-
-                std::ofstream out(path);
-                out << "severity: " << severity << "\n";
-                out << "message: " << message << "\n";
-                out << "bars_processed: " << bars_processed << "\n";
-                out << "snapshots_processed: " << snapshots_processed << "\n";
-                out << "symbols_expected: ";
-                for (size_t i = 0; i < config.symbols.size(); ++i) {
-                    out << config.symbols[i] << (i + 1 < config.symbols.size() ? "," : "");
-                }
-                out << "\n";
-                out << "symbols_present: ";
-                {
-                    bool first = true;
-                    for (const auto& [sym, _] : market_snapshot) {
-                        if (!first) out << ","; first = false;
-                        out << sym;
-                    }
-                    out << "\n";
-                }
-                if (!offending_line.empty()) {
-                    out << "offending_line: " << offending_line << "\n";
-                }
-                out << "recent_raw_lines:" << "\n";
-                size_t idx = 0;
-                for (const auto& ln : recent_raw_lines) {
-                    out << "  [" << idx++ << "] " << ln << "\n";
-                }
-                // Dump positions
-                out << "positions:" << "\n";
-                for (const auto& [sym, pos] : trader.positions()) {
-                    out << "  - symbol: " << sym
-                        << ", shares: " << pos.shares
-                        << ", entry: " << pos.entry_price
-                        << ", held_bars: " << (int)0 /* placeholder */
-                        << "\n";
-                }
-                out.close();
-                std::cerr << "\n⚠️  Runtime incident logged → " << path << "\n";
+                promise.set_value(std::make_shared<const ReplayWindow>(
+                    build_replay_window(config, all_data, date)));
             } catch (...) {
-                // Swallow any logging failures to avoid masking original error
+                promise.set_exception(std::current_exception());
             }
-        };
-
-        
-
-        std::unique_ptr<std::istream> fifo_stream;
-        std::ifstream bar_stream;
-        bool use_fifo = (config.feed != "zmq");
-
-#ifdef ENABLE_ZMQ
-        if (!use_fifo) {
-            std::cout << "🔗 ZMQ SUB mode: " << config.zmq_url << " (topic: BARS)\n\n";
         }
-#else
-        if (!use_fifo) {
-            std::cerr << "⚠️  ZMQ feed requested but binary built without ZMQ. Falling back to FIFO.\n";
-            use_fifo = true;
+        return future.get();
+    }
+};
+
+/**
+ * Handle one request line from a client
+ * Requests:
+ *   {"id": 7, "params": {"w_rsi": 1.4}, "date": "10-21"}   evaluate (date optional)
+ *   {"id": 7, "w_rsi": 1.4}                                flat form, as in sweep files
+ *   {"id": 7, "params": {...}, "report_every": 60}         also stream progress events at
+ *                                                          day closes and every 60 trading bars
+ *                                                          ("progress": true = day closes only)
+ *   {"cmd": "abort", "target": 7}                          stop request 7 (partial result, "aborted")
+ *   {"cmd": "ping"} | {"cmd": "params"} | {"cmd": "shutdown"}
+ */
+void handle_serve_request(ServeContext& ctx, const std::shared_ptr<ServeConnection>& conn,
+                          const std::string& line) {
+    nlohmann::json request;
+    try {
+        request = nlohmann::json::parse(line);
+        if (!request.is_object()) {
+            throw std::runtime_error("request must be a JSON object");
         }
-#endif
+    } catch (const std::exception& e) {
+        conn->send({{"error", std::string("Bad request: ") + e.what()}});
+        return;
+    }
 
-        if (use_fifo) {
-            std::cout << "📡 Opening FIFO pipe for incoming bars...\n";
-            std::cout << "   (Waiting for bridge to connect)\n\n";
-            bar_stream.open(bar_fifo);
-            if (!bar_stream.is_open()) {
-                std::cerr << "❌ Error: Failed to open bar FIFO: " << bar_fifo << "\n";
-                return 1;
+    nlohmann::json id = request.contains("id") ? request["id"] : nlohmann::json();
+
+    if (request.contains("cmd")) {
+        std::string cmd = request["cmd"].is_string() ? request["cmd"].get<std::string>() : "";
+        if (cmd == "ping") {
+            conn->send({{"id", id}, {"event", "pong"}, {"evaluated", ctx.evaluated.load()},
+                        {"aborted", ctx.aborted.load()}, {"failed", ctx.failed.load()}});
+        } else if (cmd == "params") {
+            nlohmann::json params = nlohmann::json::object();
+            for (const auto& p : tunable_params()) {
+                params[p.name] = p.get(ctx.config.trading);
             }
-            std::cout << "✅ Connected to FIFO bridge\n";
+            conn->send({{"id", id}, {"event", "params"}, {"params", params}});
+        } else if (cmd == "shutdown") {
+            ctx.stopping = true;
+            conn->send({{"id", id}, {"event", "shutdown"}});
+        } else if (cmd == "abort") {
+            nlohmann::json target = request.contains("target") ? request["target"] : nlohmann::json();
+            bool found = conn->abort(target.dump());
+            conn->send({{"id", id}, {"event", "abort"}, {"target", target}, {"found", found}});
+        } else {
+            conn->send({{"id", id}, {"error", "Unknown command: '" + cmd + "'"}});
         }
+        return;
+    }
 
-        std::cout << "🚀 LIVE TRADING ACTIVE - Processing real-time bars\n";
-        std::cout << "   Press Ctrl+C to stop\n\n";
-        std::cout << "═══════════════════════════════════════════════════════════════\n\n";
-
-        // Main trading loop - read bars from FIFO and process
-        std::string line;
-        while (running) {
-            if (use_fifo) {
-                if (!std::getline(bar_stream, line)) break;
-            }
-#ifdef ENABLE_ZMQ
-            else {
-                // Minimal blocking ZMQ SUB receive (topic-prefixed string)
-                static zmq::context_t ctx(1);
-                static zmq::socket_t sub(ctx, zmq::socket_type::sub);
-                static bool zmq_init = false;
-                if (!zmq_init) {
-                    try {
-                        sub.set(zmq::sockopt::subscribe, "BARS");
-                        sub.set(zmq::sockopt::rcvhwm, 1000);
-                        sub.connect(config.zmq_url);
-                        zmq_init = true;
-                    } catch (const zmq::error_t& e) {
-                        std::cerr << "❌ ZMQ connect failed: " << e.what() << "\n";
-                        return 1;
-                    }
-                }
-                zmq::message_t msg;
-                try {
-                    auto res = sub.recv(msg, zmq::recv_flags::none);
-                    if (!res.has_value()) continue;
-                    std::string s = msg.to_string();
-                    auto pos = s.find(' ');
-                    if (pos == std::string::npos) continue;
-                    line = s.substr(pos + 1);
-                } catch (const zmq::error_t& e) {
-                    std::cerr << "⚠️  ZMQ error: " << e.what() << "\n";
-                    continue;
-                }
+    // Evaluation request: resolve date and parameters here, run on the pool
+    std::string date = ctx.default_date;
+    nlohmann::json params;
+    bool progress_events = false;
+    size_t report_every = 0;
+    try {
+        if (request.contains("date")) {
+            if (!request["date"].is_string()) throw std::runtime_error("\"date\" must be a string");
+            date = expand_date_arg(request["date"].get<std::string>());
+        }
+        if (request.contains("report_every")) {
+            if (!request["report_every"].is_number_unsigned()) {
+                throw std::runtime_error("\"report_every\" must be a non-negative integer");
             }
-#endif
-            if (line.empty()) continue;
-
-            // Track raw line for failure reports
-            recent_raw_lines.push_back(line);
-            if (recent_raw_lines.size() > MAX_RECENT_LINES) recent_raw_lines.pop_front();
-
-            try {
-                // Parse JSON bar from websocket bridge
-                nlohmann::json bar_json = nlohmann::json::parse(line);
-
-                // Extract bar data
-                std::string symbol = bar_json["symbol"];
-                int64_t timestamp_ms = bar_json["timestamp_ms"];
-
-                Bar bar;
-                bar.symbol = symbol;
-                bar.timestamp = std::chrono::system_clock::time_point(
-                    std::chrono::milliseconds(timestamp_ms));
-                bar.open = bar_json["open"];
-                bar.high = bar_json["high"];
-                bar.low = bar_json["low"];
-                bar.close = bar_json["close"];
-                bar.volume = bar_json["volume"];
-                // vwap and trade_count are optional Alpaca fields, not in our Bar struct
-
-                // Calculate bar_id from timestamp (minutes since midnight ET)
-                // This is crucial for SIGOR's bar synchronization
-                auto time_seconds = std::chrono::duration_cast<std::chrono::seconds>(
-                    bar.timestamp.time_since_epoch()).count();
-                time_t time = static_cast<time_t>(time_seconds);
-                struct tm* tm_info = localtime(&time);
-                int minutes_since_midnight = tm_info->tm_hour * 60 + tm_info->tm_min;
-                // Market opens at 9:30 ET (570 minutes), so bar 1 = 570 minutes
-                bar.bar_id = minutes_since_midnight - 569;  // 570 = 9:30, so bar_id 1
-
-                // Update market snapshot
-                market_snapshot[symbol] = bar;
-                last_update_time[symbol] = bar.timestamp;
-                bars_processed++;
-
-                // Log bar receipt (every 10th bar to reduce noise)
-                if (bars_processed % 10 == 0) {
-                    auto now = std::chrono::system_clock::now();
-                    auto time_t_now = std::chrono::system_clock::to_time_t(now);
-                    struct tm* tm_now = localtime(&time_t_now);
-                    char time_str[10];
-                    strftime(time_str, sizeof(time_str), "%H:%M:%S", tm_now);
-
-                    std::cout << "[" << time_str << "] "
-                              << symbol << " @ " << std::setprecision(2) << std::fixed
-                              << bar.close << " | Bars: " << bars_processed
-                              << " | Snapshots: " << snapshots_processed << "\n";
-                }
+            report_every = request["report_every"].get<size_t>();
+            progress_events = true;
+        }
+        if (request.contains("progress")) {
+            if (!request["progress"].is_boolean()) throw std::runtime_error("\"progress\" must be true or false");
+            progress_events = progress_events || request["progress"].get<bool>();
+        }
+        if (request.contains("params")) {
+            params = request["params"];
+            if (!params.is_object()) throw std::runtime_error("\"params\" must be a JSON object");
+        } else {
+            params = request;
+            params.erase("date");
+            params.erase("report_every");
+            params.erase("progress");
+        }
+    } catch (const std::exception& e) {
+        conn->send({{"id", id}, {"error", e.what()}});
+        return;
+    }
 
-                // Check if we have all symbols updated (for synchronized processing)
-                // For SIGOR, we process as soon as all symbols have at least one bar
-                //
-                // IMPORTANT: Missing Bar Handling
-                // If a symbol has a gap (missing bar), we do NOT process that snapshot.
-                // This prevents:
-                //   1. Trading on stale prices
-                //   2. Entering positions with bad synchronization
-                //   3. Indicator calculation errors
-                //
-                // When SIGOR generates a signal but a bar is missing:
-                //   → Skip the trade (don't enter)
-                //   → Wait for next complete snapshot
-                //   → Log warning if gaps are frequent
-                [[maybe_unused]] bool all_symbols_ready = true;
-                for (const auto& sym : config.symbols) {
-                    if (market_snapshot.find(sym) == market_snapshot.end()) {
-                        all_symbols_ready = false;
-                        break;
-                    }
-                }
+    std::string request_key = id.dump();
+    auto abort_flag = conn->track(request_key);
 
-                // Process snapshot on every bar update (allow partial snapshots)
-                // Rationale: Some symbols have sparse prints; requiring all 12 stalls the system.
-                // The trader guards internally against missing symbols and insufficient lookback.
-                trader.on_bar(market_snapshot);
-                snapshots_processed++;
-
-                if (snapshots_processed % 20 == 0) {
-                    auto results = trader.get_results();
-                    double equity = trader.get_equity(market_snapshot);
-                    double return_pct = (equity - config.capital) / config.capital * 100;
-
-                    std::cout << "\n📊 [Status Update] Snapshot " << snapshots_processed << "\n";
-                    std::cout << "   Equity: $" << std::fixed << std::setprecision(2) << equity;
-                    std::cout << " (" << std::showpos << return_pct << std::noshowpos << "%)\n";
-                    std::cout << "   Trades: " << results.total_trades;
-                    std::cout << " | Positions: " << trader.positions().size() << "\n";
-                    std::cout << "   Win Rate: " << std::setprecision(1)
-                              << (results.win_rate * 100) << "%\n\n";
+    ctx.pool.submit([&ctx, conn, id, date, params, progress_events, report_every, request_key, abort_flag]() {
+        auto t0 = std::chrono::steady_clock::now();
+        nlohmann::json response;
+        response["id"] = id;
+        response["date"] = date;
+        try {
+            TradingConfig cfg = apply_param_set(ctx.config.trading, params);
+            auto window = ctx.window_for(date);
+
+            RunOptions options;
+            options.cache = ctx.cache.get();
+            options.prefixes = &ctx.prefixes;
+            // Check for aborts (and vanished clients) at least every 30 bars,
+            // but only send the events the client asked for
+            options.report_every_bars = (progress_events && report_every > 0) ? report_every : 30;
+            options.on_progress = [&](const RunProgress& p) {
+                if (progress_events && (p.end_of_day || report_every > 0)) {
+                    conn->send({{"id", id}, {"event", "progress"}, {"step", p.step}, {"bar", p.bar},
+                                {"total_bars", p.total_bars}, {"days", p.days_completed},
+                                {"end_of_day", p.end_of_day}, {"equity", p.equity},
+                                {"total_return", p.total_return}, {"day_return", p.day_return},
+                                {"total_trades", p.total_trades}, {"max_drawdown", p.max_drawdown}});
                 }
+                return !abort_flag->load() && !conn->broken();
+            };
 
-            } catch (const nlohmann::json::exception& e) {
-                std::cerr << "⚠️  JSON parse error: " << e.what() << "\n";
-                write_runtime_failure_report("WARN", std::string("json_exception: ") + e.what(), line);
-                continue;
-            } catch (const std::exception& e) {
-                std::cerr << "⚠️  Error processing bar: " << e.what() << "\n";
-                write_runtime_failure_report("WARN", std::string("exception: ") + e.what(), line);
-                continue;
-            } catch (...) {
-                std::cerr << "⚠️  Unknown error processing bar\n";
-                write_runtime_failure_report("WARN", "unknown_exception", line);
-                continue;
+            RunInfo info;
+            if (abort_flag->load()) {
+                info.aborted = true;   // Aborted while queued: nothing to run
+            } else {
+                response.update(results_to_json(BacktestRunner::run(*window, cfg, options, &info)));
             }
+            response["cached"] = info.from_cache;
+            if (info.aborted) {
+                response["aborted"] = true;
+                ctx.aborted++;
+            } else {
+                ctx.evaluated++;
+            }
+        } catch (const std::exception& e) {
+            response["error"] = e.what();
+            ctx.failed++;
         }
+        conn->untrack(request_key, abort_flag);
+        response["elapsed_ms"] = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - t0).count();
+        conn->send(response);
+    });
+}
 
-        // End of day - show final results
-        std::cout << "\n═══════════════════════════════════════════════════════════════\n";
-        std::cout << "🏁 LIVE SESSION COMPLETE\n\n";
-
-        // Note: EOD liquidation is handled automatically by the trader's
-        // internal logic when it detects end of day timestamp
-
-        // Get final results
-        auto results = trader.get_results();
-        double final_equity = trader.get_equity(market_snapshot);
-
-        // Show open positions if any remain
-        if (!trader.positions().empty()) {
-            std::cout << "⚠️  Open positions at session end: " << trader.positions().size() << "\n";
-            std::cout << "   (These will be automatically closed at market close)\n\n";
-        }
-
-        // Print results
-    std::cout << "\n";
-    std::cout << "╔════════════════════════════════════════════════════════════╗\n";
-        std::cout << "║                 LIVE SESSION Results                       ║\n";
-    std::cout << "╚════════════════════════════════════════════════════════════╝\n";
-    std::cout << "\n";
-
-        std::cout << "Session Summary:\n";
-        std::cout << "  Bars Processed:     " << bars_processed << "\n";
-        std::cout << "  Snapshots:          " << snapshots_processed << "\n";
-        std::cout << "\n";
+/**
+ * Read requests from one connection until EOF or server shutdown
+ */
+void serve_connection(ServeContext& ctx, std::shared_ptr<ServeConnection> conn) {
+    conn->send({{"event", "ready"}, {"date", ctx.default_date},
+                {"threads", ctx.pool.size()}, {"symbols", ctx.config.symbols}});
+
+    std::string line;
+    while (!ctx.stopping) {
+        auto status = conn->reader().next(line, 200);
+        if (status == FdLineReader::Status::CLOSED) break;
+        if (status == FdLineReader::Status::TIMEOUT) continue;
+        if (line.find_first_not_of(" \t\r") == std::string::npos) continue;
+        handle_serve_request(ctx, conn, line);
+    }
+}
 
-        std::cout << std::fixed << std::setprecision(2);
-        std::cout << "Performance:\n";
-        std::cout << "  Initial Capital:    $" << config.capital << "\n";
-        std::cout << "  Final Equity:       $" << final_equity << "\n";
-        std::cout << "  Total Return:       " << std::showpos << (results.total_return * 100)
-                  << std::noshowpos << "%\n";
-        std::cout << "\n";
+int run_serve_mode(Config& config) {
+    try {
+        // Peers that disconnect mid-response must not kill the server
+        std::signal(SIGPIPE, SIG_IGN);
 
-        std::cout << "Trade Statistics:\n";
-        std::cout << "  Total Trades:       " << results.total_trades << "\n";
-        std::cout << "  Winning Trades:     " << results.winning_trades << "\n";
-        std::cout << "  Losing Trades:      " << results.losing_trades << "\n";
-        std::cout << std::setprecision(1);
-        std::cout << "  Win Rate:           " << (results.win_rate * 100) << "%\n";
-        std::cout << std::setprecision(2);
-        if (results.total_trades > 0) {
-            std::cout << "  Average Win:        $" << results.avg_win << "\n";
-            std::cout << "  Average Loss:       $" << results.avg_loss << "\n";
-            std::cout << "  Profit Factor:      " << results.profit_factor << "\n";
-        }
-        std::cout << "\n";
+        size_t num_threads = (config.threads > 0)
+            ? static_cast<size_t>(config.threads)
+            : utils::ThreadPool::default_threads();
+        ServeContext ctx(config, num_threads);
+        ctx.cache = open_result_cache(config);
 
-        // Export results and trades for dashboard/reporting
-        try {
-            // Build symbols string
-            std::string symbols_str;
-            for (size_t i = 0; i < config.symbols.size(); ++i) {
-                symbols_str += config.symbols[i];
-                if (i < config.symbols.size() - 1) symbols_str += ",";
+        std::cout << "Loading market data from " << config.data_dir << "...\n";
+        auto start_load = std::chrono::steady_clock::now();
+        ctx.all_data = DataLoader::load_from_directory(config.data_dir, config.symbols, config.extension);
+        ctx.default_date = config.test_date.empty() ? get_most_recent_date(ctx.all_data) : config.test_date;
+
+        // Build the default window up front so the first trial pays no setup cost
+        auto window = ctx.window_for(ctx.default_date);
+        auto load_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start_load).count();
+        std::cout << "✅ Resident: " << config.symbols.size() << " symbols, default window "
+                  << ctx.default_date << " (" << window->size() << " bars, " << load_ms << "ms)\n";
+
+        if (config.serve_socket.empty()) {
+            // stdin/stdout transport: one client (the parent process)
+            std::cout << "🛰️  Serving NDJSON on stdin/stdout with " << num_threads << " threads\n";
+            serve_connection(ctx, std::make_shared<ServeConnection>(STDIN_FILENO, STDOUT_FILENO, false));
+            ctx.pool.wait_idle();
+        } else {
+            int listen_fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+            if (listen_fd < 0) {
+                throw std::runtime_error(std::string("socket() failed: ") + std::strerror(errno));
             }
 
-            // Derive session date range from last_update_time timestamps
-            std::string start_date_str;
-            std::string end_date_str;
-            if (!last_update_time.empty()) {
-                auto minmax = std::minmax_element(
-                    last_update_time.begin(), last_update_time.end(),
-                    [](const auto& a, const auto& b){ return a.second < b.second; }
-                );
-                auto to_date = [](const Timestamp& ts){
-                    auto secs = std::chrono::duration_cast<std::chrono::seconds>(ts.time_since_epoch()).count();
-                    time_t t = static_cast<time_t>(secs);
-                    struct tm* tm_info = localtime(&t);
-                    char buf[11];
-                    strftime(buf, sizeof(buf), "%Y-%m-%d", tm_info);
-                    return std::string(buf);
-                };
-                start_date_str = to_date(minmax.first->second);
-                end_date_str = to_date(minmax.second->second);
+            struct sockaddr_un addr = {};
+            addr.sun_family = AF_UNIX;
+            if (config.serve_socket.size() >= sizeof(addr.sun_path)) {
+                ::close(listen_fd);
+                throw std::runtime_error("Socket path too long: " + config.serve_socket);
+            }
+            std::strncpy(addr.sun_path, config.serve_socket.c_str(), sizeof(addr.sun_path) - 1);
+            ::unlink(config.serve_socket.c_str());  // Stale socket from a previous run
+
+            if (::bind(listen_fd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) < 0 ||
+                ::listen(listen_fd, 16) < 0) {
+                std::string err = std::strerror(errno);
+                ::close(listen_fd);
+                throw std::runtime_error("Cannot listen on " + config.serve_socket + ": " + err);
             }
+            std::cout << "🛰️  Serving NDJSON on unix:" << config.serve_socket
+                      << " with " << num_threads << " threads\n";
+
+            struct ClientThread {
+                std::thread thread;
+                std::shared_ptr<std::atomic<bool>> done;
+            };
+            std::vector<ClientThread> clients;
+
+            while (!ctx.stopping) {
+                // Reap clients that disconnected
+                for (auto it = clients.begin(); it != clients.end();) {
+                    if (it->done->load()) {
+                        it->thread.join();
+                        it = clients.erase(it);
+                    } else {
+                        ++it;
+                    }
+                }
 
-            // Empty filtered bars placeholder (dashboard can load from data directory)
-            std::unordered_map<Symbol, std::vector<Bar>> empty_filtered;
+                struct pollfd pfd = {listen_fd, POLLIN, 0};
+                int ready = ::poll(&pfd, 1, 200);
+                if (ready <= 0) continue;
 
-            ResultsExporter::export_json(
-                results, trader, config.results_file,
-                symbols_str, "LIVE",
-                start_date_str, end_date_str,
-                empty_filtered
-            );
+                int client_fd = ::accept(listen_fd, nullptr, nullptr);
+                if (client_fd < 0) continue;
 
-            export_trades_jsonl(trader, config.trades_file);
+                auto conn = std::make_shared<ServeConnection>(client_fd, client_fd, true);
+                auto done = std::make_shared<std::atomic<bool>>(false);
+                clients.push_back({std::thread([&ctx, conn, done]() {
+                    serve_connection(ctx, conn);
+                    done->store(true);
+                }), done});
+            }
 
-            std::cout << "\n✅ Results exported to: " << config.results_file << "\n";
-            std::cout << "✅ Trades exported to: " << config.trades_file << "\n";
-        } catch (const std::exception& e) {
-            std::cerr << "⚠️  Live export failed: " << e.what() << "\n";
+            ::close(listen_fd);
+            ::unlink(config.serve_socket.c_str());
+            for (auto& client : clients) client.thread.join();
+            ctx.pool.wait_idle();
         }
 
+        std::cout << "\n✅ Serve finished: " << ctx.evaluated.load() << " evaluations";
+        if (ctx.aborted.load() > 0) std::cout << " (" << ctx.aborted.load() << " aborted)";
+        if (ctx.failed.load() > 0) std::cout << " (" << ctx.failed.load() << " failed)";
+        std::cout << "\n";
+        print_cache_stats(ctx.cache.get());
         return 0;
 
     } catch (const std::exception& e) {
+        std::cerr << "\n❌ Error in serve mode: " << e.what() << "\n\n";
+        return 1;
+    }
+}
+
+int run_live_mode(Config& config) {
+    std::cout << "\n";
+    std::cout << "╔════════════════════════════════════════════════════════════╗\n";
+    std::cout << "║         LIVE MODE - Real-Time Paper Trading                ║\n";
+    std::cout << "╚════════════════════════════════════════════════════════════╝\n";
+    std::cout << "\n";
+
+    std::cout << "🟢 Starting LIVE trading session...\n\n";
+
+    LiveConfig live;
+    live.symbols = config.symbols;
+    live.capital = config.capital;
+    live.verbose = config.verbose;
+    live.trading = config.trading;
+    live.feed = config.feed;
+    live.replay_speed = config.replay_speed;
+    live.zmq_url = config.zmq_url;
+    live.data_dir = config.data_dir;
+    live.extension = config.extension;
+    live.warmup_bars = config.warmup_bars;
+    live.snapshot_deadline_ms = config.snapshot_deadline_ms;
+    live.latency_budget_ms = config.latency_budget_ms;
+    live.metrics_file = config.metrics_file;
+    live.metrics_interval_ms = config.metrics_interval_ms;
+    live.order_gateway = config.order_gateway;
+    live.config_dir = config.config_dir;
+    live.hot_reload = config.hot_reload;
+    live.state_dir = config.state_dir;
+    live.checkpoint_interval = config.checkpoint_interval;
+    live.resume = config.resume;
+    live.instances = config.instances;
+    live.pin_ingest_core = config.pin_ingest_core;
+    live.pin_decision_core = config.pin_decision_core;
+    live.pin_report_core = config.pin_report_core;
+    live.results_file = config.results_file;
+    live.trades_file = config.trades_file;
+
+    // Replay feed: the test day comes from the binary store; everything
+    // before it warms the trader directly, exactly as in mock mode
+    if (live.feed == "replay") {
+        std::cout << "Loading replay data from " << config.data_dir << "...\n";
         try {
-            std::filesystem::create_directories("logs/live");
-            auto now = std::chrono::system_clock::now();
-            std::time_t tnow = std::chrono::system_clock::to_time_t(now);
-            char tsbuf[20];
-            std::strftime(tsbuf, sizeof(tsbuf), "%Y%m%d_%H%M%S", std::localtime(&tnow));
-            std::ofstream out(std::string("logs/live/failure_FATAL_") + tsbuf + ".log");
-            out << "severity: FATAL\n";
-            out << "message: " << e.what() << "\n";
-            out.close();
-            std::cerr << "\n❌ Error in live mode: " << e.what() << " (report written)\n\n";
-        } catch (...) {
+            auto all_data = DataLoader::load_from_directory(config.data_dir, config.symbols, config.extension);
+            if (config.test_date.empty()) config.test_date = get_most_recent_date(all_data);
+            live.replay_window = build_replay_window(config, all_data, config.test_date);
+        } catch (const std::exception& e) {
             std::cerr << "\n❌ Error in live mode: " << e.what() << "\n\n";
+            return 1;
         }
-    return 1;
     }
+    return run_live_session(live).exit_code;
 }
 
 int main(int argc, char* argv[]) {
     Config config;
 
+    // Serve mode over stdin/stdout owns stdout for the protocol - send all
+    // human-readable output (banner, config dump, progress) to stderr instead
+    if (argc > 1 && std::string(argv[1]) == "serve") {
+        std::cout.rdbuf(std::cerr.rdbuf());
+    }
+
     if (!parse_args(argc, argv, config)) {
         print_usage(argv[0]);
         return 1;
@@ -1425,9 +2642,11 @@ int main(int argc, char* argv[]) {
 
     // 1. No simulation period in SIGOR-only build
 
-    // 2. For MOCK mode, require --date (SINGLE DAY ONLY)
+    // 2. For MOCK mode, require --date (SINGLE DAY ONLY; serve defaults to the latest day)
     if (config.mode == TradingMode::MOCK) {
-        if (config.test_date.empty()) {
+        if (config.test_date.empty() && config.mode_str != "serve" &&
+            config.mode_str != "walkforward" && config.mode_str != "optimize" &&
+            config.mode_str != "sensitivity") {
             std::cerr << "❌ ERROR: Mock mode requires --date MM-DD\n";
             std::cerr << "\nExample:\n";
             std::cerr << "  " << argv[0] << " mock --date 10-21\n";
@@ -1471,7 +2690,19 @@ int main(int argc, char* argv[]) {
 
     // Print configuration
     std::cout << "Configuration:\n";
-    std::cout << "  Mode: " << to_string(config.mode);
+    if (config.mode_str == "sweep") {
+        std::cout << "  Mode: SWEEP";
+    } else if (config.mode_str == "walkforward") {
+        std::cout << "  Mode: WALKFORWARD (" << config.start_date << " → " << config.end_date << ")";
+    } else if (config.mode_str == "optimize") {
+        std::cout << "  Mode: OPTIMIZE (" << config.algorithm << ")";
+    } else if (config.mode_str == "sensitivity") {
+        std::cout << "  Mode: SENSITIVITY (±" << config.steps << " × " << config.delta << ")";
+    } else if (config.mode_str == "serve") {
+        std::cout << "  Mode: SERVE";
+    } else {
+        std::cout << "  Mode: " << to_string(config.mode);
+    }
     if (config.mode == TradingMode::LIVE) {
         std::cout << " (⚠️  NOT YET IMPLEMENTED)";
     }
@@ -1497,7 +2728,17 @@ int main(int argc, char* argv[]) {
     std::cout << "\n";
 
     // Run appropriate mode
-    if (config.mode == TradingMode::MOCK) {
+    if (config.mode_str == "sweep") {
+        return run_sweep_mode(config);
+    } else if (config.mode_str == "walkforward") {
+        return run_walkforward_mode(config);
+    } else if (config.mode_str == "optimize") {
+        return run_optimize_mode(config);
+    } else if (config.mode_str == "sensitivity") {
+        return run_sensitivity_mode(config);
+    } else if (config.mode_str == "serve") {
+        return run_serve_mode(config);
+    } else if (config.mode == TradingMode::MOCK) {
         return run_mock_mode(config);
     } else if (config.mode == TradingMode::MOCK_LIVE) {
         // Mock-live uses the exact same live loop, but the FIFO is fed by a replay bridge
@@ -3,13 +3,20 @@
 #include <algorithm>
 #include <limits>
 #include <chrono>
+#include <stdexcept>
 
 namespace trading {
 
 SigorStrategy::SigorStrategy(const SigorConfig& config)
-    : config_(config) {}
+    : config_(config) {
+    // Room for one bar past the trim bound, so the history buffers never reallocate
+    for (auto* vec : {&closes_, &highs_, &lows_, &volumes_, &gains_, &losses_}) {
+        vec->reserve(MAX_HISTORY + 1);
+    }
+    timestamps_.reserve(MAX_HISTORY + 1);
+}
 
-SigorSignal SigorStrategy::generate_signal(const Bar& bar, const std::string& symbol, int bar_index_of_day) {
+SigorSignal SigorStrategy::generate_signal(const Bar& bar, int bar_index_of_day) {
     // Update history
     closes_.push_back(bar.close);
     highs_.push_back(bar.high);
@@ -33,11 +40,10 @@ SigorSignal SigorStrategy::generate_signal(const Bar& bar, const std::string& sy
 
     bar_count_++;
 
-    // Keep buffers bounded (2048 bars max)
-    const size_t max_history = 2048;
-    auto trim = [max_history](auto& vec) {
-        if (vec.size() > max_history) {
-            vec.erase(vec.begin(), vec.begin() + (vec.size() - max_history));
+    // Keep buffers bounded (MAX_HISTORY bars, capacity reserved up front)
+    auto trim = [](auto& vec) {
+        if (vec.size() > MAX_HISTORY) {
+            vec.erase(vec.begin(), vec.begin() + (vec.size() - MAX_HISTORY));
         }
     };
     trim(closes_);
@@ -64,7 +70,6 @@ SigorSignal SigorStrategy::generate_signal(const Bar& bar, const std::string& sy
     // Create signal
     SigorSignal signal;
     signal.timestamp = bar.timestamp;
-    signal.symbol = symbol;
     signal.probability = p_final;
     signal.confidence = c_final;
     signal.is_long = p_final > 0.52;      // Slight threshold above 0.5
@@ -104,6 +109,60 @@ void SigorStrategy::reset() {
     rsi_initialized_ = false;
 }
 
+void SigorStrategy::reconfigure(const SigorConfig& config) {
+    for (int window : {config.win_boll, config.win_rsi, config.win_mom, config.win_vwap,
+                       config.orb_opening_bars, config.vol_window}) {
+        if (window < 1 || static_cast<size_t>(window) >= MAX_HISTORY) {
+            throw std::runtime_error("SIGOR window out of range: " + std::to_string(window));
+        }
+    }
+    if (config.win_rsi != config_.win_rsi) {
+        avg_gain_ = 0.0;
+        avg_loss_ = 0.0;
+        rsi_initialized_ = false;
+    }
+    config_ = config;
+}
+
+void SigorStrategy::save_state(utils::BinaryWriter& out) const {
+    out.put(config_);
+    out.put_vector(closes_);
+    out.put_vector(highs_);
+    out.put_vector(lows_);
+    out.put_vector(volumes_);
+    out.put_vector(timestamps_);
+    out.put_vector(gains_);
+    out.put_vector(losses_);
+    out.put(bar_count_);
+    out.put(orb_high_);
+    out.put(orb_low_);
+    out.put(last_processed_bar_index_);
+    out.put(avg_gain_);
+    out.put(avg_loss_);
+    out.put(rsi_initialized_);
+}
+
+void SigorStrategy::load_state(utils::BinaryReader& in) {
+    // Detector buffers are only meaningful for the windows they were built with
+    if (in.get<SigorConfig>() != config_) {
+        throw std::runtime_error("SIGOR checkpoint was taken with a different configuration");
+    }
+    in.get_vector(closes_);
+    in.get_vector(highs_);
+    in.get_vector(lows_);
+    in.get_vector(volumes_);
+    in.get_vector(timestamps_);
+    in.get_vector(gains_);
+    in.get_vector(losses_);
+    in.get(bar_count_);
+    in.get(orb_high_);
+    in.get(orb_low_);
+    in.get(last_processed_bar_index_);
+    in.get(avg_gain_);
+    in.get(avg_loss_);
+    in.get(rsi_initialized_);
+}
+
 // ===== DETECTOR IMPLEMENTATIONS =====
 
 double SigorStrategy::prob_bollinger_(const Bar& bar) const {
@@ -0,0 +1,121 @@
+/**
+ * Steady-state on_bar allocation test
+ *
+ * Replaces global operator new/delete with counting versions, runs a trader
+ * through one warmup session of synthetic bars, then fails if any later bar
+ * allocates or frees heap memory. Run by ctest (on_bar_allocations).
+ */
+#include "bench_common.h"
+#include "synthetic_market.h"
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+std::atomic<bool> g_counting{false};
+std::atomic<uint64_t> g_news{0};
+std::atomic<uint64_t> g_deletes{0};
+}
+
+void* operator new(std::size_t size) {
+    if (g_counting.load(std::memory_order_relaxed)) g_news.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    if (g_counting.load(std::memory_order_relaxed)) g_news.fetch_add(1, std::memory_order_relaxed);
+    return std::malloc(size ? size : 1);
+}
+
+void operator delete(void* p) noexcept {
+    if (p && g_counting.load(std::memory_order_relaxed)) g_deletes.fetch_add(1, std::memory_order_relaxed);
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept { operator delete(p); }
+
+using namespace trading;
+
+namespace {
+
+using Snapshot = std::unordered_map<Symbol, Bar>;
+
+std::vector<Snapshot> build_snapshots(const std::vector<Symbol>& symbols, const SyntheticMarketConfig& market) {
+    auto regimes = generate_regime_path(market);
+    std::vector<Snapshot> snapshots(market.days * market.bars_per_day);
+    for (size_t s = 0; s < symbols.size(); ++s) {
+        auto bars = generate_synthetic_bars(symbols[s], s, market, regimes);
+        for (size_t i = 0; i < bars.size() && i < snapshots.size(); ++i) {
+            snapshots[i][symbols[s]] = bars[i];
+        }
+    }
+    return snapshots;
+}
+
+/**
+ * Run one session of warmup, then count heap calls over the remaining bars
+ * @return true if no steady-state bar allocated
+ */
+bool run_case(const std::string& name, const std::vector<Symbol>& symbols) {
+    SyntheticMarketConfig market;
+    market.days = 4;
+    auto snapshots = build_snapshots(symbols, market);
+
+    MultiSymbolTrader trader(symbols, bench_trading_config());
+    size_t warmup_bars = static_cast<size_t>(market.bars_per_day);
+    for (size_t i = 0; i < warmup_bars; ++i) trader.on_bar(snapshots[i]);
+
+    size_t dirty_bars = 0;
+    size_t first_dirty = 0;
+    uint64_t news = 0;
+    uint64_t deletes = 0;
+    for (size_t i = warmup_bars; i < snapshots.size(); ++i) {
+        g_news = 0;
+        g_deletes = 0;
+        g_counting = true;
+        trader.on_bar(snapshots[i]);
+        g_counting = false;
+        if (g_news || g_deletes) {
+            if (dirty_bars++ == 0) first_dirty = i;
+            news += g_news;
+            deletes += g_deletes;
+        }
+    }
+
+    auto results = trader.get_results();
+    std::cout << "  " << name << ": " << symbols.size() << " symbols, "
+              << (snapshots.size() - warmup_bars) << " steady-state bars, "
+              << results.total_trades << " trades -> ";
+    if (results.total_trades == 0) {
+        std::cout << "FAIL (no trades: entry/exit paths not exercised)\n";
+        return false;
+    }
+    if (dirty_bars > 0) {
+        std::cout << "FAIL (" << dirty_bars << " bars allocated; first at bar " << first_dirty
+                  << "; " << news << " new, " << deletes << " delete)\n";
+        return false;
+    }
+    std::cout << "OK (0 allocations)\n";
+    return true;
+}
+
+} // namespace
+
+int main() {
+    use_market_timezone();
+
+    std::cout << "on_bar steady-state allocation test\n";
+    bool ok = true;
+    ok &= run_case("synthetic", synthetic_symbols(12));
+    // Leveraged pairs exercise the inverse-substitution and pair-blocking paths
+    ok &= run_case("inverse pairs", {"TQQQ", "SQQQ", "TNA", "TZA", "SOXL", "SOXS",
+                                     "UVXY", "SVIX", "FAS", "FAZ", "SPXL", "SPXS"});
+
+    std::cout << (ok ? "PASSED" : "FAILED") << "\n";
+    return ok ? 0 : 1;
+}
@@ -180,7 +180,7 @@ int main(int argc, char** argv) {
         auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(duration).count();
         int bar_index_of_day = utils::get_bar_index_of_day(millis);
 
-        SigorSignal signal = sigor.generate_signal(bar, test_symbol, bar_index_of_day);
+        SigorSignal signal = sigor.generate_signal(bar, bar_index_of_day);
 
         // Count signal types
         if (signal.is_long) long_signals++;
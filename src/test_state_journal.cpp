@@ -0,0 +1,174 @@
+/**
+ * State journal round-trip test
+ *
+ * Runs a trader on synthetic bars while journaling it the way live mode
+ * does: trades spill to a file, and parameter reloads land on both sides of
+ * a checkpoint. The process "dies" right after the checkpoint rename but
+ * before the log truncate, so the log still holds minutes and reloads the
+ * checkpoint already covers, and the trade file holds trades from after it.
+ * The test restores from disk, then runs the restored trader side by side
+ * with a memory-only reference that saw the same bars and reloads. It fails
+ * unless their trades and every later decision are identical.
+ * Run by ctest (state_journal).
+ */
+#include "bench_common.h"
+#include "synthetic_market.h"
+#include "trading/state_journal.h"
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace trading;
+
+namespace {
+
+using Snapshot = std::unordered_map<Symbol, Bar>;
+
+std::vector<Snapshot> build_snapshots(const std::vector<Symbol>& symbols, const SyntheticMarketConfig& market) {
+    auto regimes = generate_regime_path(market);
+    std::vector<Snapshot> snapshots(market.days * market.bars_per_day);
+    for (size_t s = 0; s < symbols.size(); ++s) {
+        auto bars = generate_synthetic_bars(symbols[s], s, market, regimes);
+        for (size_t i = 0; i < bars.size() && i < snapshots.size(); ++i) {
+            snapshots[i][symbols[s]] = bars[i];
+        }
+    }
+    return snapshots;
+}
+
+std::string read_file(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+bool check(bool ok, const std::string& what) {
+    std::cout << "  " << what << " -> " << (ok ? "OK" : "FAIL") << "\n";
+    return ok;
+}
+
+} // namespace
+
+int main() {
+    use_market_timezone();
+    std::cout << "State journal round-trip test\n";
+
+    SyntheticMarketConfig market;
+    market.days = 3;
+    const auto symbols = synthetic_symbols(8);
+    const auto snapshots = build_snapshots(symbols, market);
+    const TradingConfig base = bench_trading_config();
+
+    char dir_template[] = "/tmp/sentio_state_journal_XXXXXX";
+    if (!mkdtemp(dir_template)) {
+        std::cerr << "Cannot create a temp directory\n";
+        return 1;
+    }
+    const std::string dir = dir_template;
+
+    // Minute i of the run is snapshots[i - 1]; reloads apply before their minute
+    const uint64_t warmup = static_cast<uint64_t>(market.bars_per_day);
+    const uint64_t checkpoint_at = warmup + 200;
+    const uint64_t crash_at = checkpoint_at + 60;
+    const std::unordered_map<uint64_t, int> reloads = {
+        {warmup + 50, 20}, {warmup + 120, 14},      // Covered by the checkpoint
+        {checkpoint_at + 30, 20},                   // Logged after it
+    };
+
+    // Small ring: the trade file, not memory, has to carry most of the history
+    TradingConfig live_config = base;
+    live_config.trade_journal_path = dir + "/trades.bin";
+    live_config.trade_journal_ring_size = 16;
+
+    MultiSymbolTrader trader(symbols, base);     // Reference, never crashes
+    bool ok = true;
+    {
+        MultiSymbolTrader live(symbols, live_config);
+        for (uint64_t i = 1; i <= warmup; ++i) {
+            trader.on_bar(snapshots[i - 1]);
+            live.on_bar(snapshots[i - 1]);
+        }
+
+        StateJournal journal(dir);
+        journal.write_checkpoint(StateJournal::encode_checkpoint(warmup, live));
+        for (uint64_t i = warmup + 1; i <= crash_at; ++i) {
+            auto reload = reloads.find(i);
+            if (reload != reloads.end()) {
+                TradingConfig config = live.config();
+                config.sigor_config.win_rsi = reload->second;
+                live.reconfigure(config);
+                config = trader.config();
+                config.sigor_config.win_rsi = reload->second;
+                trader.reconfigure(config);
+                journal.append(StateJournal::encode_reload(i, live.config()));
+            }
+            trader.on_bar(snapshots[i - 1]);
+            live.on_bar(snapshots[i - 1]);
+            journal.append(StateJournal::encode_minute(i, snapshots[i - 1], live));
+
+            if (i == checkpoint_at) {
+                // Crash window: checkpoint renamed into place, log not yet truncated
+                const std::string wal = read_file(dir + "/journal.wal");
+                journal.write_checkpoint(StateJournal::encode_checkpoint(i, live));
+                std::ofstream(dir + "/journal.wal", std::ios::binary | std::ios::app) << wal;
+            }
+        }
+    }
+
+    auto recovery = StateJournal::load(dir);
+    ok &= check(recovery.checkpoint_bar_id == checkpoint_at, "checkpoint minute");
+    ok &= check(recovery.skipped_records == (checkpoint_at - warmup) + 2,
+                "stale minutes and reloads skipped (" + std::to_string(recovery.skipped_records) + ")");
+    ok &= check(recovery.records.size() == (crash_at - checkpoint_at) + 1,
+                "records after the checkpoint kept (" + std::to_string(recovery.records.size()) + ")");
+
+    uint64_t last_bar_id = 0;
+    std::unique_ptr<MultiSymbolTrader> restored;
+    try {
+        restored = StateJournal::restore(recovery, live_config, last_bar_id);
+    } catch (const std::exception& e) {
+        std::cout << "  restore -> FAIL (" << e.what() << ")\n";
+        ok = false;
+    }
+
+    if (restored) {
+        ok &= check(last_bar_id == crash_at, "restored through the last logged minute");
+        ok &= check(StateJournal::Digest::of(*restored) == StateJournal::Digest::of(trader),
+                    "restored cash and positions match");
+
+        // The trade file was cut back to the checkpoint and continued, not duplicated
+        std::vector<TradeJournal::Record> expected_trades;
+        std::vector<TradeJournal::Record> restored_trades;
+        for (const auto& t : trader.trade_journal()) expected_trades.push_back(TradeJournal::Record::from_trade(t));
+        for (const auto& t : restored->trade_journal()) restored_trades.push_back(TradeJournal::Record::from_trade(t));
+        const bool same_trades = expected_trades.size() == restored_trades.size() &&
+            std::memcmp(expected_trades.data(), restored_trades.data(),
+                        expected_trades.size() * sizeof(TradeJournal::Record)) == 0;
+        ok &= check(restored->trade_journal().spilling() && same_trades && !expected_trades.empty(),
+                    "trade file resumed (" + std::to_string(restored_trades.size()) + " trades)");
+
+        // Indicator state must match too: every later decision has to agree
+        size_t diverged = 0;
+        for (uint64_t i = crash_at + 1; i <= snapshots.size(); ++i) {
+            trader.on_bar(snapshots[i - 1]);
+            restored->on_bar(snapshots[i - 1]);
+            if (!(StateJournal::Digest::of(*restored) == StateJournal::Digest::of(trader))) diverged++;
+        }
+        const auto expected = trader.get_results();
+        const auto actual = restored->get_results();
+        ok &= check(diverged == 0 && expected.total_trades > 0 && actual.total_trades == expected.total_trades &&
+                        actual.total_return == expected.total_return,
+                    "continued in lockstep (" + std::to_string(expected.total_trades) + " trades, " +
+                        std::to_string(diverged) + " minutes diverged)");
+    }
+
+    std::filesystem::remove_all(dir);
+    std::cout << (ok ? "PASSED" : "FAILED") << "\n";
+    return ok ? 0 : 1;
+}
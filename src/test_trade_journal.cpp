@@ -0,0 +1,114 @@
+/**
+ * Trade journal write-failure test
+ *
+ * Spills trades to a file, then caps the process file size (RLIMIT_FSIZE)
+ * so every later write fails the way a full disk does. The journal must keep
+ * the unwritten trades in memory (past its ring size, without blocking),
+ * report the error, keep its checkpoint exact, and write everything once
+ * the limit is lifted. Run by ctest (trade_journal).
+ */
+#include "trading/trade_journal.h"
+#include <csignal>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <sys/resource.h>
+
+using namespace trading;
+
+namespace {
+
+TradeRecord make_trade(int i) {
+    return TradeRecord(i * 1.5, i * 0.001, Timestamp(std::chrono::minutes(i)),
+                       Timestamp(std::chrono::minutes(i + 5)), "SYM" + std::to_string(i % 7),
+                       10 + i, 100.0 + i, 101.0 + i, static_cast<uint64_t>(i),
+                       static_cast<uint64_t>(i + 5), static_cast<size_t>(i));
+}
+
+bool check(bool ok, const std::string& what) {
+    std::cout << "  " << what << " -> " << (ok ? "OK" : "FAIL") << "\n";
+    return ok;
+}
+
+bool set_file_limit(rlim_t limit) {
+    struct rlimit rl;
+    if (::getrlimit(RLIMIT_FSIZE, &rl) != 0) return false;
+    rl.rlim_cur = std::min(limit, rl.rlim_max);
+    return ::setrlimit(RLIMIT_FSIZE, &rl) == 0;
+}
+
+} // namespace
+
+int main() {
+    std::cout << "Trade journal write-failure test\n";
+    std::signal(SIGXFSZ, SIG_IGN);     // Failed writes return EFBIG instead of killing us
+
+    char dir_template[] = "/tmp/sentio_trade_journal_XXXXXX";
+    if (!mkdtemp(dir_template)) {
+        std::cerr << "Cannot create a temp directory\n";
+        return 1;
+    }
+    const std::string dir = dir_template;
+    const std::string path = dir + "/trades.bin";
+    const size_t record = sizeof(TradeJournal::Record);
+
+    constexpr int kBefore = 5;
+    constexpr int kDuring = 30;         // Well past the 8-slot ring
+    bool ok = true;
+    {
+        TradeJournal journal(8);
+        journal.open_spill(path);
+        for (int i = 0; i < kBefore; ++i) journal.append(make_trade(i));
+        journal.flush();
+        const auto durable = std::filesystem::file_size(path);
+        ok &= check(durable == TradeJournal::kHeaderSize + kBefore * record, "first trades on disk");
+
+        // "Disk full": nothing more may be written
+        if (!set_file_limit(durable)) {
+            std::cerr << "Cannot lower RLIMIT_FSIZE\n";
+            return 1;
+        }
+        for (int i = kBefore; i < kBefore + kDuring; ++i) journal.append(make_trade(i));
+
+        bool flush_threw = false;
+        try {
+            journal.flush();
+        } catch (const std::exception&) {
+            flush_threw = true;
+        }
+        ok &= check(flush_threw && !journal.write_error().empty(),
+                    "failure reported (" + journal.write_error() + ")");
+        const auto cp = journal.checkpoint();
+        ok &= check(cp.persisted == kBefore && cp.pending.size() == kDuring,
+                    "checkpoint counts only durable trades (" + std::to_string(cp.persisted) + " + " +
+                        std::to_string(cp.pending.size()) + " pending)");
+
+        // Disk has room again: the retry writes everything
+        set_file_limit(RLIM_INFINITY);
+        bool flushed = true;
+        try {
+            journal.flush();
+        } catch (const std::exception& e) {
+            std::cout << "  flush after recovery: " << e.what() << "\n";
+            flushed = false;
+        }
+        ok &= check(flushed && journal.write_error().empty(), "retry succeeded");
+        ok &= check(std::filesystem::file_size(path) == TradeJournal::kHeaderSize + (kBefore + kDuring) * record,
+                    "every trade on disk");
+
+        int index = 0;
+        bool same = true;
+        for (const TradeRecord& t : journal) {
+            const TradeRecord expected = make_trade(index++);
+            same &= t.pnl == expected.pnl && t.symbol == expected.symbol && t.shares == expected.shares &&
+                    t.exit_bar_id == expected.exit_bar_id;
+        }
+        ok &= check(same && index == kBefore + kDuring,
+                    "history intact (" + std::to_string(index) + " trades)");
+    }
+
+    std::filesystem::remove_all(dir);
+    std::cout << (ok ? "PASSED" : "FAILED") << "\n";
+    return ok ? 0 : 1;
+}
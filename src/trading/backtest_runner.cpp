@@ -0,0 +1,310 @@
+#include "trading/backtest_runner.h"
+#include "trading/result_cache.h"
+#include "utils/fingerprint.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <stdexcept>
+
+namespace trading {
+
+ReplayWindow ReplayWindow::from_bars(const std::vector<Symbol>& symbols,
+                                     const std::unordered_map<Symbol, std::vector<Bar>>& bars,
+                                     size_t warmup_bars,
+                                     const std::string& test_date,
+                                     int sim_days) {
+    ReplayWindow window;
+    window.symbols = symbols;
+    window.warmup_bars = warmup_bars;
+    window.sim_days = sim_days;
+    window.test_date = test_date;
+
+    size_t num_bars = 0;
+    for (size_t s = 0; s < symbols.size(); ++s) {
+        auto it = bars.find(symbols[s]);
+        if (it == bars.end()) {
+            throw std::runtime_error("Replay window: no bars for symbol " + symbols[s]);
+        }
+        if (s == 0) {
+            num_bars = it->second.size();
+        } else if (it->second.size() != num_bars) {
+            throw std::runtime_error("Replay window: symbol " + symbols[s] + " has " +
+                                     std::to_string(it->second.size()) + " bars, expected " +
+                                     std::to_string(num_bars));
+        }
+    }
+
+    utils::Fingerprint fp;
+    window.snapshots.resize(num_bars);
+    for (size_t i = 0; i < num_bars; ++i) {
+        auto& snapshot = window.snapshots[i];
+        snapshot.reserve(symbols.size());
+        for (const auto& symbol : symbols) {
+            const Bar& bar = bars.at(symbol)[i];
+            fp.add_string(symbol);
+            fp.add_value(bar.timestamp.time_since_epoch().count());
+            fp.add_value(bar.open);
+            fp.add_value(bar.high);
+            fp.add_value(bar.low);
+            fp.add_value(bar.close);
+            fp.add_value(bar.volume);
+            snapshot.emplace(symbol, bar);
+        }
+    }
+    window.data_fingerprint = fp.value();
+    return window;
+}
+
+TradingConfig BacktestRunner::prepare_config(TradingConfig config, const ReplayWindow& window) {
+    // Same structure as MOCK mode: [warmup_bars] + [sim_bars] + [test_bars]
+    config.min_bars_to_learn = window.warmup_bars;
+
+    int warmup_days = static_cast<int>((window.warmup_bars + config.bars_per_day - 1) / config.bars_per_day);
+    config.warmup.observation_days = warmup_days;
+    config.warmup.simulation_days = window.sim_days;
+    config.warmup.skip_validation = true;  // Always proceed to test day
+    return config;
+}
+
+std::string PrefixCache::prefix_key(const ReplayWindow& window, const TradingConfig& c) {
+    std::string key;
+    auto add = [&key](const char* name, double v) {
+        char buf[80];
+        std::snprintf(buf, sizeof(buf), "%s=%.17g\n", name, v);
+        key += buf;
+    };
+
+    char data_hex[40];
+    std::snprintf(data_hex, sizeof(data_hex), "data=%016llx\n",
+                  static_cast<unsigned long long>(window.data_fingerprint));
+    key += data_hex;
+    for (const auto& symbol : window.symbols) {
+        key += symbol;
+        key += ',';
+    }
+    key += '\n';
+    add("warmup_bars", static_cast<double>(window.warmup_bars));
+
+    // Config fields read before the first trade (see MultiSymbolTrader::on_bar)
+    add("strategy", static_cast<int>(c.strategy));
+    add("min_bars_to_learn", static_cast<double>(c.min_bars_to_learn));
+    add("initial_capital", c.initial_capital);
+    add("default_avg_volume", c.default_avg_volume);
+    add("default_volatility", c.default_volatility);
+
+    const auto& s = c.sigor_config;
+    add("sigor.k", s.k);
+    add("sigor.w_boll", s.w_boll);
+    add("sigor.w_rsi", s.w_rsi);
+    add("sigor.w_mom", s.w_mom);
+    add("sigor.w_vwap", s.w_vwap);
+    add("sigor.w_orb", s.w_orb);
+    add("sigor.w_ofi", s.w_ofi);
+    add("sigor.w_vol", s.w_vol);
+    add("sigor.win_boll", s.win_boll);
+    add("sigor.win_rsi", s.win_rsi);
+    add("sigor.win_mom", s.win_mom);
+    add("sigor.win_vwap", s.win_vwap);
+    add("sigor.orb_opening_bars", s.orb_opening_bars);
+    add("sigor.vol_window", s.vol_window);
+    add("sigor.warmup_bars", s.warmup_bars);
+    return key;
+}
+
+std::shared_ptr<const MultiSymbolTrader> PrefixCache::get(const ReplayWindow& window,
+                                                          const TradingConfig& prepared_config) {
+    std::string key = prefix_key(window, prepared_config);
+
+    std::promise<std::shared_ptr<const MultiSymbolTrader>> promise;
+    Entry entry;
+    bool owner = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = entries_.find(key);
+        if (it != entries_.end()) {
+            hits_++;
+            entry = it->second;
+        } else {
+            misses_++;
+            if (entries_.size() >= max_entries_) {
+                entries_.clear();   // Forks in flight keep their prefixes alive
+            }
+            entry = promise.get_future().share();
+            entries_.emplace(key, entry);
+            owner = true;
+        }
+    }
+
+    if (owner) {
+        // Replay the non-trading prefix once; other requests wait on the future
+        try {
+            TradingConfig config = prepared_config;
+            config.quiet = true;
+            config.trade_journal_path.clear();
+            auto trader = std::make_shared<MultiSymbolTrader>(window.symbols, config);
+            size_t prefix_bars = std::min(window.warmup_bars, window.size());
+            for (size_t i = 0; i < prefix_bars; ++i) {
+                trader->on_bar(window.snapshots[i]);
+            }
+            promise.set_value(std::move(trader));
+        } catch (...) {
+            promise.set_exception(std::current_exception());
+        }
+    }
+    return entry.get();
+}
+
+MultiSymbolTrader::BacktestResults BacktestRunner::run(const ReplayWindow& window,
+                                                       const TradingConfig& config,
+                                                       ResultCache* cache,
+                                                       bool* from_cache,
+                                                       PrefixCache* prefixes) {
+    RunOptions options;
+    options.cache = cache;
+    options.prefixes = prefixes;
+    RunInfo info;
+    auto results = run(window, config, options, &info);
+    if (from_cache) *from_cache = info.from_cache;
+    return results;
+}
+
+MultiSymbolTrader::BacktestResults BacktestRunner::run(const ReplayWindow& window,
+                                                       const TradingConfig& config,
+                                                       const RunOptions& options,
+                                                       RunInfo* info) {
+    TradingConfig prepared = prepare_config(config, window);
+    prepared.quiet = true;
+    RunInfo local_info;
+    RunInfo& status = info ? *info : local_info;
+    status = RunInfo();
+
+    std::string key;
+    if (options.cache) {
+        key = ResultCache::make_key(window, prepared);
+        MultiSymbolTrader::BacktestResults cached;
+        if (options.cache->lookup(key, cached)) {
+            status.from_cache = true;
+            return cached;
+        }
+    }
+
+    // The warmup bars never trade (min_bars_to_learn == warmup_bars), so their
+    // state can come from a shared prefix; otherwise replay from the first bar
+    std::unique_ptr<MultiSymbolTrader> trader;
+    if (options.prefixes && window.warmup_bars > 0) {
+        trader = options.prefixes->get(window, prepared)->fork(prepared);
+    } else {
+        trader = std::make_unique<MultiSymbolTrader>(window.symbols, prepared);
+    }
+
+    for (size_t i = trader->bars_seen(); i < window.size(); ++i) {
+        size_t days_before = trader->daily_results().size();
+        trader->on_bar(window.snapshots[i]);
+        if (!options.on_progress) continue;
+
+        size_t bar = i + 1;
+        bool end_of_day = trader->daily_results().size() > days_before;
+        bool interval = options.report_every_bars > 0 && bar > window.warmup_bars &&
+                        (bar - window.warmup_bars) % options.report_every_bars == 0;
+        if (!end_of_day && !interval) continue;
+
+        auto partial = trader->get_results();
+        RunProgress progress;
+        progress.step = status.reports++;
+        progress.bar = bar;
+        progress.total_bars = window.size();
+        progress.days_completed = static_cast<int>(trader->daily_results().size());
+        progress.end_of_day = end_of_day;
+        progress.equity = partial.final_equity;
+        progress.total_return = partial.total_return;
+        progress.day_return = end_of_day ? trader->daily_results().back().daily_return : 0.0;
+        progress.total_trades = partial.total_trades;
+        progress.max_drawdown = partial.max_drawdown;
+
+        if (!options.on_progress(progress)) {
+            status.aborted = true;
+            return partial;   // Partial results are never cached
+        }
+    }
+    auto results = trader->get_results();
+
+    if (options.cache) {
+        options.cache->store(key, results);
+    }
+    return results;
+}
+
+WalkForwardResults WalkForwardResults::aggregate(const std::vector<std::string>& dates,
+                                                 const std::vector<MultiSymbolTrader::BacktestResults>& days,
+                                                 double initial_capital) {
+    if (dates.size() != days.size()) {
+        throw std::runtime_error("Walk-forward: dates and results differ in length");
+    }
+
+    WalkForwardResults wf;
+    wf.dates = dates;
+    wf.days = days;
+    wf.final_equity = initial_capital;
+    if (days.empty()) return wf;
+
+    double equity = initial_capital;
+    double peak = initial_capital;
+    double sum = 0.0;
+    double sum_sq = 0.0;
+    wf.best_day_return = days.front().total_return;
+    wf.worst_day_return = days.front().total_return;
+
+    for (size_t i = 0; i < days.size(); ++i) {
+        const auto& day = days[i];
+        double r = day.total_return;
+
+        equity *= (1.0 + r);
+        peak = std::max(peak, equity);
+        wf.max_drawdown = std::max(wf.max_drawdown, (peak - equity) / peak);
+        wf.worst_intraday_drawdown = std::max(wf.worst_intraday_drawdown, day.max_drawdown);
+
+        sum += r;
+        sum_sq += r * r;
+        wf.best_day_return = std::max(wf.best_day_return, r);
+        wf.worst_day_return = std::min(wf.worst_day_return, r);
+        if (r > 0.0) wf.profitable_days++;
+
+        wf.total_trades += day.total_trades;
+        wf.winning_trades += day.winning_trades;
+        wf.losing_trades += day.losing_trades;
+        wf.total_transaction_costs += day.total_transaction_costs;
+
+        // Test day is the last EOD each run recorded
+        DailyResults daily{};
+        if (!day.daily_breakdown.empty()) {
+            daily = day.daily_breakdown.back();
+        } else {
+            daily.start_equity = initial_capital;
+            daily.end_equity = day.final_equity;
+            daily.daily_return = r;
+            daily.trades_today = day.total_trades;
+            daily.winning_trades_today = day.winning_trades;
+            daily.losing_trades_today = day.losing_trades;
+        }
+        daily.day_number = static_cast<int>(i + 1);
+        wf.daily.push_back(daily);
+    }
+
+    double n = static_cast<double>(days.size());
+    wf.mrd = sum / n;
+    wf.compounded_return = equity / initial_capital - 1.0;
+    wf.final_equity = equity;
+    wf.win_rate = (wf.total_trades > 0)
+        ? static_cast<double>(wf.winning_trades) / wf.total_trades : 0.0;
+
+    if (days.size() > 1) {
+        double variance = (sum_sq - sum * sum / n) / (n - 1.0);
+        double stddev = std::sqrt(std::max(0.0, variance));
+        if (stddev > 0.0) {
+            wf.daily_sharpe = wf.mrd / stddev * std::sqrt(252.0);
+        }
+    }
+    return wf;
+}
+
+} // namespace trading
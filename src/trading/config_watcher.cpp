@@ -0,0 +1,135 @@
+#include "trading/config_watcher.h"
+#include "trading/param_registry.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <poll.h>
+#include <stdexcept>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+namespace trading {
+
+ConfigWatcher::ConfigWatcher(Options options, Loader loader, const TradingConfig& current)
+    : options_(std::move(options)),
+      loader_(std::move(loader)),
+      last_loaded_(current) {}
+
+ConfigWatcher::~ConfigWatcher() {
+    stop();
+    delete mailbox_.exchange(nullptr);
+}
+
+void ConfigWatcher::start() {
+    if (thread_.joinable()) return;
+
+    inotify_fd_ = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotify_fd_ < 0) {
+        throw std::runtime_error(std::string("inotify_init1 failed: ") + std::strerror(errno));
+    }
+    // Writers either rewrite in place (CLOSE_WRITE) or rename a temp file over
+    // the target (MOVED_TO); watching the directory catches both
+    if (::inotify_add_watch(inotify_fd_, options_.directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+        int err = errno;
+        ::close(inotify_fd_);
+        inotify_fd_ = -1;
+        throw std::runtime_error("Cannot watch " + options_.directory + ": " + std::strerror(err));
+    }
+
+    stopping_ = false;
+    thread_ = std::thread([this]() { run(); });
+}
+
+void ConfigWatcher::stop() {
+    if (thread_.joinable()) {
+        stopping_ = true;
+        thread_.join();
+    }
+    if (inotify_fd_ >= 0) {
+        ::close(inotify_fd_);
+        inotify_fd_ = -1;
+    }
+}
+
+bool ConfigWatcher::take(TradingConfig& out) {
+    if (mailbox_.load(std::memory_order_relaxed) == nullptr) return false;
+    TradingConfig* loaded = mailbox_.exchange(nullptr, std::memory_order_acquire);
+    if (!loaded) return false;
+    out = std::move(*loaded);
+    delete loaded;
+    return true;
+}
+
+std::string ConfigWatcher::last_error() const {
+    std::lock_guard<std::mutex> lock(error_mutex_);
+    return last_error_;
+}
+
+void ConfigWatcher::run() {
+    using Clock = std::chrono::steady_clock;
+    bool changed = false;
+    Clock::time_point load_at{};
+
+    while (!stopping_.load(std::memory_order_acquire)) {
+        // Short timeout keeps stop() responsive and times the settle window
+        int timeout_ms = 100;
+        if (changed) {
+            auto left = std::chrono::duration_cast<std::chrono::milliseconds>(load_at - Clock::now()).count();
+            timeout_ms = static_cast<int>(std::clamp<long long>(left, 0, 100));
+        }
+
+        struct pollfd pfd = {inotify_fd_, POLLIN, 0};
+        int ready = ::poll(&pfd, 1, timeout_ms);
+        if (ready > 0 && drain_events()) {
+            changed = true;
+            load_at = Clock::now() + options_.settle;     // Restart the quiet period
+        }
+
+        if (changed && Clock::now() >= load_at) {
+            changed = false;
+            load();
+        }
+    }
+}
+
+bool ConfigWatcher::drain_events() {
+    alignas(struct inotify_event) char buf[4096];
+    bool relevant = false;
+    while (true) {
+        ssize_t n = ::read(inotify_fd_, buf, sizeof(buf));
+        if (n <= 0) break;      // EAGAIN: queue drained
+        for (ssize_t off = 0; off < n;) {
+            const auto* ev = reinterpret_cast<const struct inotify_event*>(buf + off);
+            if (ev->len > 0 &&
+                std::find(options_.files.begin(), options_.files.end(), ev->name) != options_.files.end()) {
+                relevant = true;
+            }
+            off += static_cast<ssize_t>(sizeof(struct inotify_event) + ev->len);
+        }
+    }
+    return relevant;
+}
+
+void ConfigWatcher::load() {
+    TradingConfig loaded;
+    try {
+        loaded = loader_();
+    } catch (const std::exception& e) {
+        {
+            std::lock_guard<std::mutex> lock(error_mutex_);
+            last_error_ = e.what();
+        }
+        stats_.rejected.fetch_add(1, std::memory_order_release);
+        return;
+    }
+
+    if (same_tunable_params(loaded, last_loaded_)) {
+        stats_.unchanged.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    last_loaded_ = loaded;
+    stats_.loaded.fetch_add(1, std::memory_order_relaxed);
+    delete mailbox_.exchange(new TradingConfig(std::move(loaded)), std::memory_order_acq_rel);
+}
+
+} // namespace trading
@@ -0,0 +1,1938 @@
+#include "trading/live_pipeline.h"
+#include "trading/config_watcher.h"
+#include "trading/latency_trace.h"
+#include "trading/live_clock.h"
+#include "trading/live_metrics.h"
+#include "trading/order_gateway.h"
+#include "trading/param_registry.h"
+#include "trading/replay_feed.h"
+#include "trading/snapshot_assembler.h"
+#include "trading/state_journal.h"
+#include "utils/config_loader.h"
+#include "utils/data_loader.h"
+#include "utils/fd_line_reader.h"
+#include "utils/live_bar_parser.h"
+#include "utils/results_exporter.h"
+#include "utils/spsc_queue.h"
+#include "utils/thread_affinity.h"
+#include "utils/thread_pool.h"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <deque>
+#include <fcntl.h>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <thread>
+#include <unistd.h>
+#ifdef ENABLE_ZMQ
+#include <zmq.hpp>
+#endif
+
+namespace trading {
+
+namespace {
+
+/**
+ * Live warmup snapshots, in time order
+ */
+struct LiveWarmup {
+    ReplayWindow window;            // Every snapshot is warmup (window.warmup_bars == size())
+    size_t from_store = 0;          // Leading snapshots from the binary store
+    size_t from_today = 0;          // Trailing snapshots from today's bar file
+    std::string store_error;        // Why the store was not used (empty if it was)
+    std::string today_error;        // Why today's file was not used (empty if absent or used)
+};
+
+/**
+ * Live warmup: the last config.warmup_bars minutes before `before` from the
+ * binary store (aligned per symbol exactly like the replay window), then the
+ * bars in `today_file` (fetch_today_bars.py) newer than anything in the store.
+ * Either source may be missing; neither caps the warmup length.
+ */
+LiveWarmup build_live_warmup(const LiveConfig& config, const std::string& today_file, Timestamp before) {
+    LiveWarmup warmup;
+    Timestamp store_end = Timestamp::min();
+
+    try {
+        auto all_data = DataLoader::load_from_directory(config.data_dir, config.symbols, config.extension);
+        size_t count = config.warmup_bars;
+        std::unordered_map<Symbol, size_t> ends;
+        for (const auto& symbol : config.symbols) {
+            const auto& bars = all_data.at(symbol);
+            auto end = std::lower_bound(bars.begin(), bars.end(), before,
+                                        [](const Bar& bar, const Timestamp& t) { return bar.timestamp < t; });
+            ends[symbol] = static_cast<size_t>(end - bars.begin());
+            count = std::min(count, ends[symbol]);
+        }
+        std::unordered_map<Symbol, std::vector<Bar>> sliced;
+        for (const auto& symbol : config.symbols) {
+            const auto& bars = all_data.at(symbol);
+            const size_t end = ends[symbol];
+            sliced.emplace(symbol, std::vector<Bar>(bars.begin() + (end - count), bars.begin() + end));
+            if (count > 0) store_end = std::max(store_end, bars[end - 1].timestamp);
+        }
+        warmup.window = ReplayWindow::from_bars(config.symbols, sliced, count, "");
+        warmup.from_store = warmup.window.size();
+    } catch (const std::exception& e) {
+        warmup.store_error = e.what();
+    }
+
+    if (std::filesystem::exists(today_file)) {
+        try {
+            std::ifstream in(today_file);
+            nlohmann::json today = nlohmann::json::parse(in);
+
+            std::vector<Bar> bars;
+            for (const auto& [symbol, rows] : today.items()) {
+                if (std::find(config.symbols.begin(), config.symbols.end(), symbol) == config.symbols.end()) continue;
+                for (const auto& row : rows) {
+                    const int64_t t_ms = row.value("t_ms", int64_t{0});
+                    const int64_t bar_id = row.value("bar_id", int64_t{-1});
+                    if (t_ms == 0 || bar_id < 0) continue;
+                    Bar bar;
+                    bar.symbol = symbol;
+                    bar.timestamp = Timestamp(std::chrono::milliseconds(t_ms));
+                    if (bar.timestamp <= store_end || bar.timestamp >= before) continue;
+                    bar.bar_id = static_cast<uint64_t>(bar_id);
+                    bar.open = row["o"];
+                    bar.high = row["h"];
+                    bar.low = row["l"];
+                    bar.close = row["c"];
+                    bar.volume = row["v"];
+                    bars.push_back(std::move(bar));
+                }
+            }
+
+            // One snapshot per minute; a symbol missing from a minute is simply absent
+            std::sort(bars.begin(), bars.end(),
+                      [](const Bar& a, const Bar& b) { return a.timestamp < b.timestamp; });
+            for (size_t i = 0; i < bars.size();) {
+                std::unordered_map<Symbol, Bar> snapshot;
+                const Timestamp minute = bars[i].timestamp;
+                for (; i < bars.size() && bars[i].timestamp == minute; ++i) {
+                    Symbol symbol = bars[i].symbol;
+                    snapshot.emplace(std::move(symbol), std::move(bars[i]));
+                }
+                warmup.window.snapshots.push_back(std::move(snapshot));
+                warmup.from_today++;
+            }
+        } catch (const std::exception& e) {
+            warmup.today_error = e.what();
+        }
+    }
+    warmup.window.symbols = config.symbols;
+    warmup.window.warmup_bars = warmup.window.size();
+    return warmup;
+}
+
+/**
+ * Trading config of a live --instance, loaded from its own params files
+ * and prepared the way parse_args prepares the primary SIGOR config
+ * @throws on a missing, unparsable or invalid params file
+ */
+TradingConfig load_instance_config(const std::string& dir) {
+    TradingConfig config = ConfigLoader::load(dir + "/trading_params.json");
+    config.sigor_config = SigorConfigLoader::load(dir + "/sigor_params.json");
+    config.strategy = StrategyType::SIGOR;
+    config.min_bars_to_learn = 0;
+    config.warmup.enabled = false;
+    config.warmup.observation_days = 0;
+    config.warmup.simulation_days = 0;
+    ConfigLoader::validate(config);
+    return config;
+}
+
+// ============================================================================
+// Live pipeline events
+// ============================================================================
+
+/**
+ * Ingest → decision stage: one parsed bar (or parse failure / end of feed)
+ */
+struct LiveIngestEvent {
+    enum class Kind { BAR, PARSE_ERROR, END };
+
+    Kind kind = Kind::BAR;
+    Bar bar;
+    BarTrace trace;           // Read / parse stamps
+    LiveClock::time_point arrived{};  // Feed clock at read (drives snapshot deadlines)
+    std::string raw;          // Original JSON line (kept for failure reports)
+    std::string error;        // PARSE_ERROR only
+};
+
+/**
+ * Failure context captured on the decision thread, written out by the report stage
+ */
+struct LiveFailureReport {
+    struct PositionInfo {
+        Symbol symbol;
+        int shares;
+        double entry_price;
+    };
+
+    std::string severity;
+    std::string message;
+    std::string offending_line;
+    size_t bars_processed = 0;
+    size_t snapshots_processed = 0;
+    std::vector<std::string> recent_raw_lines;
+    std::vector<Symbol> symbols_present;
+    std::vector<PositionInfo> positions;
+};
+
+/**
+ * Decision → order/report stage: anything that does I/O
+ */
+struct LiveReportEvent {
+    enum class Kind { BAR_RECEIVED, SNAPSHOT, STATUS, ORDER, LATENCY, RELOAD, JOURNAL, CHECKPOINT, FAILURE, END };
+
+    Kind kind = Kind::END;
+    size_t instance = 0;          // ORDER: 0 = primary trader, i = i-th --instance
+    Symbol symbol;                // BAR_RECEIVED, ORDER
+    double price = 0.0;           // BAR_RECEIVED, ORDER (reference price)
+    int shares = 0;               // ORDER: signed share delta
+    int position = 0;             // ORDER: shares held after the order
+    double entry_price = 0.0;     // ORDER: entry price of the position held (exits: the one closed)
+    uint64_t entry_bar_id = 0;    // ORDER: its entry bar
+    uint64_t bar_id = 0;          // SNAPSHOT, ORDER, RELOAD (first bar under the new params)
+    uint64_t trace_id = 0;        // ORDER: trace id of the bar that triggered the minute
+    uint64_t read_ns = 0;         // ORDER: trigger bar read stamp
+    uint64_t decided_ns = 0;      // ORDER: on_bar end stamp
+    size_t fresh = 0;             // SNAPSHOT
+    size_t stale = 0;             // SNAPSHOT
+    size_t bars = 0;              // BAR_RECEIVED
+    size_t snapshots = 0;         // BAR_RECEIVED, STATUS; RELOAD: reload count
+    double equity = 0.0;          // STATUS
+    double return_pct = 0.0;      // STATUS
+    int trades = 0;               // STATUS
+    size_t positions = 0;         // STATUS
+    double win_rate = 0.0;        // STATUS
+    std::unique_ptr<LiveFailureReport> failure;  // FAILURE
+    std::unique_ptr<MinuteLatencyReport> latency;  // LATENCY
+    std::unique_ptr<std::string> record;  // JOURNAL, CHECKPOINT: encoded StateJournal bytes
+};
+
+/**
+ * Another trader on the live feed (--instance NAME=DIR). It has its own
+ * parameters, capital, trade journal and order routing, and it sees the same
+ * assembled snapshots as the primary trader. It runs quiet, and its orders
+ * and results are reported under its name.
+ */
+struct LiveInstance {
+    std::string name;
+    std::string config_dir;
+    TradingConfig config;
+    std::unique_ptr<MultiSymbolTrader> trader;
+    std::unordered_map<Symbol, Position> last_positions;    // Decision stage
+    std::string error;                              // Decision stage: this minute's on_bar exception
+    std::string orders_path;
+    std::unique_ptr<OrderGateway> gateway;
+};
+
+void write_live_failure_report(const LiveFailureReport& report,
+                               const std::vector<Symbol>& symbols_expected) {
+    try {
+        std::filesystem::create_directories("logs/live");
+        auto now = std::chrono::system_clock::now();
+        std::time_t tnow = std::chrono::system_clock::to_time_t(now);
+        struct tm tm_now;
+        localtime_r(&tnow, &tm_now);
+        char tsbuf[20];
+        std::strftime(tsbuf, sizeof(tsbuf), "%Y%m%d_%H%M%S", &tm_now);
+        std::string path = std::string("logs/live/failure_") + report.severity + "_" + tsbuf + ".log";
+
+        std::ofstream out(path);
+        out << "severity: " << report.severity << "\n";
+        out << "message: " << report.message << "\n";
+        out << "bars_processed: " << report.bars_processed << "\n";
+        out << "snapshots_processed: " << report.snapshots_processed << "\n";
+        out << "symbols_expected: ";
+        for (size_t i = 0; i < symbols_expected.size(); ++i) {
+            out << symbols_expected[i] << (i + 1 < symbols_expected.size() ? "," : "");
+        }
+        out << "\n";
+        out << "symbols_present: ";
+        for (size_t i = 0; i < report.symbols_present.size(); ++i) {
+            out << report.symbols_present[i] << (i + 1 < report.symbols_present.size() ? "," : "");
+        }
+        out << "\n";
+        if (!report.offending_line.empty()) {
+            out << "offending_line: " << report.offending_line << "\n";
+        }
+        out << "recent_raw_lines:" << "\n";
+        size_t idx = 0;
+        for (const auto& ln : report.recent_raw_lines) {
+            out << "  [" << idx++ << "] " << ln << "\n";
+        }
+        // Dump positions
+        out << "positions:" << "\n";
+        for (const auto& pos : report.positions) {
+            out << "  - symbol: " << pos.symbol
+                << ", shares: " << pos.shares
+                << ", entry: " << pos.entry_price
+                << ", held_bars: " << (int)0 /* placeholder */
+                << "\n";
+        }
+        out.close();
+        std::fprintf(stderr, "\n⚠️  Runtime incident logged → %s\n", path.c_str());
+    } catch (...) {
+        // Swallow any logging failures to avoid masking original error
+    }
+}
+
+// ============================================================================
+// Session setup and stages
+// ============================================================================
+
+/**
+ * State shared by the live pipeline stages
+ * Filled in by the setup helpers before any stage starts. While the stages
+ * run, each piece has one owner:
+ *   - trader, instances[].trader / last_positions / error: decision stage
+ *   - gateway, instances[].gateway, state_journal: report stage
+ *   - bar_queue: ingest pushes, decision pops; report_queue: decision pushes, report pops
+ *   - config_watcher: decision takes reloads, report reads its stats (both thread-safe)
+ *   - metrics: atomics, stored by any stage and published by the report stage
+ * Everything else is read-only until the stages have joined.
+ */
+struct LiveSession {
+    LiveConfig& config;
+
+    // Bar feed: a stored day replayed, or the FIFO / ZMQ bridge
+    bool use_replay = false;
+    bool use_fifo = false;
+    int bar_fd = -1;
+    const ReplayWindow& replay_window;  // config.replay_window
+    size_t replay_first = 0;            // First replayed minute; earlier ones are warmup
+    LiveWarmup live_warmup;
+    std::chrono::steady_clock::time_point warmup_start;
+
+    std::string session_stamp;
+    std::unique_ptr<MultiSymbolTrader> trader;
+    uint64_t resume_bar_id = 0;         // Minutes up to here are already in the trader
+    std::vector<LiveInstance> instances;
+    std::unique_ptr<utils::ThreadPool> instance_pool;
+
+    std::string orders_path;            // Order intents of the primary trader
+    std::string latency_path;           // Per-minute latency rows, session summary last
+
+    SpscQueue<LiveIngestEvent> bar_queue{4096};
+    SpscQueue<LiveReportEvent> report_queue{4096};
+    std::unique_ptr<OrderGateway> gateway;
+    std::unique_ptr<ConfigWatcher> config_watcher;
+    std::unique_ptr<StateJournal> state_journal;
+
+    SteadyLiveClock wall_clock;
+    ReplayClock replay_clock;
+    LiveMetrics metrics;                // Counters/gauges: stages store, the report stage publishes
+
+    explicit LiveSession(LiveConfig& cfg)
+        : config(cfg), replay_window(cfg.replay_window), replay_clock(cfg.replay_speed) {}
+
+    ~LiveSession() {
+        if (bar_fd >= 0) ::close(bar_fd);
+    }
+
+    LiveSession(const LiveSession&) = delete;
+    LiveSession& operator=(const LiveSession&) = delete;
+
+    /**
+     * Snapshot deadlines run on wall time live, on virtual market time in replay
+     */
+    const LiveClock& clock() const {
+        return use_replay ? static_cast<const LiveClock&>(replay_clock) : wall_clock;
+    }
+};
+
+/**
+ * Load what the traders warm up on (replay window or live warmup) and the
+ * instance configs, print the session configuration and check flag combinations
+ * @return false (after printing why) if the session cannot start
+ */
+bool configure_live_session(LiveSession& session) {
+    LiveConfig& config = session.config;
+
+    // Replay feed: the test day comes from the binary store; everything
+    // before it warms the trader directly, exactly as in mock mode
+    session.use_replay = (config.feed == "replay");
+    if (session.use_replay) {
+        session.replay_first = session.replay_window.size() -
+            std::min<size_t>(session.replay_window.size(), config.trading.bars_per_day);
+        config.trading = BacktestRunner::prepare_config(config.trading, session.replay_window);
+    }
+
+    // Live warmup: the last --warmup-bars stored minutes plus today's bars so
+    // far. Loaded before the trader exists because, as in replay, no warmup
+    // minute may trade
+    session.warmup_start = std::chrono::steady_clock::now();
+    if (!session.use_replay && !config.resume) {
+        std::cout << "Loading warmup bars from " << config.data_dir << " and " << config.warmup_file << "...\n";
+        session.live_warmup = build_live_warmup(config, config.warmup_file, std::chrono::system_clock::now());
+        config.trading = BacktestRunner::prepare_config(config.trading, session.live_warmup.window);
+    }
+
+    // The primary logs nothing from on_bar(): console writes there would
+    // stall the decision thread. Its entries and exits are printed by the
+    // report stage, from the order intents
+    config.trading.quiet = true;
+
+    // Extra traders share the feed, snapshots and warmup; each has its own params
+    for (const auto& [name, dir] : config.instances) {
+        LiveInstance inst;
+        inst.name = name;
+        inst.config_dir = dir;
+        try {
+            inst.config = load_instance_config(dir);
+        } catch (const std::exception& e) {
+            std::cerr << "❌ Error: instance " << name << ": " << e.what() << "\n";
+            return false;
+        }
+        inst.config = BacktestRunner::prepare_config(
+            inst.config, session.use_replay ? session.replay_window : session.live_warmup.window);
+        inst.config.quiet = true;
+        session.instances.push_back(std::move(inst));
+    }
+
+    std::cout << "Configuration:\n";
+    if (session.use_replay) {
+        std::cout << "  Data Source:     Replay of " << session.replay_window.test_date << " from " << config.data_dir
+                  << " (" << (session.replay_window.size() - session.replay_first) << " minutes, ";
+        if (config.replay_speed > 0) {
+            std::cout << config.replay_speed << "× speed)\n";
+        } else {
+            std::cout << "as fast as possible)\n";
+        }
+    } else {
+        std::cout << "  Data Source:     Alpaca WebSocket (IEX)\n";
+    }
+    std::cout << "  Order Submission: Alpaca REST API\n";
+    std::cout << "  Bar FIFO:        " << config.bar_fifo << "\n";
+    if (config.order_gateway != "off") {
+        std::cout << "  Order FIFO:      " << config.order_fifo << " (" << config.order_gateway << " batches)\n";
+        std::cout << "  Response FIFO:   " << config.response_fifo << "\n";
+    } else {
+        std::cout << "  Order Gateway:   off (order intents logged only)\n";
+    }
+    std::cout << "  Snapshot Deadline: " << config.snapshot_deadline_ms << " ms\n";
+    std::cout << "  Latency Budget:  " << config.latency_budget_ms << " ms\n";
+    if (config.metrics_interval_ms > 0) {
+        std::cout << "  Metrics File:    " << config.metrics_file
+                  << " (every " << config.metrics_interval_ms << " ms)\n";
+    }
+    std::cout << "  Hot Reload:      " << (config.hot_reload ? config.config_dir + "/ (params swapped between bars)"
+                                                              : std::string("off")) << "\n";
+    if (config.state_dir.empty()) {
+        std::cout << "  State Journal:   off\n";
+    } else {
+        std::cout << "  State Journal:   " << config.state_dir << "/ (checkpoint every "
+                  << config.checkpoint_interval << " min" << (config.resume ? ", resuming" : "") << ")\n";
+    }
+    for (const auto& inst : session.instances) {
+        std::cout << "  Instance:        " << inst.name << " (" << inst.config_dir << "/, $"
+                  << static_cast<long long>(inst.config.initial_capital) << ")\n";
+    }
+    std::cout << "\n";
+    if (config.resume && config.state_dir.empty()) {
+        std::cerr << "❌ Error: --resume needs a --state-dir\n";
+        return false;
+    }
+    if (config.resume && !session.instances.empty()) {
+        std::cerr << "❌ Error: --resume restores the primary trader only; run it without --instance\n";
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Create the primary trader (or restore it with --resume) and the instances,
+ * then warm them up
+ * @return false (after printing why) if an instance failed its warmup
+ */
+bool start_live_traders(LiveSession& session) {
+    LiveConfig& config = session.config;
+
+    // Persist every live trade to disk as it happens (crash-safe, constant memory)
+    {
+        std::time_t tnow = std::time(nullptr);
+        char tsbuf[32];
+        std::strftime(tsbuf, sizeof(tsbuf), "%Y%m%d_%H%M%S", std::localtime(&tnow));
+        session.session_stamp = tsbuf;
+        config.trading.trade_journal_path = "logs/live/trades_" + session.session_stamp + ".bin";
+    }
+
+    // Initialize trader with SIGOR configuration, or rebuild it after a crash:
+    // last checkpoint, then every minute logged since, replayed in order
+    if (config.resume) {
+        std::cout << "Restoring trader from " << config.state_dir << "/...\n";
+        const auto recovery = StateJournal::load(config.state_dir);
+        session.trader = StateJournal::restore(recovery, config.trading, session.resume_bar_id);
+        std::cout << "✅ Trader restored: checkpoint at bar_id " << recovery.checkpoint_bar_id
+                  << " + " << recovery.records.size() << " logged records, resuming after bar_id "
+                  << session.resume_bar_id << "\n";
+        if (recovery.torn_bytes > 0) {
+            std::cout << "   Dropped " << recovery.torn_bytes << " bytes of an incomplete log record\n";
+        }
+    } else {
+        std::cout << "Initializing trader...\n";
+        session.trader = std::make_unique<MultiSymbolTrader>(config.symbols, config.trading);
+        std::cout << "✅ Trader initialized\n";
+    }
+    MultiSymbolTrader& trader = *session.trader;
+    std::cout << "  Trade Journal:   " << trader.config().trade_journal_path
+              << (config.resume ? " (resumed)" : "") << "\n\n";
+
+    // SIGOR Warmup Strategy:
+    // SIGOR is rule-based (no learning), but needs lookback bars for indicators:
+    //   - RSI(14) needs 14 bars
+    //   - Bollinger(20) needs 20 bars
+    //   - Momentum(10) needs 10 bars
+    //   - ORB needs first 30 bars of day
+    //   - Volume surge needs 20-bar window
+    //
+    // Solution: feed the last --warmup-bars minutes of the binary store
+    // (previous sessions) plus today's bars so far (warmup_bars.json, from
+    // fetch_today_bars.py) before live trading starts
+    if (config.resume) {
+        // The restored indicator history is the warmup
+    } else if (session.use_replay) {
+        for (size_t i = 0; i < session.replay_first; ++i) trader.on_bar(session.replay_window.snapshots[i]);
+        std::cout << "🔄 Warmed up on " << session.replay_first << " stored bars before the replayed day\n\n";
+    } else {
+        const LiveWarmup& warmup = session.live_warmup;
+        for (const auto& snapshot : warmup.window.snapshots) trader.on_bar(snapshot);
+        const auto warmup_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - session.warmup_start).count();
+
+        std::cout << "🔄 Live warmup:\n";
+        if (warmup.store_error.empty()) {
+            std::cout << "   Store: " << warmup.from_store << " minutes (--warmup-bars "
+                      << config.warmup_bars << ")\n";
+        } else {
+            std::cerr << "   ⚠️  Binary store not used: " << warmup.store_error << "\n";
+        }
+        if (!warmup.today_error.empty()) {
+            std::cerr << "   ⚠️  Failed to load " << config.warmup_file << ": " << warmup.today_error << "\n";
+        } else if (warmup.from_today > 0) {
+            std::cout << "   Today: " << warmup.from_today << " minutes from " << config.warmup_file << "\n";
+        }
+
+        if (warmup.window.size() > 0) {
+            std::cout << "   ✅ Warmed up on " << warmup.window.size() << " minutes in " << warmup_ms
+                      << "ms (load + replay)\n";
+            std::cout << "   → SIGOR ready to trade immediately with indicator lookback\n\n";
+        } else {
+            std::cout << "   No warmup bars found\n";
+            std::cout << "   → SIGOR will start trading after collecting ~30 bars (~30 minutes)\n";
+            std::cout << "   TIP: Run scripts/fetch_today_bars.py to get immediate trading\n\n";
+        }
+    }
+
+    // Extra instances: the same warmup as the primary, replayed in parallel
+    if (session.instances.empty()) return true;
+    session.instance_pool = std::make_unique<utils::ThreadPool>(
+        std::min(session.instances.size(), utils::ThreadPool::default_threads()));
+    for (auto& inst : session.instances) {
+        inst.config.trade_journal_path = "logs/live/trades_" + session.session_stamp + "_" + inst.name + ".bin";
+        inst.trader = std::make_unique<MultiSymbolTrader>(config.symbols, inst.config);
+        LiveInstance* instance = &inst;
+        session.instance_pool->submit([&session, instance]() {
+            try {
+                if (session.use_replay) {
+                    for (size_t i = 0; i < session.replay_first; ++i) {
+                        instance->trader->on_bar(session.replay_window.snapshots[i]);
+                    }
+                } else {
+                    for (const auto& snapshot : session.live_warmup.window.snapshots) {
+                        instance->trader->on_bar(snapshot);
+                    }
+                }
+            } catch (const std::exception& e) {
+                instance->error = e.what();
+            }
+        });
+    }
+    session.instance_pool->wait_idle();
+    for (const auto& inst : session.instances) {
+        if (!inst.error.empty()) {
+            std::cerr << "❌ Error: instance " << inst.name << " warmup failed: " << inst.error << "\n";
+            return false;
+        }
+    }
+    std::cout << "✅ " << session.instances.size() << " more trader instance(s) warmed up\n\n";
+    return true;
+}
+
+/**
+ * Open the bar feed and everything the report stage writes to: orders and
+ * latency files, order gateways, state journal and metrics; start the
+ * parameter watcher
+ * @return false (after printing why) if the bar FIFO cannot be opened
+ */
+bool open_live_io(LiveSession& session) {
+    const LiveConfig& config = session.config;
+    MultiSymbolTrader& trader = *session.trader;
+
+    session.use_fifo = (config.feed != "zmq" && !session.use_replay);
+#ifdef ENABLE_ZMQ
+    if (!session.use_fifo && !session.use_replay) {
+        std::cout << "🔗 ZMQ SUB mode: " << config.zmq_url << " (topic: BARS)\n\n";
+    }
+#else
+    if (!session.use_fifo && !session.use_replay) {
+        std::cerr << "⚠️  ZMQ feed requested but binary built without ZMQ. Falling back to FIFO.\n";
+        session.use_fifo = true;
+    }
+#endif
+
+    if (session.use_fifo) {
+        std::cout << "📡 Opening FIFO pipe for incoming bars...\n";
+        std::cout << "   (Waiting for bridge to connect)\n\n";
+        session.bar_fd = ::open(config.bar_fifo.c_str(), O_RDONLY);
+        if (session.bar_fd < 0) {
+            std::cerr << "❌ Error: Failed to open bar FIFO: " << config.bar_fifo << "\n";
+            return false;
+        }
+        std::cout << "✅ Connected to FIFO bridge\n";
+    }
+
+    // Order intents (position changes) are handed off here by the report stage
+    {
+        std::time_t tnow = std::time(nullptr);
+        char tsbuf[32];
+        std::strftime(tsbuf, sizeof(tsbuf), "%Y%m%d_%H%M%S", std::localtime(&tnow));
+        session.orders_path = std::string("logs/live/orders_") + tsbuf + ".jsonl";
+        session.latency_path = std::string("logs/live/latency_") + tsbuf + ".jsonl";
+        for (auto& inst : session.instances) {
+            inst.orders_path = std::string("logs/live/orders_") + tsbuf + "_" + inst.name + ".jsonl";
+        }
+    }
+
+    std::cout << "🚀 LIVE TRADING ACTIVE - Processing real-time bars\n";
+    std::cout << "   Pipeline: ingest → decide → order/report"
+              << " (cores: " << config.pin_ingest_core << ","
+              << config.pin_decision_core << "," << config.pin_report_core << ")\n";
+    std::cout << "   Orders:   " << session.orders_path << "\n";
+    for (const auto& inst : session.instances) {
+        std::cout << "             " << inst.orders_path << " (" << inst.name << ")\n";
+    }
+    std::cout << "   Latency:  " << session.latency_path << "\n";
+    if (config.metrics_interval_ms > 0) std::cout << "   Metrics:  " << config.metrics_file << "\n";
+    std::cout << "   Press Ctrl+C to stop\n\n";
+    std::cout << "═══════════════════════════════════════════════════════════════\n\n";
+
+    // Order gateway: the report stage hands it one batch per minute; it
+    // writes and reads the broker FIFOs on its own thread
+    if (config.order_gateway != "off") {
+        OrderGateway::Options gateway_options;
+        gateway_options.order_path = config.order_fifo;
+        gateway_options.response_path = config.response_fifo;
+        gateway_options.queue_capacity = config.gateway_queue;
+        gateway_options.max_pending = config.gateway_pending;
+        gateway_options.format = (config.order_gateway == "binary") ? OrderWireFormat::BINARY
+                                                                    : OrderWireFormat::JSON;
+        session.gateway = std::make_unique<OrderGateway>(gateway_options);
+        session.gateway->start();
+        for (auto& inst : session.instances) {
+            gateway_options.order_path = "/tmp/alpaca_orders_" + inst.name + ".fifo";
+            gateway_options.response_path = "/tmp/alpaca_responses_" + inst.name + ".fifo";
+            inst.gateway = std::make_unique<OrderGateway>(gateway_options);
+            inst.gateway->start();
+        }
+    }
+
+    // Parameter hot reload: the watcher thread parses and validates edited
+    // params files; the decision stage swaps them in between minutes
+    if (config.hot_reload) {
+        const TradingConfig running = trader.config();
+        const std::string dir = config.config_dir;
+        auto load_params = [running, dir]() {
+            TradingConfig loaded = ConfigLoader::load(dir + "/trading_params.json");
+            loaded.sigor_config = SigorConfigLoader::load(dir + "/sigor_params.json");
+            TradingConfig next = running;
+            copy_tunable_params(next, loaded);
+            ConfigLoader::validate(next);
+            return next;
+        };
+        ConfigWatcher::Options watch_options;
+        watch_options.directory = dir;
+        watch_options.files = {"trading_params.json", "sigor_params.json"};
+        session.config_watcher = std::make_unique<ConfigWatcher>(watch_options, load_params, running);
+        try {
+            session.config_watcher->start();
+        } catch (const std::exception& e) {
+            std::cerr << "⚠️  Parameter hot reload disabled: " << e.what() << "\n";
+            session.config_watcher.reset();
+        }
+    }
+
+    // Crash-safe state: the report stage logs every minute the trader
+    // processes, durably and before that minute's orders go out, and
+    // replaces the checkpoint every checkpoint_interval minutes
+    if (!config.state_dir.empty()) {
+        session.state_journal = std::make_unique<StateJournal>(config.state_dir);
+        session.state_journal->write_checkpoint(StateJournal::encode_checkpoint(session.resume_bar_id, trader));
+    }
+
+    LiveMetrics& metrics = session.metrics;
+    metrics.bar_queue_capacity = session.bar_queue.capacity();
+    metrics.report_queue_capacity = session.report_queue.capacity();
+    LiveMetrics::set(metrics.equity, trader.get_equity({}));
+    LiveMetrics::set(metrics.cash, trader.cash());
+    LiveMetrics::set(metrics.open_positions, static_cast<uint64_t>(trader.positions().size()));
+    LiveMetrics::set(metrics.trades, static_cast<uint64_t>(trader.total_trades()));
+    LiveMetrics::set(metrics.running, true);
+    return true;
+}
+
+/**
+ * Stage 1: read bar lines from the feed, parse them and hand them to the
+ * decision stage (blocks on a full bar_queue: bars are never dropped)
+ */
+class LiveIngestStage {
+public:
+    explicit LiveIngestStage(LiveSession& session) : session_(session) {}
+
+    void run();
+
+    /**
+     * True if the feed could not be opened (read after the stage has joined)
+     */
+    bool failed() const { return failed_; }
+
+private:
+    void publish(LiveIngestEvent&& ev) {
+        while (!session_.bar_queue.try_push(std::move(ev))) backoff_.idle();
+        backoff_.reset();
+    }
+
+    void publish_end() {
+        LiveIngestEvent end;
+        end.kind = LiveIngestEvent::Kind::END;
+        end.arrived = session_.clock().now();
+        publish(std::move(end));
+    }
+
+    LiveSession& session_;
+    SpinBackoff backoff_;
+    bool failed_ = false;
+};
+
+void LiveIngestStage::run() {
+    const LiveConfig& config = session_.config;
+    const LiveClock& clock = session_.clock();
+    utils::set_current_thread_name("sentio-ingest");
+    utils::pin_current_thread(config.pin_ingest_core);
+
+    FdLineReader bar_reader(session_.bar_fd);
+    ReplayFeed replay_feed(session_.replay_window.snapshots, session_.replay_first, config.symbols,
+                           session_.replay_clock);
+#ifdef ENABLE_ZMQ
+    zmq::context_t ctx(1);
+    zmq::socket_t sub(ctx, zmq::socket_type::sub);
+    if (!session_.use_fifo && !session_.use_replay) {
+        try {
+            sub.set(zmq::sockopt::subscribe, "BARS");
+            sub.set(zmq::sockopt::rcvhwm, 1000);
+            sub.connect(config.zmq_url);
+        } catch (const zmq::error_t& e) {
+            std::cerr << "❌ ZMQ connect failed: " << e.what() << "\n";
+            failed_ = true;
+            publish_end();
+            return;
+        }
+    }
+#endif
+
+    std::string line;
+    uint64_t trace_seq = 0;
+    while (true) {
+        if (session_.use_replay) {
+            if (!replay_feed.next(line)) break;
+        }
+        else if (session_.use_fifo) {
+            if (bar_reader.next(line, -1) == FdLineReader::Status::CLOSED) break;
+        }
+#ifdef ENABLE_ZMQ
+        else {
+            // Minimal blocking ZMQ SUB receive (topic-prefixed string)
+            zmq::message_t msg;
+            try {
+                auto res = sub.recv(msg, zmq::recv_flags::none);
+                if (!res.has_value()) continue;
+                std::string s = msg.to_string();
+                auto pos = s.find(' ');
+                if (pos == std::string::npos) continue;
+                line = s.substr(pos + 1);
+            } catch (const zmq::error_t& e) {
+                std::cerr << "⚠️  ZMQ error: " << e.what() << "\n";
+                continue;
+            }
+        }
+#endif
+        const uint64_t read_ns = trace_now_ns();
+        if (line.empty()) continue;
+
+        LiveIngestEvent ev;
+        ev.arrived = clock.now();
+        try {
+            // Parse JSON bar from websocket bridge
+            parse_live_bar(line, ev.bar);
+            ev.kind = LiveIngestEvent::Kind::BAR;
+        } catch (const std::exception& e) {
+            ev.kind = LiveIngestEvent::Kind::PARSE_ERROR;
+            ev.error = std::string("json_exception: ") + e.what();
+        }
+        ev.trace = {++trace_seq, read_ns, trace_now_ns()};
+        ev.raw = std::move(line);
+        publish(std::move(ev));
+        line.clear();
+    }
+
+    publish_end();
+}
+
+/**
+ * Stage 2: assemble minute snapshots and run the traders on them
+ * Owns the primary and instance traders while it runs; anything to print,
+ * write or send goes to the report stage as a LiveReportEvent. The
+ * accessors are for the session summary, once the stage has joined.
+ */
+class LiveDecisionStage {
+public:
+    explicit LiveDecisionStage(LiveSession& session);
+
+    void run();
+
+    size_t bars_processed() const { return bars_processed_; }
+    size_t snapshots_processed() const { return snapshots_processed_; }
+    size_t reports_dropped() const { return reports_dropped_; }
+    size_t reports_deferred() const { return reports_deferred_; }
+    size_t config_reloads() const { return config_reloads_; }
+    const SnapshotAssembler::Stats& snapshot_stats() const { return assembler_.stats(); }
+    const LatencySpans& latency() const { return latency_; }
+    const std::unordered_map<Symbol, Bar>& market_snapshot() const { return market_snapshot_; }
+    const std::unordered_map<Symbol, Timestamp>& last_update_time() const { return last_update_time_; }
+
+private:
+    // Latest bar dequeued per pending minute: the one that triggers its release
+    struct MinuteTrigger {
+        BarTrace trace;
+        uint64_t dequeued_ns = 0;
+    };
+
+    static constexpr size_t MAX_RECENT_LINES = 50;
+
+    void deliver(LiveReportEvent&& ev);
+    bool flush_overflow();
+    void report(LiveReportEvent&& ev);
+    void journal(LiveReportEvent::Kind kind, std::string bytes);
+    void journal_minute(uint64_t bar_id);
+    void check_trade_files();
+    void report_failure(const std::string& severity, const std::string& message,
+                        const std::string& offending_line);
+    void apply_reload(uint64_t bar_id);
+    void emit_orders(size_t instance, const MultiSymbolTrader& decider,
+                     std::unordered_map<Symbol, Position>& held, uint64_t bar_id, const MinuteTrigger& trigger, uint64_t decided_ns);
+    void add_bar(LiveIngestEvent& ev, LiveClock::time_point now);
+    void drain_snapshots();
+    void decide(SnapshotAssembler::Snapshot& snap);
+
+    LiveSession& session_;
+    const LiveConfig& config_;
+    MultiSymbolTrader& trader_;
+
+    // Minute-barrier assembly: one on_bar() per minute, not per incoming bar
+    SnapshotAssembler assembler_;
+    std::deque<std::string> recent_raw_lines_;      // For failure reports
+    std::deque<LiveReportEvent> overflow_;          // Must-deliver events the full report queue refused
+    std::unordered_map<Symbol, Position> last_positions_;   // Positions last minute, for order intents
+    std::map<uint64_t, MinuteTrigger> minute_triggers_;
+    LatencySpans minute_latency_;                   // Spans since the previous release
+    TradingConfig reloaded_;
+    uint64_t last_bar_id_;
+    int minutes_since_checkpoint_ = 0;
+    std::vector<std::string> trade_file_errors_;    // Last spill error per trader (0 = primary)
+
+    std::unordered_map<Symbol, Bar> market_snapshot_;   // Last snapshot sent to the traders
+    std::unordered_map<Symbol, Timestamp> last_update_time_;
+    size_t bars_processed_ = 0;
+    size_t snapshots_processed_ = 0;
+    size_t reports_dropped_ = 0;
+    size_t reports_deferred_ = 0;
+    size_t config_reloads_ = 0;
+    LatencySpans latency_;              // parse, handoff, assembly, on_bar, decision
+};
+
+LiveDecisionStage::LiveDecisionStage(LiveSession& session)
+    : session_(session),
+      config_(session.config),
+      trader_(*session.trader),
+      assembler_(session.config.symbols, std::chrono::milliseconds(session.config.snapshot_deadline_ms)),
+      last_bar_id_(session.resume_bar_id),
+      trade_file_errors_(1 + session.instances.size()) {
+    // A restored trader's positions were ordered before the restart
+    if (config_.resume) {
+        for (const auto& [sym, pos] : trader_.positions()) last_positions_[sym] = pos;
+    }
+}
+
+/**
+ * Only console events (bar/snapshot/status lines) are dropped when the
+ * report stage falls behind. Orders, latency rows (they flush the minute's
+ * order batch), reloads, failures and state journal records must not be
+ * lost (that would desync the broker or the journal), and the decision
+ * thread must not wait for the report stage either: they go to overflow_,
+ * which later events push out first, in order.
+ */
+void LiveDecisionStage::deliver(LiveReportEvent&& ev) {
+    if (flush_overflow() && session_.report_queue.try_push(std::move(ev))) return;
+    overflow_.push_back(std::move(ev));
+    reports_deferred_++;
+}
+
+/**
+ * Move held-back events into the report queue while it has room
+ * @return true once overflow_ is empty
+ */
+bool LiveDecisionStage::flush_overflow() {
+    while (!overflow_.empty()) {
+        if (!session_.report_queue.try_push(std::move(overflow_.front()))) return false;
+        overflow_.pop_front();
+    }
+    return true;
+}
+
+void LiveDecisionStage::report(LiveReportEvent&& ev) {
+    const bool droppable = ev.kind == LiveReportEvent::Kind::BAR_RECEIVED ||
+                           ev.kind == LiveReportEvent::Kind::SNAPSHOT ||
+                           ev.kind == LiveReportEvent::Kind::STATUS;
+    if (!droppable) {
+        deliver(std::move(ev));
+    } else if (!flush_overflow() || !session_.report_queue.try_push(std::move(ev))) {
+        reports_dropped_++;
+        LiveMetrics::increment(session_.metrics.reports_dropped);
+    }
+}
+
+void LiveDecisionStage::journal(LiveReportEvent::Kind kind, std::string bytes) {
+    LiveReportEvent ev;
+    ev.kind = kind;
+    ev.record = std::make_unique<std::string>(std::move(bytes));
+    deliver(std::move(ev));
+}
+
+void LiveDecisionStage::journal_minute(uint64_t bar_id) {
+    last_bar_id_ = bar_id;
+    if (!session_.state_journal) return;
+    journal(LiveReportEvent::Kind::JOURNAL, StateJournal::encode_minute(bar_id, market_snapshot_, trader_));
+    if (++minutes_since_checkpoint_ >= config_.checkpoint_interval) {
+        journal(LiveReportEvent::Kind::CHECKPOINT, StateJournal::encode_checkpoint(bar_id, trader_));
+        minutes_since_checkpoint_ = 0;
+    }
+}
+
+/**
+ * Trade file write failures: the journal keeps those trades in memory and
+ * retries on its own; report each new failure once
+ */
+void LiveDecisionStage::check_trade_files() {
+    auto check = [&](size_t index, const std::string& label, const MultiSymbolTrader& trader) {
+        std::string error = trader.trade_journal().write_error();
+        if (error == trade_file_errors_[index]) return;
+        if (!error.empty()) {
+            report_failure("WARN", label + "trade file " + trader.trade_journal().spill_path() + ": " + error +
+                                   " (trades kept in memory, retrying)", "");
+        }
+        trade_file_errors_[index] = std::move(error);
+    };
+    check(0, "", trader_);
+    for (size_t i = 0; i < session_.instances.size(); ++i) {
+        check(i + 1, session_.instances[i].name + ": ", *session_.instances[i].trader);
+    }
+}
+
+void LiveDecisionStage::report_failure(const std::string& severity, const std::string& message,
+                                       const std::string& offending_line) {
+    auto failure = std::make_unique<LiveFailureReport>();
+    failure->severity = severity;
+    failure->message = message;
+    failure->offending_line = offending_line;
+    failure->bars_processed = bars_processed_;
+    failure->snapshots_processed = snapshots_processed_;
+    failure->recent_raw_lines.assign(recent_raw_lines_.begin(), recent_raw_lines_.end());
+    for (const auto& [sym, _] : market_snapshot_) failure->symbols_present.push_back(sym);
+    for (const auto& [sym, pos] : trader_.positions()) {
+        failure->positions.push_back({sym, pos.shares, pos.entry_price});
+    }
+    LiveReportEvent ev;
+    ev.kind = LiveReportEvent::Kind::FAILURE;
+    ev.failure = std::move(failure);
+    report(std::move(ev));
+}
+
+/**
+ * Swap in reloaded parameters at a minute boundary: indicator history,
+ * positions and cash carry over (see MultiSymbolTrader::reconfigure)
+ */
+void LiveDecisionStage::apply_reload(uint64_t bar_id) {
+    if (!session_.config_watcher || !session_.config_watcher->take(reloaded_)) return;
+    try {
+        trader_.reconfigure(reloaded_);
+    } catch (const std::exception& e) {
+        report_failure("WARN", std::string("parameter reload not applied: ") + e.what(), "");
+        return;
+    }
+    if (session_.state_journal) {
+        journal(LiveReportEvent::Kind::JOURNAL, StateJournal::encode_reload(bar_id, trader_.config()));
+    }
+    config_reloads_++;
+    LiveMetrics::increment(session_.metrics.config_reloads);
+    LiveReportEvent ev;
+    ev.kind = LiveReportEvent::Kind::RELOAD;
+    ev.bar_id = bar_id;
+    ev.snapshots = config_reloads_;
+    report(std::move(ev));
+}
+
+/**
+ * Order intents: diff a trader's positions against what it held last minute
+ */
+void LiveDecisionStage::emit_orders(size_t instance, const MultiSymbolTrader& decider,
+                                    std::unordered_map<Symbol, Position>& held, uint64_t bar_id,
+                                    const MinuteTrigger& trigger, uint64_t decided_ns) {
+    const auto& positions = decider.positions();
+    auto order = [&](const Symbol& sym, int shares, const Position& pos, int position) {
+        LiveReportEvent ev;
+        ev.kind = LiveReportEvent::Kind::ORDER;
+        ev.instance = instance;
+        ev.symbol = sym;
+        ev.shares = shares;
+        auto bar = market_snapshot_.find(sym);
+        ev.price = (bar != market_snapshot_.end()) ? bar->second.close : pos.entry_price;
+        ev.position = position;
+        ev.entry_price = pos.entry_price;
+        ev.entry_bar_id = pos.entry_bar_id;
+        ev.bar_id = bar_id;
+        ev.trace_id = trigger.trace.trace_id;
+        ev.read_ns = trigger.trace.read_ns;
+        ev.decided_ns = decided_ns;
+        report(std::move(ev));
+    };
+    for (const auto& [sym, pos] : positions) {
+        auto it = held.find(sym);
+        int prev = (it != held.end()) ? it->second.shares : 0;
+        if (pos.shares != prev) order(sym, pos.shares - prev, pos, pos.shares);
+    }
+    for (const auto& [sym, prev] : held) {
+        if (prev.shares != 0 && positions.find(sym) == positions.end()) order(sym, -prev.shares, prev, 0);
+    }
+    held.clear();
+    for (const auto& [sym, pos] : positions) held[sym] = pos;
+}
+
+void LiveDecisionStage::add_bar(LiveIngestEvent& ev, LiveClock::time_point now) {
+    // Track raw line for failure reports
+    recent_raw_lines_.push_back(std::move(ev.raw));
+    if (recent_raw_lines_.size() > MAX_RECENT_LINES) recent_raw_lines_.pop_front();
+
+    const uint64_t dequeued_ns = trace_now_ns();
+    minute_latency_.record(LatencySpan::PARSE, ev.trace.parsed_ns - ev.trace.read_ns);
+    minute_latency_.record(LatencySpan::HANDOFF, dequeued_ns - ev.trace.parsed_ns);
+    minute_triggers_[ev.bar.bar_id] = {ev.trace, dequeued_ns};
+
+    last_update_time_[ev.bar.symbol] = ev.bar.timestamp;
+    assembler_.add_bar(ev.bar, now);
+    bars_processed_++;
+    LiveMetrics::increment(session_.metrics.bars);
+
+    // Log bar receipt (every 10th bar to reduce noise)
+    if (bars_processed_ % 10 == 0) {
+        LiveReportEvent rep;
+        rep.kind = LiveReportEvent::Kind::BAR_RECEIVED;
+        rep.symbol = ev.bar.symbol;
+        rep.price = ev.bar.close;
+        rep.bars = bars_processed_;
+        rep.snapshots = snapshots_processed_;
+        report(std::move(rep));
+    }
+}
+
+/**
+ * Release every ready snapshot to the traders (one pass per minute)
+ */
+void LiveDecisionStage::drain_snapshots() {
+    SnapshotAssembler::Snapshot snap;
+    while (assembler_.pop_ready(snap)) {
+        if (snap.bar_id <= session_.resume_bar_id) continue;    // Already replayed from the state journal
+        decide(snap);
+    }
+}
+
+/**
+ * One minute: reload, every trader's on_bar, order intents, journal and reports
+ */
+void LiveDecisionStage::decide(SnapshotAssembler::Snapshot& snap) {
+    LiveMetrics& metrics = session_.metrics;
+    auto& instances = session_.instances;
+    apply_reload(snap.bar_id);
+
+    MinuteTrigger trigger;
+    auto trig_it = minute_triggers_.find(snap.bar_id);
+    if (trig_it != minute_triggers_.end()) trigger = trig_it->second;
+    minute_triggers_.erase(minute_triggers_.begin(), minute_triggers_.upper_bound(snap.bar_id));
+
+    market_snapshot_ = std::move(snap.bars);
+    const uint64_t on_bar_start = trace_now_ns();
+    // Extra instances decide on the pool while the primary decides here
+    for (auto& inst : instances) {
+        LiveInstance* instance = &inst;
+        const auto* snapshot = &market_snapshot_;
+        session_.instance_pool->submit([instance, snapshot]() {
+            try {
+                instance->trader->on_bar(*snapshot);
+            } catch (const std::exception& e) {
+                instance->error = e.what();
+            }
+        });
+    }
+    bool decided = true;
+    try {
+        trader_.on_bar(market_snapshot_);
+    } catch (const std::exception& e) {
+        report_failure("WARN", std::string("exception: ") + e.what(), "");
+        decided = false;
+    }
+    if (session_.instance_pool) session_.instance_pool->wait_idle();
+    const uint64_t on_bar_end = trace_now_ns();
+    for (size_t i = 0; i < instances.size(); ++i) {
+        auto& inst = instances[i];
+        if (!inst.error.empty()) {
+            report_failure("WARN", inst.name + ": exception: " + inst.error, "");
+            inst.error.clear();
+        }
+        emit_orders(i + 1, *inst.trader, inst.last_positions, snap.bar_id, trigger, on_bar_end);
+    }
+    journal_minute(snap.bar_id);
+    check_trade_files();
+    if (!decided) return;
+    snapshots_processed_++;
+    LiveMetrics::increment(metrics.snapshots);
+
+    minute_latency_.record(LatencySpan::ON_BAR, on_bar_end - on_bar_start);
+    if (trigger.trace.trace_id != 0) {
+        minute_latency_.record(LatencySpan::ASSEMBLY, on_bar_start - trigger.dequeued_ns);
+        minute_latency_.record(LatencySpan::DECISION, on_bar_end - trigger.trace.read_ns);
+    }
+
+    // Order intents of the primary trader
+    emit_orders(0, trader_, last_positions_, snap.bar_id, trigger, on_bar_end);
+    const auto& positions = trader_.positions();
+
+    LiveMetrics::set(metrics.equity, trader_.get_equity(market_snapshot_));
+    LiveMetrics::set(metrics.cash, trader_.cash());
+    LiveMetrics::set(metrics.open_positions, static_cast<uint64_t>(positions.size()));
+    LiveMetrics::set(metrics.trades, static_cast<uint64_t>(trader_.total_trades()));
+
+    // Minute latency row (sent after this minute's orders, so the report
+    // stage can add their emit spans before writing it)
+    {
+        LiveReportEvent ev;
+        ev.kind = LiveReportEvent::Kind::LATENCY;
+        ev.latency = std::make_unique<MinuteLatencyReport>();
+        ev.latency->bar_id = snap.bar_id;
+        ev.latency->trace_id = trigger.trace.trace_id;
+        ev.latency->complete = snap.complete;
+        for (size_t i = 0; i < LatencySpans::NUM_SPANS; ++i) {
+            ev.latency->spans[i] = minute_latency_.summary(static_cast<LatencySpan>(i));
+        }
+        report(std::move(ev));
+        latency_.merge(minute_latency_);
+        minute_latency_.reset();
+    }
+
+    if (snap.stale_count > 0 && config_.verbose) {
+        LiveReportEvent ev;
+        ev.kind = LiveReportEvent::Kind::SNAPSHOT;
+        ev.bar_id = snap.bar_id;
+        ev.fresh = snap.fresh_count;
+        ev.stale = snap.stale_count;
+        report(std::move(ev));
+    }
+
+    if (snapshots_processed_ % 5 == 0) {
+        auto results = trader_.get_results();
+        LiveReportEvent ev;
+        ev.kind = LiveReportEvent::Kind::STATUS;
+        ev.snapshots = snapshots_processed_;
+        ev.equity = trader_.get_equity(market_snapshot_);
+        ev.return_pct = (ev.equity - config_.capital) / config_.capital * 100;
+        ev.trades = results.total_trades;
+        ev.positions = positions.size();
+        ev.win_rate = results.win_rate;
+        report(std::move(ev));
+    }
+}
+
+void LiveDecisionStage::run() {
+    utils::set_current_thread_name("sentio-decide");
+    utils::pin_current_thread(config_.pin_decision_core);
+    const LiveClock& clock = session_.clock();
+
+    SpinBackoff backoff;
+    LiveIngestEvent ev;
+    bool done = false;
+    while (!done) {
+        if (!session_.bar_queue.try_pop(ev)) {
+            // Idle: only snapshot deadlines can produce work (a feed-driven
+            // clock has not moved since the last event, so there is nothing to poll)
+            if (!clock.feed_driven()) {
+                assembler_.poll(clock.now());
+                drain_snapshots();
+            }
+            flush_overflow();
+            backoff.idle();
+            continue;
+        }
+        backoff.reset();
+        const LiveClock::time_point now = clock.feed_driven() ? ev.arrived : clock.now();
+
+        switch (ev.kind) {
+            case LiveIngestEvent::Kind::END:
+                done = true;
+                break;
+
+            case LiveIngestEvent::Kind::PARSE_ERROR:
+                LiveMetrics::increment(session_.metrics.parse_errors);
+                report_failure("WARN", ev.error, ev.raw);
+                break;
+
+            case LiveIngestEvent::Kind::BAR:
+                add_bar(ev, now);
+                break;
+        }
+
+        // Release minutes that completed or hit their deadline
+        assembler_.poll(now);
+        drain_snapshots();
+    }
+
+    // Feed closed - release whatever is still pending
+    assembler_.flush();
+    drain_snapshots();
+    if (session_.state_journal && minutes_since_checkpoint_ > 0) {
+        journal(LiveReportEvent::Kind::CHECKPOINT, StateJournal::encode_checkpoint(last_bar_id_, trader_));
+    }
+
+    // Trading is over: now the decision thread may wait for the report stage
+    LiveReportEvent end;
+    end.kind = LiveReportEvent::Kind::END;
+    overflow_.push_back(std::move(end));
+    while (!flush_overflow()) std::this_thread::yield();
+}
+
+/**
+ * Stage 3: all I/O on behalf of the decision stage - console lines, orders
+ * files and gateway batches, latency rows, the metrics file and state
+ * journal writes. The only stage that touches the gateways and the journal.
+ *
+ * Console output is formatted locally and written with fwrite, so nothing
+ * here shares std::cout's format state with another thread. The traders
+ * run quiet: their entries and exits are printed from the order intents.
+ */
+class LiveReportStage {
+public:
+    explicit LiveReportStage(LiveSession& session);
+
+    void run();
+
+    const LatencySpans& latency() const { return latency_; }    // emit, end_to_end
+    size_t latency_minutes() const { return latency_minutes_; }
+    size_t minutes_over_budget() const { return minutes_over_budget_; }
+    size_t legs_held() const;
+
+    /**
+     * Where each trader's intents went (call after run())
+     */
+    std::vector<LiveRouteResult> route_results() const;
+
+private:
+    // One order route per trader (index = LiveReportEvent::instance): its
+    // orders file, its gateway and the legs not yet taken by the gateway -
+    // the minute being reported, plus any batch a full backlog refused
+    struct OrderRoute {
+        std::string label;          // Empty for the primary trader
+        const std::string* path = nullptr;
+        OrderGateway* gateway = nullptr;
+        std::ofstream out;
+        OrderBatch batch;
+        bool held = false;          // batch was refused and is waiting for room
+        uint64_t next_order_id = 1;
+        uint64_t next_batch_id = 1;
+        size_t orders = 0;
+        std::unordered_map<Symbol, int> routed;     // Net shares of the batches the gateway took
+    };
+
+    FILE* handle(LiveReportEvent& ev);
+    void record_order(const LiveReportEvent& ev);
+    FILE* record_latency(MinuteLatencyReport& row);
+    void submit_batches();
+    void publish_metrics();
+    void check_rejected_reloads();
+    void write_state(const LiveReportEvent& ev);
+    void finish();
+
+    LiveSession& session_;
+    const LiveConfig& config_;
+
+    std::ostringstream msg_;
+    std::vector<OrderRoute> routes_;
+    std::ofstream latency_out_;
+    LatencySpans minute_orders_;        // Order spans of the minute being reported
+
+    // Metrics file: per-minute spans (assembly, on_bar, decision) plus
+    // every order's emit/end_to_end, rewritten on a timer even when idle
+    LatencySpans metrics_latency_;
+    const bool metrics_enabled_;
+    const std::chrono::milliseconds metrics_interval_;
+    std::chrono::steady_clock::time_point next_publish_;
+    bool metrics_warned_ = false;
+
+    uint64_t reloads_rejected_seen_ = 0;
+    bool journal_failed_ = false;
+
+    LatencySpans latency_;
+    size_t latency_minutes_ = 0;
+    size_t minutes_over_budget_ = 0;
+};
+
+LiveReportStage::LiveReportStage(LiveSession& session)
+    : session_(session),
+      config_(session.config),
+      routes_(1 + session.instances.size()),
+      metrics_enabled_(session.config.metrics_interval_ms > 0 && !session.config.metrics_file.empty()),
+      metrics_interval_(session.config.metrics_interval_ms),
+      next_publish_(std::chrono::steady_clock::now()) {
+    routes_[0].path = &session.orders_path;
+    routes_[0].gateway = session.gateway.get();
+    for (size_t i = 0; i < session.instances.size(); ++i) {
+        routes_[i + 1].label = session.instances[i].name;
+        routes_[i + 1].path = &session.instances[i].orders_path;
+        routes_[i + 1].gateway = session.instances[i].gateway.get();
+    }
+}
+
+/**
+ * Hand each route's pending legs to its gateway. A refused batch stays on
+ * the route: later minutes net their legs into it and it is offered again
+ * with every minute, so the broker never misses a position change.
+ */
+void LiveReportStage::submit_batches() {
+    for (auto& route : routes_) {
+        if (!route.gateway || route.batch.legs.empty()) continue;
+        const std::string gateway = route.label.empty() ? "Order gateway" : "Order gateway " + route.label;
+        route.batch.batch_id = route.next_batch_id;
+        for (const auto& leg : route.batch.legs) route.routed[leg.symbol] += leg.qty;
+        const size_t legs = route.batch.legs.size();
+        if (!route.gateway->submit(std::move(route.batch))) {
+            for (const auto& leg : route.batch.legs) route.routed[leg.symbol] -= leg.qty;
+            if (!route.held) {
+                msg_ << "⚠️  " << gateway << " backlog full: holding " << legs << " legs from bar_id "
+                     << route.batch.bar_id << " for the next batch\n";
+            }
+            route.held = true;
+            continue;
+        }
+        if (route.held) {
+            msg_ << "✅ " << gateway << " backlog cleared: held legs sent in batch " << route.next_batch_id << "\n";
+        }
+        route.held = false;
+        route.next_batch_id++;
+        route.batch.legs.clear();
+    }
+}
+
+size_t LiveReportStage::legs_held() const {
+    size_t legs = 0;
+    for (const auto& route : routes_) legs += route.batch.legs.size();
+    return legs;
+}
+
+std::vector<LiveRouteResult> LiveReportStage::route_results() const {
+    std::vector<LiveRouteResult> results;
+    for (size_t i = 0; i < routes_.size(); ++i) {
+        const OrderRoute& route = routes_[i];
+        const MultiSymbolTrader& trader = (i == 0) ? *session_.trader : *session_.instances[i - 1].trader;
+        LiveRouteResult result;
+        result.label = route.label;
+        for (const auto& [sym, pos] : trader.positions()) result.positions[sym] = pos.shares;
+        result.routed = route.routed;
+        for (const auto& leg : route.batch.legs) result.routed[leg.symbol] += leg.qty;
+        result.orders = route.orders;
+        result.legs_held = route.batch.legs.size();
+        if (route.gateway) result.batches_rejected = route.gateway->stats().batches_rejected.load();
+        results.push_back(std::move(result));
+    }
+    return results;
+}
+
+void LiveReportStage::publish_metrics() {
+    LiveMetrics& metrics = session_.metrics;
+    LiveMetrics::set(metrics.bar_queue_depth, session_.bar_queue.size_approx());
+    LiveMetrics::set(metrics.report_queue_depth, session_.report_queue.size_approx());
+    if (session_.gateway) {
+        const auto& gs = session_.gateway->stats();
+        LiveMetrics::set(metrics.order_batches_sent, gs.batches_sent.load(std::memory_order_relaxed));
+        LiveMetrics::set(metrics.order_batches_rejected, gs.batches_rejected.load(std::memory_order_relaxed));
+        LiveMetrics::set(metrics.orders_filled, gs.orders_filled.load(std::memory_order_relaxed));
+        LiveMetrics::set(metrics.orders_broker_rejected, gs.orders_rejected.load(std::memory_order_relaxed));
+        LiveMetrics::set(metrics.gateway_pending, gs.pending_batches.load(std::memory_order_relaxed));
+    }
+    if (session_.config_watcher) {
+        LiveMetrics::set(metrics.config_reloads_rejected,
+                         session_.config_watcher->stats().rejected.load(std::memory_order_relaxed));
+    }
+    std::ostringstream text;
+    metrics.write_prometheus(text, metrics_latency_);
+    const auto parent = std::filesystem::path(config_.metrics_file).parent_path();
+    std::error_code ec;
+    if (!parent.empty()) std::filesystem::create_directories(parent, ec);
+    if (!publish_metrics_file(config_.metrics_file, text.str()) && !metrics_warned_) {
+        metrics_warned_ = true;
+        const std::string warning = "⚠️  Cannot write metrics file " + config_.metrics_file + "\n";
+        std::fwrite(warning.data(), 1, warning.size(), stderr);
+    }
+}
+
+/**
+ * Rejected reloads never reach the decision stage: report them from the watcher's stats
+ */
+void LiveReportStage::check_rejected_reloads() {
+    if (!session_.config_watcher) return;
+    const uint64_t rejected = session_.config_watcher->stats().rejected.load(std::memory_order_acquire);
+    if (rejected == reloads_rejected_seen_) return;
+    reloads_rejected_seen_ = rejected;
+    const std::string warning = "⚠️  Parameter reload rejected, keeping current parameters: " +
+                                session_.config_watcher->last_error() + "\n";
+    std::fwrite(warning.data(), 1, warning.size(), stderr);
+    std::fflush(stderr);
+}
+
+/**
+ * A failed write stops journaling (trading goes on, but a restart could no
+ * longer resume, so say so loudly)
+ */
+void LiveReportStage::write_state(const LiveReportEvent& ev) {
+    if (!session_.state_journal || journal_failed_) return;
+    try {
+        if (ev.kind == LiveReportEvent::Kind::CHECKPOINT) {
+            session_.state_journal->write_checkpoint(*ev.record);
+        } else {
+            session_.state_journal->append(*ev.record);
+        }
+    } catch (const std::exception& e) {
+        journal_failed_ = true;
+        msg_ << "❌ State journal disabled, --resume will not cover this session: " << e.what() << "\n";
+    }
+}
+
+void LiveReportStage::record_order(const LiveReportEvent& ev) {
+    auto& route = routes_[ev.instance];
+    const uint64_t order_id = route.next_order_id++;
+    if (!route.out.is_open()) {
+        std::filesystem::create_directories("logs/live");
+        route.out.open(*route.path, std::ios::app);
+    }
+    route.out << "{\"symbol\":\"" << ev.symbol << "\","
+              << "\"side\":\"" << (ev.shares > 0 ? "BUY" : "SELL") << "\","
+              << "\"qty\":" << std::abs(ev.shares) << ","
+              << "\"ref_price\":" << ev.price << ","
+              << "\"bar_id\":" << ev.bar_id << ","
+              << "\"trace_id\":" << ev.trace_id << ","
+              << "\"order_id\":" << order_id << "}\n";
+    route.out.flush();
+    LiveMetrics::increment(session_.metrics.orders);
+    route.orders++;
+
+    // The primary's entries and exits (instances run quiet)
+    if (ev.instance == 0 && ev.position == ev.shares) {
+        msg_ << "  [ENTRY] " << ev.symbol << " " << ev.shares << " sh at $" << std::fixed
+             << std::setprecision(2) << ev.price << " (bar_id " << ev.bar_id << ")\n";
+    } else if (ev.instance == 0 && ev.position == 0 && ev.entry_price > 0.0) {
+        const double pnl_pct = (ev.price - ev.entry_price) / ev.entry_price * (ev.shares < 0 ? 100.0 : -100.0);
+        msg_ << "  [EXIT] " << ev.symbol << " at $" << std::fixed << std::setprecision(2) << ev.price
+             << " | P&L: " << std::showpos << pnl_pct << std::noshowpos << "%"
+             << " | Held: " << (ev.bar_id - ev.entry_bar_id) << " bars\n";
+    }
+    if (route.gateway) {
+        // A minute has one leg per symbol, so a match is a held leg: net into
+        // it (under the newer order id) rather than send both
+        route.batch.bar_id = ev.bar_id;
+        auto leg = std::find_if(route.batch.legs.begin(), route.batch.legs.end(),
+                                [&](const OrderLeg& l) { return l.symbol == ev.symbol; });
+        if (leg == route.batch.legs.end()) {
+            route.batch.legs.push_back({order_id, ev.symbol, ev.shares, ev.price});
+        } else if (leg->qty + ev.shares == 0) {
+            route.batch.legs.erase(leg);
+        } else {
+            *leg = {order_id, ev.symbol, leg->qty + ev.shares, ev.price};
+        }
+    }
+
+    const uint64_t emitted_ns = trace_now_ns();
+    minute_orders_.record(LatencySpan::EMIT, emitted_ns - ev.decided_ns);
+    if (ev.trace_id != 0) {
+        minute_orders_.record(LatencySpan::END_TO_END, emitted_ns - ev.read_ns);
+    }
+}
+
+/**
+ * The minute's orders have all arrived: send them, then write its latency row
+ * @return stream for the console line (stderr when the minute was over budget)
+ */
+FILE* LiveReportStage::record_latency(MinuteLatencyReport& row) {
+    // Exits + entries go out as one batch per trader
+    submit_batches();
+
+    row[LatencySpan::EMIT] = minute_orders_.summary(LatencySpan::EMIT);
+    row[LatencySpan::END_TO_END] = minute_orders_.summary(LatencySpan::END_TO_END);
+    latency_.merge(minute_orders_);
+    metrics_latency_.merge(minute_orders_);
+    minute_orders_.reset();
+    for (LatencySpan span : {LatencySpan::ASSEMBLY, LatencySpan::ON_BAR, LatencySpan::DECISION}) {
+        if (row[span].count > 0) {
+            metrics_latency_.record(span, static_cast<uint64_t>(row[span].max_us * 1000.0));
+        }
+    }
+
+    const bool over_budget = row.decision_ms() > config_.latency_budget_ms;
+    latency_minutes_++;
+    if (!latency_out_.is_open()) {
+        std::filesystem::create_directories("logs/live");
+        latency_out_.open(session_.latency_path, std::ios::app);
+    }
+    row.write_json(latency_out_, over_budget);
+    latency_out_ << "\n";
+    latency_out_.flush();
+
+    if (!over_budget) return stdout;
+    minutes_over_budget_++;
+    LiveMetrics::increment(session_.metrics.minutes_over_budget);
+    msg_ << "⏱️  [LATENCY] bar_id " << row.bar_id << " (trace " << row.trace_id
+         << "): decision " << std::fixed << std::setprecision(1) << row.decision_ms()
+         << " ms > budget " << config_.latency_budget_ms << " ms"
+         << (row.complete ? "" : " (released by deadline)") << "\n";
+    return stderr;
+}
+
+/**
+ * Act on one event; its console text is left in msg_
+ * @return stream the console text goes to
+ */
+FILE* LiveReportStage::handle(LiveReportEvent& ev) {
+    FILE* console = stdout;
+    switch (ev.kind) {
+        case LiveReportEvent::Kind::BAR_RECEIVED: {
+            auto now = std::chrono::system_clock::now();
+            auto time_t_now = std::chrono::system_clock::to_time_t(now);
+            struct tm tm_now;
+            localtime_r(&time_t_now, &tm_now);
+            char time_str[10];
+            strftime(time_str, sizeof(time_str), "%H:%M:%S", &tm_now);
+
+            msg_ << "[" << time_str << "] "
+                 << ev.symbol << " @ " << std::setprecision(2) << std::fixed
+                 << ev.price << " | Bars: " << ev.bars
+                 << " | Snapshots: " << ev.snapshots << "\n";
+            break;
+        }
+        case LiveReportEvent::Kind::SNAPSHOT:
+            msg_ << "  [SNAPSHOT] bar_id " << ev.bar_id << ": "
+                 << ev.fresh << " fresh, " << ev.stale << " carried forward\n";
+            break;
+
+        case LiveReportEvent::Kind::STATUS:
+            msg_ << "\n📊 [Status Update] Snapshot " << ev.snapshots << "\n";
+            msg_ << "   Equity: $" << std::fixed << std::setprecision(2) << ev.equity;
+            msg_ << " (" << std::showpos << ev.return_pct << std::noshowpos << "%)\n";
+            msg_ << "   Trades: " << ev.trades;
+            msg_ << " | Positions: " << ev.positions << "\n";
+            msg_ << "   Win Rate: " << std::setprecision(1)
+                 << (ev.win_rate * 100) << "%\n\n";
+            break;
+
+        case LiveReportEvent::Kind::ORDER:
+            record_order(ev);
+            break;
+
+        case LiveReportEvent::Kind::LATENCY:
+            console = record_latency(*ev.latency);
+            break;
+
+        case LiveReportEvent::Kind::RELOAD:
+            msg_ << "🔄 [RELOAD] New parameters from " << config_.config_dir << "/ in effect from bar_id "
+                 << ev.bar_id << " (reload #" << ev.snapshots << "; positions and indicator history kept)\n";
+            break;
+
+        case LiveReportEvent::Kind::JOURNAL:
+        case LiveReportEvent::Kind::CHECKPOINT:
+            console = stderr;
+            write_state(ev);
+            break;
+
+        case LiveReportEvent::Kind::FAILURE:
+            console = stderr;
+            msg_ << "⚠️  " << ev.failure->message << "\n";
+            write_live_failure_report(*ev.failure, config_.symbols);
+            break;
+
+        case LiveReportEvent::Kind::END:
+            break;
+    }
+    return console;
+}
+
+/**
+ * After END: orders of a last minute that sent no latency row (the primary's
+ * on_bar threw) and legs a full backlog is holding, offered until the
+ * gateways' drain timeout; then let the gateways drain so the final metrics
+ * include their last responses
+ */
+void LiveReportStage::finish() {
+    msg_.str("");
+    submit_batches();
+    const auto deadline = std::chrono::steady_clock::now() + OrderGateway::Options{}.drain_timeout;
+    while (legs_held() > 0 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        submit_batches();
+    }
+    for (const auto& route : routes_) {
+        if (route.batch.legs.empty()) continue;
+        msg_ << "⚠️  Order gateway" << (route.label.empty() ? "" : " " + route.label) << ": "
+             << route.batch.legs.size() << " legs never sent (backlog still full at session end; see "
+             << *route.path << ")\n";
+    }
+    if (!msg_.str().empty()) {
+        const std::string text = msg_.str();
+        std::fwrite(text.data(), 1, text.size(), stderr);
+    }
+    if (session_.gateway) session_.gateway->stop();
+    for (auto& instance : session_.instances) {
+        if (instance.gateway) instance.gateway->stop();
+    }
+    check_rejected_reloads();
+
+    // Final values (the decision stage has finished before sending END)
+    LiveMetrics::set(session_.metrics.running, false);
+    if (metrics_enabled_) publish_metrics();
+}
+
+void LiveReportStage::run() {
+    utils::set_current_thread_name("sentio-report");
+    utils::pin_current_thread(config_.pin_report_core);
+
+    SpinBackoff backoff;
+    LiveReportEvent ev;
+    while (true) {
+        if (metrics_enabled_ && std::chrono::steady_clock::now() >= next_publish_) {
+            publish_metrics();
+            next_publish_ = std::chrono::steady_clock::now() + metrics_interval_;
+        }
+        check_rejected_reloads();
+        if (!session_.report_queue.try_pop(ev)) {
+            backoff.idle();
+            continue;
+        }
+        backoff.reset();
+        if (ev.kind == LiveReportEvent::Kind::END) break;
+
+        msg_.str("");
+        FILE* console = handle(ev);
+        ev.failure.reset();
+        ev.latency.reset();
+        ev.record.reset();
+
+        const std::string text = msg_.str();
+        if (!text.empty()) {
+            std::fwrite(text.data(), 1, text.size(), console);
+            std::fflush(console);
+        }
+    }
+    finish();
+}
+
+/**
+ * End-of-session report: counters, performance, instances and latency (the
+ * latency summary is also appended to the latency file)
+ */
+void print_live_summary(const LiveSession& session, const LiveDecisionStage& decision,
+                        const LiveReportStage& report) {
+    const LiveConfig& config = session.config;
+    const MultiSymbolTrader& trader = *session.trader;
+
+    // End of day - show final results
+    std::cout << "\n═══════════════════════════════════════════════════════════════\n";
+    std::cout << "🏁 LIVE SESSION COMPLETE\n\n";
+
+    // Note: EOD liquidation is handled automatically by the trader's
+    // internal logic when it detects end of day timestamp
+
+    // Get final results
+    auto results = trader.get_results();
+    double final_equity = trader.get_equity(decision.market_snapshot());
+
+    // Show open positions if any remain
+    if (!trader.positions().empty()) {
+        std::cout << "⚠️  Open positions at session end: " << trader.positions().size() << "\n";
+        std::cout << "   (These will be automatically closed at market close)\n\n";
+    }
+
+    // Print results
+    std::cout << "\n";
+    std::cout << "╔════════════════════════════════════════════════════════════╗\n";
+    std::cout << "║                 LIVE SESSION Results                       ║\n";
+    std::cout << "╚════════════════════════════════════════════════════════════╝\n";
+    std::cout << "\n";
+
+    std::cout << "Session Summary:\n";
+    std::cout << "  Bars Processed:     " << decision.bars_processed() << "\n";
+    std::cout << "  Snapshots:          " << decision.snapshots_processed() << "\n";
+    {
+        const auto& st = decision.snapshot_stats();
+        std::cout << "    Complete:         " << st.released_complete << "\n";
+        std::cout << "    By Deadline:      " << st.released_by_deadline << "\n";
+        std::cout << "    Stale Bars:       " << st.stale_bars << "\n";
+        std::cout << "    Late/Duplicate:   " << st.late_bars << " / " << st.duplicate_bars << "\n";
+        if (st.unknown_bars > 0) {
+            std::cout << "    ⚠️  Unknown Symbol: " << st.unknown_bars << " bars dropped (not a configured symbol)\n";
+        }
+    }
+    if (decision.reports_dropped() > 0) {
+        std::cout << "  Reports Dropped:    " << decision.reports_dropped()
+                  << " console lines (report stage fell behind)\n";
+    }
+    if (decision.reports_deferred() > 0) {
+        std::cout << "  Reports Deferred:   " << decision.reports_deferred()
+                  << " events held by the decision stage until the report queue had room\n";
+    }
+    if (session.config_watcher) {
+        std::cout << "  Param Reloads:      " << decision.config_reloads() << " applied";
+        const uint64_t rejected = session.config_watcher->stats().rejected.load();
+        if (rejected > 0) std::cout << ", " << rejected << " rejected";
+        std::cout << "\n";
+    }
+    if (session.state_journal) {
+        std::cout << "  State Journal:      " << session.state_journal->records_appended() << " records, "
+                  << session.state_journal->checkpoints_written() << " checkpoints → " << config.state_dir << "/\n";
+    }
+    if (session.gateway) {
+        const auto& gs = session.gateway->stats();
+        std::cout << "  Order Batches:      " << gs.batches_sent.load() << " sent";
+        if (gs.batches_rejected.load() > 0) std::cout << ", " << gs.batches_rejected.load() << " rejected (backlog)";
+        if (gs.pending_batches.load() > 0) std::cout << ", " << gs.pending_batches.load() << " unsent";
+        std::cout << "\n";
+        if (report.legs_held() > 0) {
+            std::cout << "  ⚠️  Orders Held:     " << report.legs_held() << " legs never reached a gateway\n";
+        }
+        std::cout << "  Orders:             " << gs.orders_sent.load() << " sent, "
+                  << gs.orders_filled.load() << " filled, " << gs.orders_rejected.load() << " rejected, "
+                  << session.gateway->outstanding() << " awaiting response\n";
+        const auto& ack = session.gateway->ack_latency();
+        if (ack.count() > 0) {
+            std::cout << "  Broker Ack (ms):    p50 " << std::fixed << std::setprecision(1)
+                      << ack.percentile(0.50) / 1e6 << ", p99 " << ack.percentile(0.99) / 1e6
+                      << ", max " << ack.max() / 1e6 << "\n";
+        }
+    }
+    std::cout << "\n";
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Performance:\n";
+    std::cout << "  Initial Capital:    $" << config.capital << "\n";
+    std::cout << "  Final Equity:       $" << final_equity << "\n";
+    std::cout << "  Total Return:       " << std::showpos << (results.total_return * 100)
+              << std::noshowpos << "%\n";
+    std::cout << "  Max Drawdown:       " << (results.max_drawdown * 100) << "%\n";
+    std::cout << "\n";
+
+    std::cout << "Trade Statistics:\n";
+    std::cout << "  Total Trades:       " << results.total_trades << "\n";
+    std::cout << "  Winning Trades:     " << results.winning_trades << "\n";
+    std::cout << "  Losing Trades:      " << results.losing_trades << "\n";
+    std::cout << std::setprecision(1);
+    std::cout << "  Win Rate:           " << (results.win_rate * 100) << "%\n";
+    std::cout << std::setprecision(2);
+    if (results.total_trades > 0) {
+        std::cout << "  Average Win:        $" << results.avg_win << "\n";
+        std::cout << "  Average Loss:       $" << results.avg_loss << "\n";
+        std::cout << "  Profit Factor:      " << results.profit_factor << "\n";
+    }
+    std::cout << "\n";
+
+    if (!session.instances.empty()) {
+        std::cout << "Instances:\n";
+        for (const auto& instance : session.instances) {
+            auto r = instance.trader->get_results();
+            std::cout << "  " << std::left << std::setw(18) << (instance.name + ":") << std::right
+                      << "$" << instance.trader->get_equity(decision.market_snapshot())
+                      << "  (" << std::showpos << (r.total_return * 100) << std::noshowpos << "%, "
+                      << r.total_trades << " trades, " << std::setprecision(1) << (r.win_rate * 100)
+                      << "% win)" << std::setprecision(2) << "\n";
+            std::cout << "    Orders:           " << instance.orders_path << "\n";
+            if (instance.gateway) {
+                const auto& gs = instance.gateway->stats();
+                std::cout << "    Gateway:          " << gs.batches_sent.load() << " batches, "
+                          << gs.orders_filled.load() << " filled, " << gs.orders_rejected.load()
+                          << " rejected, " << instance.gateway->outstanding() << " awaiting response\n";
+            }
+        }
+        std::cout << "\n";
+    }
+
+    if (!trader.stage_profile().empty()) {
+        trader.stage_profile().print(std::cout);
+        std::cout << "\n";
+    }
+
+    // Session latency: bar read → order written, merged across stages
+    LatencySpans session_latency = decision.latency();
+    session_latency.merge(report.latency());
+    std::cout << "Latency (µs, " << report.latency_minutes() << " minutes, "
+              << report.minutes_over_budget() << " over the " << config.latency_budget_ms
+              << " ms budget):\n";
+    session_latency.print(std::cout);
+    std::cout << "\n";
+
+    std::ofstream latency_out(session.latency_path, std::ios::app);
+    if (latency_out.is_open()) {
+        latency_out << std::fixed << std::setprecision(3)
+                    << "{\"session\":true,\"minutes\":" << report.latency_minutes()
+                    << ",\"over_budget\":" << report.minutes_over_budget()
+                    << ",\"budget_ms\":" << config.latency_budget_ms << ",\"spans\":";
+        session_latency.write_json(latency_out);
+        latency_out << "}\n";
+    }
+}
+
+/**
+ * Export results and trades for dashboard/reporting (failures are reported, not fatal)
+ */
+void export_live_results(const LiveSession& session, const LiveDecisionStage& decision) {
+    const LiveConfig& config = session.config;
+    const MultiSymbolTrader& trader = *session.trader;
+    try {
+        // Build symbols string
+        std::string symbols_str;
+        for (size_t i = 0; i < config.symbols.size(); ++i) {
+            symbols_str += config.symbols[i];
+            if (i < config.symbols.size() - 1) symbols_str += ",";
+        }
+
+        // Derive session date range from last_update_time timestamps
+        std::string start_date_str;
+        std::string end_date_str;
+        const auto& last_update_time = decision.last_update_time();
+        if (!last_update_time.empty()) {
+            auto minmax = std::minmax_element(
+                last_update_time.begin(), last_update_time.end(),
+                [](const auto& a, const auto& b){ return a.second < b.second; }
+            );
+            auto to_date = [](const Timestamp& ts){
+                auto secs = std::chrono::duration_cast<std::chrono::seconds>(ts.time_since_epoch()).count();
+                time_t t = static_cast<time_t>(secs);
+                struct tm* tm_info = localtime(&t);
+                char buf[11];
+                strftime(buf, sizeof(buf), "%Y-%m-%d", tm_info);
+                return std::string(buf);
+            };
+            start_date_str = to_date(minmax.first->second);
+            end_date_str = to_date(minmax.second->second);
+        }
+
+        // Empty filtered bars placeholder (dashboard can load from data directory)
+        std::unordered_map<Symbol, std::vector<Bar>> empty_filtered;
+
+        ResultsExporter::export_json(
+            trader.get_results(), trader, config.results_file,
+            symbols_str, "LIVE",
+            start_date_str, end_date_str,
+            empty_filtered
+        );
+
+        ResultsExporter::export_trades_jsonl(trader, config.trades_file);
+
+        std::cout << "\n✅ Results exported to: " << config.results_file << "\n";
+        std::cout << "✅ Trades exported to: " << config.trades_file << "\n";
+    } catch (const std::exception& e) {
+        std::cerr << "⚠️  Live export failed: " << e.what() << "\n";
+    }
+}
+
+} // namespace
+
+LiveSessionResult run_live_session(LiveConfig& config) {
+    LiveSessionResult result;
+    result.exit_code = 1;
+    try {
+        LiveSession session(config);
+        if (!configure_live_session(session)) return result;
+        if (!start_live_traders(session)) return result;
+        if (!open_live_io(session)) return result;
+
+        // ====================================================================
+        // Staged pipeline
+        //   ingest (read + parse) ──bar_queue──▶ decide (assembler + trader)
+        //                         ──report_queue──▶ order/report (stdout, files)
+        // Stages talk only through preallocated SPSC queues. The decision stage
+        // never blocks on console output: if the report stage falls behind,
+        // console events are dropped and counted, everything else is deferred.
+        // ====================================================================
+        LiveIngestStage ingest(session);
+        LiveDecisionStage decision(session);
+        LiveReportStage report(session);
+
+        std::thread ingest_thread([&ingest]() { ingest.run(); });
+        std::thread decision_thread([&decision]() { decision.run(); });
+        std::thread report_thread([&report]() { report.run(); });
+        ingest_thread.join();
+        decision_thread.join();
+        report_thread.join();
+        if (session.config_watcher) session.config_watcher->stop();
+
+        result.routes = report.route_results();
+        if (ingest.failed()) {
+            return result;
+        }
+
+        print_live_summary(session, decision, report);
+        export_live_results(session, decision);
+        result.exit_code = 0;
+        return result;
+
+    } catch (const std::exception& e) {
+        try {
+            std::filesystem::create_directories("logs/live");
+            auto now = std::chrono::system_clock::now();
+            std::time_t tnow = std::chrono::system_clock::to_time_t(now);
+            char tsbuf[20];
+            std::strftime(tsbuf, sizeof(tsbuf), "%Y%m%d_%H%M%S", std::localtime(&tnow));
+            std::ofstream out(std::string("logs/live/failure_FATAL_") + tsbuf + ".log");
+            out << "severity: FATAL\n";
+            out << "message: " << e.what() << "\n";
+            out.close();
+            std::cerr << "\n❌ Error in live mode: " << e.what() << " (report written)\n\n";
+        } catch (...) {
+            std::cerr << "\n❌ Error in live mode: " << e.what() << "\n\n";
+        }
+        return result;
+    }
+}
+
+} // namespace trading
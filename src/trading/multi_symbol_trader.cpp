@@ -1,5 +1,6 @@
 #include "trading/multi_symbol_trader.h"
 #include "core/bar_id_utils.h"
+#include "utils/binary_io.h"
 #include <algorithm>
 #include <iostream>
 #include <iomanip>
@@ -7,27 +8,6 @@
 #include <cmath>
 #include <ctime>
 #include <map>
-#include <set>
-
-/**
- * Calculate simple moving average from price history
- * @param history Price history (most recent price at back)
- * @param period Number of bars for MA calculation
- * @return Moving average, or NaN if insufficient data
- */
-static double calculate_moving_average(const std::deque<double>& history, int period) {
-    if (static_cast<int>(history.size()) < period) {
-        return std::numeric_limits<double>::quiet_NaN();
-    }
-
-    double sum = 0.0;
-    // Sum the last 'period' prices
-    for (int i = 0; i < period; ++i) {
-        sum += history[history.size() - 1 - i];
-    }
-
-    return sum / period;
-}
 
 namespace trading {
 
@@ -37,12 +17,13 @@ static bool is_end_of_day(Timestamp timestamp) {
     auto time_seconds = std::chrono::duration_cast<std::chrono::seconds>(
         timestamp.time_since_epoch()).count();
     time_t time = static_cast<time_t>(time_seconds);
-    struct tm* tm_info = localtime(&time);
+    struct tm tm_info;
+    localtime_r(&time, &tm_info);
 
     // Market close is 16:00 (4:00 PM)
     // Trigger EOD at last minute (15:59 or 16:00)
-    return (tm_info->tm_hour == 15 && tm_info->tm_min >= 59) ||
-           (tm_info->tm_hour >= 16);
+    return (tm_info.tm_hour == 15 && tm_info.tm_min >= 59) ||
+           (tm_info.tm_hour >= 16);
 }
 
 // Helper function: Extract date from timestamp (YYYYMMDD format)
@@ -50,11 +31,23 @@ static int64_t extract_date_from_timestamp(Timestamp timestamp) {
     auto time_seconds = std::chrono::duration_cast<std::chrono::seconds>(
         timestamp.time_since_epoch()).count();
     time_t time = static_cast<time_t>(time_seconds);
-    struct tm* tm_info = localtime(&time);
+    struct tm tm_info;
+    localtime_r(&time, &tm_info);
 
-    return (tm_info->tm_year + 1900) * 10000 +
-           (tm_info->tm_mon + 1) * 100 +
-           tm_info->tm_mday;
+    return (tm_info.tm_year + 1900) * 10000 +
+           (tm_info.tm_mon + 1) * 100 +
+           tm_info.tm_mday;
+}
+
+// Size a symbol map's buckets and pooled nodes for every symbol up front, so
+// entries added and removed while trading never reach the heap
+template<typename Map>
+static void preallocate_symbol_map(Map& map, const std::vector<Symbol>& symbols) {
+    map.reserve(symbols.size());
+    for (const auto& symbol : symbols) {
+        map.emplace(symbol, typename Map::mapped_type());
+    }
+    map.clear();
 }
 
 MultiSymbolTrader::MultiSymbolTrader(const std::vector<Symbol>& symbols,
@@ -62,6 +55,9 @@ MultiSymbolTrader::MultiSymbolTrader(const std::vector<Symbol>& symbols,
     : symbols_(symbols),
       config_(config),
       cash_(config.initial_capital),
+      positions_(PositionMap::allocator_type(&node_pool_)),
+      exit_tracking_(SymbolPoolMap<ExitTrackingData>::allocator_type(&node_pool_)),
+      trade_journal_(config.trade_journal_ring_size),
       bars_seen_(0),
       trading_bars_(0),
       test_day_start_bar_(0),
@@ -70,7 +66,9 @@ MultiSymbolTrader::MultiSymbolTrader(const std::vector<Symbol>& symbols,
       daily_start_equity_(config.initial_capital),
       daily_start_trades_(0),
       daily_winning_trades_(0),
-      daily_losing_trades_(0) {
+      daily_losing_trades_(0),
+      rotation_cooldowns_(SymbolPoolMap<int>::allocator_type(&node_pool_)),
+      predictions_(symbols) {
 
     // Calculate when test day begins (after warmup observation + simulation)
     if (config_.strategy == StrategyType::SIGOR) {
@@ -87,6 +85,11 @@ MultiSymbolTrader::MultiSymbolTrader(const std::vector<Symbol>& symbols,
     // Initialize trade filter
     trade_filter_ = std::make_unique<TradeFilter>(config_.filter_config);
 
+    // Persist trades from the first exit when a journal path is configured
+    if (!config_.trade_journal_path.empty()) {
+        trade_journal_.open_spill(config_.trade_journal_path);
+    }
+
     // Initialize per-symbol components (SIGOR only)
     for (const auto& symbol : symbols_) {
         // SIGOR predictor adapter (uses bar data directly)
@@ -104,30 +107,42 @@ MultiSymbolTrader::MultiSymbolTrader(const std::vector<Symbol>& symbols,
         );
 
         // Initialize price history for multi-bar return calculations (both strategies)
-        price_history_[symbol] = std::deque<double>();
-    }
+        price_history_.emplace(symbol, CircularBuffer<double>(PRICE_HISTORY_BARS));
+    }
+
+    // Per-bar working memory (see on_bar)
+    preallocate_symbol_map(positions_, symbols_);
+    preallocate_symbol_map(exit_tracking_, symbols_);
+    preallocate_symbol_map(rotation_cooldowns_, symbols_);
+    ranked_.reserve(symbols_.size());
+    processed_bases_.reserve(symbols_.size());
+    top_symbols_.reserve(symbols_.size());
+    debug_ranked_.reserve(symbols_.size());
+    exit_scratch_.reserve(symbols_.size());
+    held_scratch_.reserve(symbols_.size());
+    daily_results_.reserve(256);  // ~A year of EOD rows
 }
 
 void MultiSymbolTrader::on_bar(const std::unordered_map<Symbol, Bar>& market_data) {
+    SENTIO_STAGE_BEGIN(stage_profiler_);
     bars_seen_++;
 
     // Step 0: COMPREHENSIVE BarID Validation - Ensure all symbols are synchronized
     int64_t reference_timestamp_ms = -1;
-    std::string reference_symbol;
-    std::vector<std::string> missing_symbols;
-    std::vector<std::string> validated_symbols;
 
     // Check 1: Verify all expected symbols are present
+    bool any_missing = false;
     for (const auto& symbol : symbols_) {
         if (market_data.find(symbol) == market_data.end()) {
-            missing_symbols.push_back(symbol);
+            if (!any_missing) {
+                console_err() << "  [WARNING] Bar " << bars_seen_ << ": Missing symbols: ";
+                any_missing = true;
+            }
+            console_err() << symbol << " ";
         }
     }
-
-    if (!missing_symbols.empty()) {
-        std::cerr << "  [WARNING] Bar " << bars_seen_ << ": Missing symbols: ";
-        for (const auto& sym : missing_symbols) std::cerr << sym << " ";
-        std::cerr << std::endl;
+    if (any_missing) {
+        console_err() << std::endl;
     }
 
     // Check 2: Timestamp synchronization (LIVE MODE ONLY)
@@ -138,84 +153,81 @@ void MultiSymbolTrader::on_bar(const std::unordered_map<Symbol, Bar>& market_dat
     // For live mode, we just verify all symbols have data (already done above)
     // No need for strict bar_id or timestamp validation
 
-    for (const auto& [symbol, bar] : market_data) {
-        validated_symbols.push_back(symbol);
-    }
-
     // Check 3: Verify bar sequence (detect time gaps)
-    static int64_t last_timestamp_ms = -1;
-    if (last_timestamp_ms != -1 && reference_timestamp_ms != -1) {
-        int64_t time_gap_ms = reference_timestamp_ms - last_timestamp_ms;
+    if (last_timestamp_ms_ != -1 && reference_timestamp_ms != -1) {
+        int64_t time_gap_ms = reference_timestamp_ms - last_timestamp_ms_;
         // Expect 1-minute bars (60000ms), warn if gap > 5 minutes
         if (time_gap_ms > 300000) {
-            std::cerr << "  [WARNING] Large time gap detected: "
+            console_err() << "  [WARNING] Large time gap detected: "
                      << (time_gap_ms / 60000) << " minutes between bars "
                      << (bars_seen_ - 1) << " and " << bars_seen_ << std::endl;
         }
     }
-    last_timestamp_ms = reference_timestamp_ms;
+    last_timestamp_ms_ = reference_timestamp_ms;
 
     // Validation passed - log periodically for confidence
     if (bars_seen_ % 100 == 0) {
-        std::cout << "  [SYNC-CHECK] Bar " << bars_seen_
-                 << ": All " << validated_symbols.size() << " symbols synchronized at timestamp "
+        console() << "  [SYNC-CHECK] Bar " << bars_seen_
+                 << ": All " << market_data.size() << " symbols synchronized at timestamp "
                  << reference_timestamp_ms << std::endl;
     }
+    SENTIO_STAGE_LAP(stage_profiler_, VALIDATION);
 
     // Step 1: Update market context for cost calculations
+    // Stale (carried-forward) bars never update per-symbol history or indicators
     for (const auto& symbol : symbols_) {
         auto it = market_data.find(symbol);
-        if (it != market_data.end()) {
+        if (it != market_data.end() && !it->second.stale) {
             update_market_context(symbol, it->second);
         }
     }
+    SENTIO_STAGE_LAP(stage_profiler_, MARKET_CONTEXT);
 
     // Step 2: Update price history for multi-bar return calculations
     for (const auto& symbol : symbols_) {
         auto it = market_data.find(symbol);
-        if (it == market_data.end()) continue;
+        if (it == market_data.end() || it->second.stale) continue;
 
-        const Bar& bar = it->second;
-        auto& history = price_history_[symbol];
-        history.push_back(bar.close);
-
-        // Keep only last 20 bars (enough for 10-bar returns with buffer)
-        while (history.size() > 20) {
-            history.pop_front();
-        }
+        // Ring buffer keeps only the last PRICE_HISTORY_BARS closes
+        price_history_.at(symbol).push_back(it->second.close);
     }
+    SENTIO_STAGE_LAP(stage_profiler_, PRICE_HISTORY);
 
-    // Step 3: Extract features and make multi-horizon predictions
-    std::unordered_map<Symbol, PredictionData> predictions;
+    // Step 3: Make multi-horizon predictions (into the trader-owned prediction slots)
+    PredictionSet& predictions = predictions_;
+    predictions.clear();
 
-    for (const auto& symbol : symbols_) {
+    for (size_t i = 0; i < symbols_.size(); ++i) {
+        const auto& symbol = symbols_[i];
         auto it = market_data.find(symbol);
         if (it == market_data.end()) continue;
 
         const Bar& bar = it->second;
 
         if (config_.strategy == StrategyType::SIGOR) {
-            // SIGOR: Update with bar and generate signal
-            sigor_predictors_[symbol]->update_with_bar(bar);
+            // SIGOR: Update with bar and generate signal (stale bars reuse the last signal)
+            auto& predictor = *sigor_predictors_.at(symbol);
+            if (!bar.stale) {
+                predictor.update_with_bar(bar);
+            }
 
             // Check if warmed up
-            if (sigor_predictors_[symbol]->is_warmed_up()) {
-                // Generate prediction (uses dummy features since SIGOR doesn't need them)
-                // Use a minimal feature vector but ensure downstream checks are safe
-                Eigen::VectorXd dummy_features = Eigen::VectorXd::Zero(1);
-                auto pred = sigor_predictors_[symbol]->predict(dummy_features);
-                predictions[symbol] = {pred, dummy_features, bar.close};
+            if (predictor.is_warmed_up()) {
+                predictions.set(i, {predictor.predict(), bar.close});
             }
         }
 
         // No learning/update path in SIGOR
     }
+    SENTIO_STAGE_LAP(stage_profiler_, PREDICTION);
 
     // Step 4: Update trade filter bars held counter
     trade_filter_->update_bars_held(static_cast<int>(bars_seen_));
+    SENTIO_STAGE_LAP(stage_profiler_, FILTER_UPDATE);
 
     // Step 5: Update existing positions (check exit conditions with trade filter)
     update_positions(market_data, predictions);
+    SENTIO_STAGE_LAP(stage_profiler_, UPDATE_POSITIONS);
 
     // Step 6: Update warmup phase and execute phase-specific logic
     update_phase();
@@ -242,32 +254,31 @@ void MultiSymbolTrader::on_bar(const std::unordered_map<Symbol, Bar>& market_dat
             break;
         }
     }
+    SENTIO_STAGE_LAP(stage_profiler_, TRADING);
 
     // Step 7: EOD liquidation (use timestamp-based detection)
     // Detect end of day based on bar timestamp (3:59-4:00 PM ET)
     // This is more robust than modulo arithmetic which fails with missing bars
-    [[maybe_unused]] static int64_t last_trading_date = 0;
-    static int64_t last_eod_date = 0;  // Track last EOD to prevent duplicate triggers
     int64_t current_trading_date = extract_date_from_timestamp(
         market_data.begin()->second.timestamp);
     bool is_eod = is_end_of_day(market_data.begin()->second.timestamp);
 
     // Only trigger EOD once per day (when we first see EOD timestamp)
-    bool should_trigger_eod = is_eod && (current_trading_date != last_eod_date);
+    bool should_trigger_eod = is_eod && (current_trading_date != last_eod_date_);
 
     if (config_.eod_liquidation && trading_bars_ > 0 && should_trigger_eod) {
         int day_num = trading_bars_ / config_.bars_per_day;
-        last_eod_date = current_trading_date;  // Mark this day as processed
+        last_eod_date_ = current_trading_date;  // Mark this day as processed
 
         // Log day boundary transition
-        std::cout << "\n[DAY BOUNDARY] Transitioning to day " << day_num << " → "
+        console() << "\n[DAY BOUNDARY] Transitioning to day " << day_num << " → "
                   << (day_num + 1) << " (bar " << bars_seen_ << ")\n";
 
         // Log position states before EOD liquidation
-        std::cout << "  [POSITION STATES BEFORE EOD]:\n";
+        console() << "  [POSITION STATES BEFORE EOD]:\n";
         for (const auto& symbol : symbols_) {
             const auto& state = trade_filter_->get_position_state(symbol);
-            std::cout << "    " << symbol << ": "
+            console() << "    " << symbol << ": "
                       << (state.has_position ? "HOLDING" : "FLAT")
                       << " | last_exit_bar: " << state.last_exit_bar
                       << " | bars_held: " << state.bars_held << "\n";
@@ -295,7 +306,7 @@ void MultiSymbolTrader::on_bar(const std::unordered_map<Symbol, Bar>& market_dat
         daily_results_.push_back(daily);
 
         // Print daily summary
-        std::cout << "  [EOD] Day " << day_num << " complete:"
+        console() << "  [EOD] Day " << day_num << " complete:"
                   << " Equity: $" << std::fixed << std::setprecision(2) << end_equity
                   << " (" << std::showpos << (daily_return * 100) << std::noshowpos << "%)"
                   << " | Trades: " << daily.trades_today
@@ -313,39 +324,49 @@ void MultiSymbolTrader::on_bar(const std::unordered_map<Symbol, Bar>& market_dat
 
         // Verify filter reset worked
         auto stats = trade_filter_->get_trade_stats(static_cast<int>(bars_seen_));
-        std::cout << "  [FILTER RESET] Trades today: " << stats.trades_today
+        console() << "  [FILTER RESET] Trades today: " << stats.trades_today
                   << " (should be 0)\n";
 
         // Log position states after reset
-        std::cout << "  [POSITION STATES AFTER RESET]:\n";
+        console() << "  [POSITION STATES AFTER RESET]:\n";
         for (const auto& symbol : symbols_) {
             const auto& state = trade_filter_->get_position_state(symbol);
-            std::cout << "    " << symbol << ": "
+            console() << "    " << symbol << ": "
                       << (state.has_position ? "HOLDING" : "FLAT")
                       << " | last_exit_bar: " << state.last_exit_bar
                       << " (should be -999 for FLAT positions)\n";
         }
-        std::cout << "\n";
+        console() << "\n";
     }
 
     // Update last trading date for next iteration
-    last_trading_date = current_trading_date;
+    last_trading_date_ = current_trading_date;
+
+    // Step 8: Mark equity to market for drawdown tracking (test day only)
+    if (bars_seen_ > test_day_start_bar_) {
+        test_day_perf_.record_equity(mark_to_market(market_data));
+    }
+    SENTIO_STAGE_LAP(stage_profiler_, EOD);
+    SENTIO_STAGE_END(stage_profiler_);
 }
 
-void MultiSymbolTrader::make_trades(const std::unordered_map<Symbol, PredictionData>& predictions,
+void MultiSymbolTrader::make_trades(const PredictionSet& predictions,
                                     const std::unordered_map<Symbol, Bar>& market_data) {
 
     // Track if we enter a trade this bar (for adaptive threshold adjustment)
     bool trade_entered_this_bar = false;
 
     // Enhanced Debug: Detailed trade analysis (every 50 bars when no positions)
-    if (positions_.empty() && bars_seen_ % 50 == 0) {
-        std::cout << "\n[TRADE ANALYSIS] Bar " << bars_seen_ << ":\n";
+    if (!config_.quiet && positions_.empty() && bars_seen_ % 50 == 0) {
+        console() << "\n[TRADE ANALYSIS] Bar " << bars_seen_ << ":\n";
 
         // Sort by 5-bar prediction strength
-        std::vector<std::pair<Symbol, const PredictionData*>> debug_ranked;
-        for (const auto& [symbol, pred] : predictions) {
-            debug_ranked.emplace_back(symbol, &pred);
+        auto& debug_ranked = debug_ranked_;
+        debug_ranked.clear();
+        for (size_t i = 0; i < symbols_.size(); ++i) {
+            if (const PredictionData* pred = predictions.at(i)) {
+                debug_ranked.emplace_back(symbols_[i], pred);
+            }
         }
         std::sort(debug_ranked.begin(), debug_ranked.end(),
                   [](const auto& a, const auto& b) {
@@ -370,13 +391,11 @@ void MultiSymbolTrader::make_trades(const std::unordered_map<Symbol, PredictionD
             bool can_enter = trade_filter_->can_enter_position(
                 symbol, static_cast<int>(bars_seen_), pred.prediction);
 
-            std::cout << "  " << symbol
+            console() << "  " << symbol
                       << " | 5-bar: " << std::fixed << std::setprecision(2)
                       << (pred.prediction.pred_2bar.prediction * 10000) << " bps"
                       << " | conf: " << (pred.prediction.pred_2bar.confidence * 100) << "%"
                       << " | prob: " << (probability * 100) << "%"
-                      << (probability_with_bb != probability ?
-                          " -> " + std::to_string(int(probability_with_bb * 100)) + "% (BB)" : "")
                       << " | thresh: " << (passes_prob ? "PASS" : "BLOCKED")
                       << " | filter: " << (can_enter ? "PASS" : "BLOCKED")
                       << "\n";
@@ -397,34 +416,37 @@ void MultiSymbolTrader::make_trades(const std::unordered_map<Symbol, PredictionD
 
     // Build deterministic ranked list by iterating symbols_ order
     // If prediction is negative and inverse exists, substitute inverse and flip sign
-    std::vector<std::pair<Symbol, double>> ranked;  // (tradeable_symbol, positive_strength)
-    std::set<std::string> processed_bases;
-
-    for (const auto& symbol : symbols_) {
-        auto p_it = predictions.find(symbol);
-        if (p_it == predictions.end()) {
+    auto& ranked = ranked_;  // (tradeable_symbol, positive_strength)
+    auto& processed_bases = processed_bases_;
+    ranked.clear();
+    processed_bases.clear();
+
+    for (size_t s = 0; s < symbols_.size(); ++s) {
+        const PredictionData* p = predictions.at(s);
+        if (!p) {
             continue;
         }
-        double prediction = p_it->second.prediction.pred_2bar.prediction;
-        Symbol tradeable_symbol = symbol;
+        const Symbol& symbol = symbols_[s];
+        double prediction = p->prediction.pred_2bar.prediction;
+        const Symbol* tradeable_symbol = &symbol;
 
         if (prediction < 0) {
             auto inv_it = inverse_pairs.find(symbol);
             if (inv_it != inverse_pairs.end()) {
-                tradeable_symbol = inv_it->second;
+                tradeable_symbol = &inv_it->second;
                 prediction = -prediction;
             }
         }
 
         // Base key ensures only one of a pair (TQQQ/SQQQ) is processed, deterministically by lexicographic min
-        std::string base_key = (tradeable_symbol < symbol) ? tradeable_symbol : symbol;
-        if (processed_bases.count(base_key)) {
+        const Symbol& base_key = (*tradeable_symbol < symbol) ? *tradeable_symbol : symbol;
+        if (std::find(processed_bases.begin(), processed_bases.end(), base_key) != processed_bases.end()) {
             continue;
         }
-        processed_bases.insert(base_key);
+        processed_bases.push_back(base_key);
 
         if (prediction > 0) {
-            ranked.emplace_back(tradeable_symbol, prediction);
+            ranked.emplace_back(*tradeable_symbol, prediction);
         }
     }
 
@@ -435,18 +457,20 @@ void MultiSymbolTrader::make_trades(const std::unordered_map<Symbol, PredictionD
     });
 
     // Get top N symbols that pass thresholds
-    std::vector<Symbol> top_symbols;
+    auto& top_symbols = top_symbols_;
+    top_symbols.clear();
     for (size_t i = 0; i < ranked.size(); ++i) {
         if (top_symbols.size() >= config_.max_positions) break;
         const auto& symbol = ranked[i].first;
 
-        auto pred_it = predictions.find(symbol);
-        if (pred_it == predictions.end()) continue;
-        const auto& pred_data = pred_it->second;
+        const PredictionData* pred_it = predictions.find(symbol);
+        if (!pred_it) continue;
+        const auto& pred_data = *pred_it;
 
         double probability = prediction_to_probability(pred_data.prediction.pred_2bar.prediction);
         bool is_long = true;
         auto bar_it = market_data.find(symbol);
+        if (bar_it != market_data.end() && bar_it->second.stale) continue;  // No entries on carried-forward prices
         // SIGOR-only: BB amplification disabled
         bool passes_probability = (probability > config_.buy_threshold);
         bool passes_filter = trade_filter_->can_enter_position(symbol, static_cast<int>(bars_seen_), pred_data.prediction);
@@ -477,11 +501,11 @@ void MultiSymbolTrader::make_trades(const std::unordered_map<Symbol, PredictionD
             continue;
         }
 
-        auto pd_it = predictions.find(symbol);
-        if (pd_it == predictions.end()) {
+        const PredictionData* pd_it = predictions.find(symbol);
+        if (!pd_it) {
             continue;
         }
-        const auto& pred_data = pd_it->second;
+        const auto& pred_data = *pd_it;
         double size = calculate_position_size(symbol, pred_data);
 
         // Make sure we have enough cash
@@ -513,7 +537,7 @@ void MultiSymbolTrader::make_trades(const std::unordered_map<Symbol, PredictionD
                 trade_entered_this_bar = true;
 
                 // Log entry with multi-horizon info
-                std::cout << "  [ENTRY] " << symbol
+                console() << "  [ENTRY] " << symbol
                          << " at $" << std::fixed << std::setprecision(2)
                          << it->second.close
                          << " | 1-bar: " << std::setprecision(4)
@@ -537,11 +561,11 @@ void MultiSymbolTrader::make_trades(const std::unordered_map<Symbol, PredictionD
             }
 
             // Skip if doesn't pass filters (same as entry check)
-            auto cand_it = predictions.find(candidate_symbol);
-            if (cand_it == predictions.end()) {
+            const PredictionData* cand_it = predictions.find(candidate_symbol);
+            if (!cand_it) {
                 continue;
             }
-            const auto& pred_data = cand_it->second;
+            const auto& pred_data = *cand_it;
             double probability = prediction_to_probability(pred_data.prediction.pred_2bar.prediction);
             bool is_long = pred_data.prediction.pred_2bar.prediction > 0;
             auto bar_it = market_data.find(candidate_symbol);
@@ -569,11 +593,11 @@ void MultiSymbolTrader::make_trades(const std::unordered_map<Symbol, PredictionD
             }
 
             // Get weakest strength and prediction
-            auto wk_it = predictions.find(weakest);
-            if (wk_it == predictions.end()) {
+            const PredictionData* wk_it = predictions.find(weakest);
+            if (!wk_it) {
                 break;
             }
-            double weakest_pred = wk_it->second.prediction.pred_2bar.prediction;
+            double weakest_pred = wk_it->prediction.pred_2bar.prediction;
             double weakest_strength = std::abs(weakest_pred);
 
             // CRITICAL: Only rotate if signals have SAME direction
@@ -593,7 +617,7 @@ void MultiSymbolTrader::make_trades(const std::unordered_map<Symbol, PredictionD
                 // ROTATION JUSTIFIED - exit weakest and enter stronger signal
                 auto it = market_data.find(weakest);
                 if (it != market_data.end()) {
-                    std::cout << "  [ROTATION] OUT: " << weakest
+                    console() << "  [ROTATION] OUT: " << weakest
                              << " (strength: " << std::fixed << std::setprecision(4)
                              << (weakest_strength * 10000) << " bps)"
                              << " → IN: " << candidate_symbol
@@ -630,7 +654,7 @@ void MultiSymbolTrader::make_trades(const std::unordered_map<Symbol, PredictionD
                                 // Mark that a trade was entered this bar
                                 trade_entered_this_bar = true;
 
-                                std::cout << "  [ENTRY] " << candidate_symbol
+                                console() << "  [ENTRY] " << candidate_symbol
                                          << " at $" << std::fixed << std::setprecision(2)
                                          << entry_it->second.close
                                          << " (via rotation)\n";
@@ -652,9 +676,10 @@ void MultiSymbolTrader::make_trades(const std::unordered_map<Symbol, PredictionD
 
 void MultiSymbolTrader::update_positions(
     const std::unordered_map<Symbol, Bar>& market_data,
-    const std::unordered_map<Symbol, PredictionData>& predictions) {
+    const PredictionSet& predictions) {
 
-    std::vector<Symbol> to_exit;
+    auto& to_exit = exit_scratch_;
+    to_exit.clear();
 
     for (const auto& [symbol, pos] : positions_) {
         auto bar_it = market_data.find(symbol);
@@ -663,13 +688,13 @@ void MultiSymbolTrader::update_positions(
         Price current_price = bar_it->second.close;
 
         // Get current prediction for this symbol (if available)
-        auto pred_it = predictions.find(symbol);
-        if (pred_it == predictions.end()) {
+        const PredictionData* pred_it = predictions.find(symbol);
+        if (!pred_it) {
             // No prediction available - skip (will only exit via EOD or emergency stop in trade_filter)
             continue;
         }
 
-        const auto& pred_data = pred_it->second;
+        const auto& pred_data = *pred_it;
 
         // ===== PROFIT TARGET & STOP LOSS (from online_trader v2.0) =====
         // Check P&L-based exits FIRST - highest priority
@@ -716,7 +741,7 @@ void MultiSymbolTrader::update_positions(
             int bars_held = trade_filter_->get_bars_held(symbol);
 
             // Determine exit reason based on P&L
-            std::string reason;
+            const char* reason;
             if (config_.enable_profit_target && pnl_pct >= config_.profit_target_pct) {
                 reason = "ProfitTarget(+3%)";
             } else if (config_.enable_stop_loss && pnl_pct <= -config_.stop_loss_pct) {
@@ -728,7 +753,7 @@ void MultiSymbolTrader::update_positions(
             exit_position(symbol, it->second.close, it->second.timestamp, it->second.bar_id);
 
             // Log exit with details
-            std::cout << "  [EXIT] " << symbol
+            console() << "  [EXIT] " << symbol
                      << " at $" << std::fixed << std::setprecision(2)
                      << it->second.close
                      << " | P&L: " << std::setprecision(2) << (pnl_pct * 100) << "%"
@@ -774,23 +799,29 @@ double MultiSymbolTrader::calculate_position_size(const Symbol& symbol, const Pr
     // STEP 6: VOLATILITY ADJUSTMENT (NEW!)
     // Reduce position size for high-volatility symbols
     if (config_.position_sizing.enable_volatility_adjustment) {
-        auto& price_hist = price_history_[symbol];
+        const auto& price_hist = price_history_.at(symbol);
         if (static_cast<int>(price_hist.size()) >= config_.position_sizing.volatility_lookback) {
-            // Calculate volatility (standard deviation of returns)
+            // Calculate volatility (standard deviation of returns), two passes over the window
             int lookback = config_.position_sizing.volatility_lookback;
-            std::vector<double> returns;
-            for (int i = price_hist.size() - lookback; i < static_cast<int>(price_hist.size()) - 1; ++i) {
-                double ret = (price_hist[i+1] - price_hist[i]) / price_hist[i];
-                returns.push_back(ret);
-            }
+            int first = static_cast<int>(price_hist.size()) - lookback;
+            int last = static_cast<int>(price_hist.size()) - 1;
+            auto bar_return = [&price_hist](int i) {
+                return (price_hist[i+1] - price_hist[i]) / price_hist[i];
+            };
 
             // Calculate standard deviation
-            double mean_return = std::accumulate(returns.begin(), returns.end(), 0.0) / returns.size();
+            double sum_returns = 0.0;
+            for (int i = first; i < last; ++i) {
+                sum_returns += bar_return(i);
+            }
+            double n_returns = static_cast<double>(std::max(0, last - first));
+            double mean_return = sum_returns / n_returns;
             double variance = 0.0;
-            for (double ret : returns) {
+            for (int i = first; i < last; ++i) {
+                double ret = bar_return(i);
                 variance += (ret - mean_return) * (ret - mean_return);
             }
-            double std_dev = std::sqrt(variance / returns.size());
+            double std_dev = std::sqrt(variance / n_returns);
 
             // Convert to daily volatility (annualized vol / sqrt(252))
             double daily_vol = std_dev;
@@ -875,7 +906,7 @@ bool MultiSymbolTrader::is_position_compatible(const Symbol& new_symbol) const {
             // Check if new symbol is the inverse of current position
             if (it->second == new_symbol) {
                 // Inverse position blocked - always log this important safety check
-                std::cout << "  ⚠️  POSITION BLOCKED: " << new_symbol
+                console() << "  ⚠️  POSITION BLOCKED: " << new_symbol
                           << " is inverse of existing position " << symbol << "\n";
                 return false;  // Inverse position not allowed
             }
@@ -963,17 +994,17 @@ double MultiSymbolTrader::exit_position(const Symbol& symbol, Price price, Times
                      pos.shares, pos.entry_price, price, pos.entry_bar_id, bar_id, bars_seen_);
     trade_history_[symbol]->push_back(trade);
 
-    // Also add to complete trade log for export
-    all_trades_log_.push_back(trade);
+    // Also add to complete trade journal for export
+    trade_journal_.append(trade);
 
-    // Memory management: Limit trade log size to prevent unbounded growth
-    // Keep most recent 10,000 trades, archive older ones
-    if (all_trades_log_.size() > 10000) {
-        // Remove oldest 5,000 trades (keep newest 5,000)
-        all_trades_log_.erase(
-            all_trades_log_.begin(),
-            all_trades_log_.begin() + 5000
-        );
+    // Warmup validation only looks at trades closed during simulation
+    if (config_.current_phase == TradingConfig::WARMUP_SIMULATION) {
+        warmup_metrics_.simulated_trades.push_back(trade);
+    }
+
+    // Streaming test-day statistics (same filter as exit_bar_index >= test_day_start_bar_)
+    if (bars_seen_ >= test_day_start_bar_) {
+        test_day_perf_.record_trade(trade, exit_costs.total_cost);
     }
 
     // Track daily wins/losses
@@ -997,7 +1028,8 @@ double MultiSymbolTrader::exit_position(const Symbol& symbol, Price price, Times
 
 void MultiSymbolTrader::liquidate_all(const std::unordered_map<Symbol, Bar>& market_data,
                                       const std::string& reason) {
-    std::vector<Symbol> symbols_to_exit;
+    auto& symbols_to_exit = exit_scratch_;
+    symbols_to_exit.clear();
     for (const auto& [symbol, pos] : positions_) {
         symbols_to_exit.push_back(symbol);
     }
@@ -1023,58 +1055,49 @@ double MultiSymbolTrader::get_equity(const std::unordered_map<Symbol, Bar>& mark
     return equity;
 }
 
-MultiSymbolTrader::BacktestResults MultiSymbolTrader::get_results() const {
-    BacktestResults results;
-
-    // FILTER: Only collect trades from TEST DAY (after warmup + simulation)
-    // For single-day optimization, we only report metrics for the test day
-    std::vector<TradeRecord> test_day_trades;
-
-    // Use all_trades_log_ which has ALL trades with exit_bar_index
-    for (const auto& trade : all_trades_log_) {
-        if (trade.exit_bar_index >= test_day_start_bar_) {
-            test_day_trades.push_back(trade);
-        }
-    }
-
-    results.total_trades = test_day_trades.size();
-    results.winning_trades = 0;
-    results.losing_trades = 0;
-    double gross_profit = 0.0;
-    double gross_loss = 0.0;
+double MultiSymbolTrader::mark_to_market(const std::unordered_map<Symbol, Bar>& market_data) const {
+    double equity = cash_;
 
-    for (const auto& trade : test_day_trades) {
-        if (trade.is_win()) {
-            results.winning_trades++;
-            gross_profit += trade.pnl;
-        } else if (trade.is_loss()) {
-            results.losing_trades++;
-            gross_loss += std::abs(trade.pnl);
+    for (const auto& [symbol, pos] : positions_) {
+        auto it = market_data.find(symbol);
+        if (it != market_data.end()) {
+            equity += pos.market_value(it->second.close);
+            continue;
         }
+        // Missing this minute: last close seen, else the entry price
+        auto ph_it = price_history_.find(symbol);
+        const bool has_close = ph_it != price_history_.end() && ph_it->second.size() > 0;
+        equity += pos.market_value(has_close ? ph_it->second.back() : pos.entry_price);
     }
 
-    results.win_rate = (results.total_trades > 0)
-                       ? static_cast<double>(results.winning_trades) / results.total_trades
-                       : 0.0;
-
-    results.avg_win = (results.winning_trades > 0)
-                      ? gross_profit / results.winning_trades
-                      : 0.0;
-
-    results.avg_loss = (results.losing_trades > 0)
-                       ? gross_loss / results.losing_trades
-                       : 0.0;
+    return equity;
+}
 
-    results.profit_factor = (gross_loss > 0)
-                            ? gross_profit / gross_loss
-                            : (gross_profit > 0 ? 999.0 : 0.0);
+MultiSymbolTrader::BacktestResults MultiSymbolTrader::get_results() const {
+    BacktestResults results;
 
-    // Calculate equity metrics
-    // Note: For accurate final_equity, need last market_data - so this is approximate
-    results.final_equity = cash_;
-    for (const auto& [symbol, pos] : positions_) {
-        // Use entry price as approximation (ideally should use last known price)
-        results.final_equity += pos.market_value(pos.entry_price);
+    // Only TEST DAY trades (after warmup + simulation) are accumulated in
+    // test_day_perf_, so no rescan of the trade log is needed here
+    const auto& perf = test_day_perf_;
+
+    results.total_trades = perf.total_trades();
+    results.winning_trades = perf.winning_trades();
+    results.losing_trades = perf.losing_trades();
+    results.win_rate = perf.win_rate();
+    results.avg_win = perf.avg_win();
+    results.avg_loss = perf.avg_loss();
+    results.profit_factor = perf.profit_factor();
+    results.sharpe_ratio = perf.sharpe_ratio();
+
+    // Final equity: last marked-to-market equity when available,
+    // otherwise cash + open positions at entry price
+    if (perf.has_equity()) {
+        results.final_equity = perf.current_equity();
+    } else {
+        results.final_equity = cash_;
+        for (const auto& [symbol, pos] : positions_) {
+            results.final_equity += pos.market_value(pos.entry_price);
+        }
     }
 
     results.total_return = (config_.initial_capital > 0)
@@ -1085,27 +1108,15 @@ MultiSymbolTrader::BacktestResults MultiSymbolTrader::get_results() const {
     // For single-day optimization, MRD = total return (since it's just 1 day)
     results.mrd = results.total_return;
 
-    results.max_drawdown = 0.0;  // TODO: Implement drawdown tracking
+    results.max_drawdown = perf.max_drawdown();
 
     // Cost tracking - ONLY for test day trades
-    // Note: We cannot directly filter transaction costs by bar, so we estimate
-    // based on the proportion of test day trades
-    double test_day_cost_ratio = (total_trades_ > 0)
-                                ? static_cast<double>(test_day_trades.size()) / total_trades_
-                                : 0.0;
-    results.total_transaction_costs = total_transaction_costs_ * test_day_cost_ratio;
+    results.total_transaction_costs = perf.transaction_costs();
     results.avg_cost_per_trade = (results.total_trades > 0)
                                  ? results.total_transaction_costs / results.total_trades
                                  : 0.0;
-
-    // Calculate total volume traded - ONLY test day trades
-    double total_volume = 0.0;
-    for (const auto& trade : test_day_trades) {
-        total_volume += trade.shares * trade.entry_price;  // Entry volume
-        total_volume += trade.shares * trade.exit_price;   // Exit volume
-    }
-    results.cost_as_pct_of_volume = (total_volume > 0)
-                                    ? (results.total_transaction_costs / total_volume) * 100.0
+    results.cost_as_pct_of_volume = (perf.volume() > 0)
+                                    ? (results.total_transaction_costs / perf.volume()) * 100.0
                                     : 0.0;
 
     // Net return after costs
@@ -1117,6 +1128,304 @@ MultiSymbolTrader::BacktestResults MultiSymbolTrader::get_results() const {
     return results;
 }
 
+// =============================================================================
+// Checkpoint / Fork
+// =============================================================================
+
+namespace {
+
+constexpr uint32_t kCheckpointMagic = 0x4b434c53;  // "SLCK"
+constexpr uint32_t kCheckpointVersion = 2;     // 2: trade journal by spill file position
+
+template<typename Map>
+void put_symbol_map(utils::BinaryWriter& out, const Map& map) {
+    out.put<uint64_t>(map.size());
+    for (const auto& [symbol, value] : map) {
+        out.put_string(symbol);
+        out.put(value);
+    }
+}
+
+template<typename Map>
+void get_symbol_map(utils::BinaryReader& in, Map& map) {
+    map.clear();
+    size_t count = in.length(sizeof(typename Map::mapped_type));
+    for (size_t i = 0; i < count; ++i) {
+        Symbol symbol = in.get_string();
+        map[symbol] = in.template get<typename Map::mapped_type>();
+    }
+}
+
+template<typename Trades>
+void put_trades(utils::BinaryWriter& out, const Trades& trades, size_t count) {
+    out.put<uint64_t>(count);
+    for (const TradeRecord& trade : trades) {
+        out.put(TradeJournal::Record::from_trade(trade));
+    }
+}
+
+std::vector<TradeRecord> get_trades(utils::BinaryReader& in) {
+    std::vector<TradeRecord> trades(in.length(sizeof(TradeJournal::Record)));
+    for (auto& trade : trades) {
+        trade = in.get<TradeJournal::Record>().to_trade();
+    }
+    return trades;
+}
+
+} // namespace
+
+void MultiSymbolTrader::check_fork_config(const TradingConfig& config) const {
+    if (config.strategy != config_.strategy) {
+        throw std::runtime_error("Cannot fork trader: strategy differs");
+    }
+    if (config.sigor_config != config_.sigor_config) {
+        throw std::runtime_error("Cannot fork trader: SIGOR configuration differs");
+    }
+}
+
+void MultiSymbolTrader::copy_state_from(const MultiSymbolTrader& other) {
+    // Configuration-owned parts (filter config, journal, history capacity) stay
+    // as constructed; only the evolving state is taken over
+    config_.current_phase = other.config_.current_phase;
+    cash_ = other.cash_;
+
+    for (const auto& symbol : symbols_) {
+        *sigor_predictors_[symbol] = *other.sigor_predictors_.at(symbol);
+
+        auto& history = *trade_history_[symbol];
+        const auto& source = *other.trade_history_.at(symbol);
+        history.clear();
+        for (size_t i = 0; i < source.size(); ++i) {
+            history.push_back(source[i]);
+        }
+    }
+
+    positions_ = other.positions_;
+    exit_tracking_ = other.exit_tracking_;
+    market_context_ = other.market_context_;
+    price_history_ = other.price_history_;
+    trade_filter_->copy_state_from(*other.trade_filter_);
+    for (const TradeRecord& trade : other.trade_journal_) {
+        trade_journal_.append(trade);
+    }
+    test_day_perf_ = other.test_day_perf_;
+
+    bars_seen_ = other.bars_seen_;
+    trading_bars_ = other.trading_bars_;
+    total_trades_ = other.total_trades_;
+    total_transaction_costs_ = other.total_transaction_costs_;
+
+    daily_results_ = other.daily_results_;
+    daily_start_equity_ = other.daily_start_equity_;
+    daily_start_trades_ = other.daily_start_trades_;
+    daily_winning_trades_ = other.daily_winning_trades_;
+    daily_losing_trades_ = other.daily_losing_trades_;
+
+    last_timestamp_ms_ = other.last_timestamp_ms_;
+    last_trading_date_ = other.last_trading_date_;
+    last_eod_date_ = other.last_eod_date_;
+
+    warmup_metrics_ = other.warmup_metrics_;
+    rotation_cooldowns_ = other.rotation_cooldowns_;
+}
+
+std::unique_ptr<MultiSymbolTrader> MultiSymbolTrader::fork(const TradingConfig& config) const {
+    check_fork_config(config);
+    auto child = std::make_unique<MultiSymbolTrader>(symbols_, config);
+    child->copy_state_from(*this);
+    return child;
+}
+
+void MultiSymbolTrader::reconfigure(const TradingConfig& config) {
+    if (config.strategy != config_.strategy) {
+        throw std::runtime_error("Cannot reconfigure trader: strategy differs");
+    }
+    if (config.initial_capital != config_.initial_capital || config.bars_per_day != config_.bars_per_day ||
+        config.trade_history_size != config_.trade_history_size) {
+        throw std::runtime_error("Cannot reconfigure trader: session settings (capital, bars_per_day, "
+                                 "trade history size) differ");
+    }
+
+    TradingConfig next = config;
+    next.current_phase = config_.current_phase;
+    next.warmup = config_.warmup;
+    next.min_bars_to_learn = config_.min_bars_to_learn;
+    next.trade_journal_ring_size = config_.trade_journal_ring_size;
+    next.trade_journal_path = config_.trade_journal_path;
+    next.quiet = config_.quiet;
+
+    // Every predictor gets the same config, so a bad window throws on the
+    // first one, before any state has changed
+    for (const auto& symbol : symbols_) {
+        sigor_predictors_.at(symbol)->reconfigure(next.sigor_config);
+    }
+    trade_filter_->set_config(next.filter_config);
+    config_ = std::move(next);
+}
+
+std::string MultiSymbolTrader::save_checkpoint() const {
+    utils::BinaryWriter out;
+    out.put(kCheckpointMagic);
+    out.put(kCheckpointVersion);
+    out.put(config_.strategy);
+
+    out.put<uint64_t>(symbols_.size());
+    for (const auto& symbol : symbols_) {
+        out.put_string(symbol);
+    }
+
+    out.put(config_.current_phase);
+    out.put(cash_);
+
+    // Per-symbol state, in symbol order
+    for (const auto& symbol : symbols_) {
+        sigor_predictors_.at(symbol)->save_state(out);
+
+        const auto& history = *trade_history_.at(symbol);
+        put_trades(out, history.to_vector(), history.size());
+
+        out.put(market_context_.at(symbol));
+        out.put_vector(price_history_.at(symbol).to_vector());
+    }
+
+    put_symbol_map(out, positions_);
+    put_symbol_map(out, exit_tracking_);
+    trade_filter_->save_state(out);
+    // A spilling journal is saved as its file and the records already durable
+    // in it, so a checkpoint never waits on or re-reads the session's trades
+    const auto journal = trade_journal_.checkpoint();
+    out.put_string(journal.spill_path);
+    out.put(journal.persisted);
+    out.put_vector(journal.pending);
+    out.put(test_day_perf_);
+
+    out.put<uint64_t>(bars_seen_);
+    out.put<uint64_t>(trading_bars_);
+    out.put(total_trades_);
+    out.put(total_transaction_costs_);
+
+    out.put_vector(daily_results_);
+    out.put(daily_start_equity_);
+    out.put(daily_start_trades_);
+    out.put(daily_winning_trades_);
+    out.put(daily_losing_trades_);
+
+    out.put(last_timestamp_ms_);
+    out.put(last_trading_date_);
+    out.put(last_eod_date_);
+
+    put_trades(out, warmup_metrics_.simulated_trades, warmup_metrics_.simulated_trades.size());
+    out.put(warmup_metrics_.starting_equity);
+    out.put(warmup_metrics_.current_equity);
+    out.put(warmup_metrics_.max_equity);
+    out.put(warmup_metrics_.max_drawdown);
+    out.put(warmup_metrics_.observation_bars_complete);
+    out.put(warmup_metrics_.simulation_bars_complete);
+
+    put_symbol_map(out, rotation_cooldowns_);
+    return out.take();
+}
+
+std::unique_ptr<MultiSymbolTrader> MultiSymbolTrader::restore_checkpoint(const std::string& checkpoint,
+                                                                         const TradingConfig& config) {
+    utils::BinaryReader in(checkpoint);
+    if (in.get<uint32_t>() != kCheckpointMagic) {
+        throw std::runtime_error("Not a trader checkpoint");
+    }
+    uint32_t version = in.get<uint32_t>();
+    if (version != kCheckpointVersion) {
+        throw std::runtime_error("Unsupported trader checkpoint version " + std::to_string(version));
+    }
+    if (in.get<StrategyType>() != config.strategy) {
+        throw std::runtime_error("Cannot restore checkpoint: strategy differs");
+    }
+
+    std::vector<Symbol> symbols(in.length(sizeof(uint64_t)));
+    for (auto& symbol : symbols) {
+        symbol = in.get_string();
+    }
+
+    // A journal that was spilling continues in its own file; config's journal
+    // path only applies to a memory-only checkpoint
+    TradingConfig restored = config;
+    restored.trade_journal_path.clear();
+    auto trader = std::make_unique<MultiSymbolTrader>(symbols, restored);
+    trader->load_state(in);
+    if (!in.at_end()) {
+        throw std::runtime_error("Trailing data after trader checkpoint");
+    }
+    if (!trader->trade_journal_.spilling() && !config.trade_journal_path.empty()) {
+        trader->trade_journal_.open_spill(config.trade_journal_path);
+        trader->config_.trade_journal_path = config.trade_journal_path;
+    }
+    return trader;
+}
+
+void MultiSymbolTrader::load_state(utils::BinaryReader& in) {
+    in.get(config_.current_phase);
+    in.get(cash_);
+
+    for (const auto& symbol : symbols_) {
+        sigor_predictors_[symbol]->load_state(in);
+
+        auto& history = *trade_history_[symbol];
+        history.clear();
+        for (const auto& trade : get_trades(in)) {
+            history.push_back(trade);
+        }
+
+        in.get(market_context_[symbol]);
+        std::vector<double> prices;
+        in.get_vector(prices);
+        auto& closes = price_history_.at(symbol);
+        closes.clear();
+        for (double price : prices) {
+            closes.push_back(price);
+        }
+    }
+
+    get_symbol_map(in, positions_);
+    get_symbol_map(in, exit_tracking_);
+    trade_filter_->load_state(in);
+    const std::string journal_path = in.get_string();
+    const uint64_t persisted = in.get<uint64_t>();
+    std::vector<TradeJournal::Record> pending;
+    in.get_vector(pending);
+    if (!journal_path.empty()) {
+        trade_journal_.resume_spill(journal_path, persisted);
+        config_.trade_journal_path = journal_path;
+    }
+    for (const auto& record : pending) {
+        trade_journal_.append(record.to_trade());
+    }
+    in.get(test_day_perf_);
+
+    bars_seen_ = static_cast<size_t>(in.get<uint64_t>());
+    trading_bars_ = static_cast<size_t>(in.get<uint64_t>());
+    in.get(total_trades_);
+    in.get(total_transaction_costs_);
+
+    in.get_vector(daily_results_);
+    in.get(daily_start_equity_);
+    in.get(daily_start_trades_);
+    in.get(daily_winning_trades_);
+    in.get(daily_losing_trades_);
+
+    in.get(last_timestamp_ms_);
+    in.get(last_trading_date_);
+    in.get(last_eod_date_);
+
+    warmup_metrics_.simulated_trades = get_trades(in);
+    in.get(warmup_metrics_.starting_equity);
+    in.get(warmup_metrics_.current_equity);
+    in.get(warmup_metrics_.max_equity);
+    in.get(warmup_metrics_.max_drawdown);
+    in.get(warmup_metrics_.observation_bars_complete);
+    in.get(warmup_metrics_.simulation_bars_complete);
+
+    get_symbol_map(in, rotation_cooldowns_);
+}
+
 void MultiSymbolTrader::update_market_context(const Symbol& symbol, const Bar& bar) {
     auto& ctx = market_context_[symbol];
 
@@ -1286,7 +1595,7 @@ void MultiSymbolTrader::update_phase() {
     else if (days_complete < config_.warmup.observation_days + config_.warmup.simulation_days) {
         // Transition to simulation
         if (config_.current_phase == TradingConfig::WARMUP_OBSERVATION) {
-            std::cout << "\n📊 Transitioning from OBSERVATION to SIMULATION phase\n";
+            console() << "\n📊 Transitioning from OBSERVATION to SIMULATION phase\n";
             warmup_metrics_.starting_equity = cash_;
             warmup_metrics_.current_equity = cash_;
             warmup_metrics_.max_equity = cash_;
@@ -1301,7 +1610,7 @@ void MultiSymbolTrader::update_phase() {
             if (config_.warmup.simulation_days == 0) {
                 // No simulation phase - go directly to test day
                 config_.current_phase = TradingConfig::WARMUP_COMPLETE;
-                std::cout << "\n📊 WARMUP COMPLETE (no simulation) - Proceeding directly to test day\n";
+                console() << "\n📊 WARMUP COMPLETE (no simulation) - Proceeding directly to test day\n";
             }
         }
         // Handle transition from SIMULATION (normal case)
@@ -1309,13 +1618,13 @@ void MultiSymbolTrader::update_phase() {
             // Skip validation for MOCK mode (always proceed to test day)
             if (config_.warmup.skip_validation) {
                 config_.current_phase = TradingConfig::WARMUP_COMPLETE;
-                std::cout << "\n📊 WARMUP PHASE COMPLETE - Proceeding to test day (validation skipped)\n";
+                console() << "\n📊 WARMUP PHASE COMPLETE - Proceeding to test day (validation skipped)\n";
             } else if (evaluate_warmup_complete()) {
                 config_.current_phase = TradingConfig::WARMUP_COMPLETE;
-                std::cout << "\n✅ WARMUP COMPLETE - Ready for live trading\n";
+                console() << "\n✅ WARMUP COMPLETE - Ready for live trading\n";
                 print_warmup_summary();
             } else {
-                std::cout << "\n❌ Warmup criteria not met - extending simulation\n";
+                console() << "\n❌ Warmup criteria not met - extending simulation\n";
                 // Stay in simulation
             }
         }
@@ -1326,13 +1635,13 @@ void MultiSymbolTrader::handle_observation_phase(const std::unordered_map<Symbol
     warmup_metrics_.observation_bars_complete++;
 
     if (bars_seen_ % 100 == 0) {
-        std::cout << "  [OBSERVATION] Bar " << bars_seen_
+        console() << "  [OBSERVATION] Bar " << bars_seen_
                   << " - Learning patterns, no trades\n";
     }
 }
 
 void MultiSymbolTrader::handle_simulation_phase(
-    const std::unordered_map<Symbol, PredictionData>& predictions,
+    const PredictionSet& predictions,
     const std::unordered_map<Symbol, Bar>& market_data) {
 
     warmup_metrics_.simulation_bars_complete++;
@@ -1350,11 +1659,6 @@ void MultiSymbolTrader::handle_simulation_phase(
         // Track equity after trades
         warmup_metrics_.current_equity = get_equity(market_data);
         warmup_metrics_.update_drawdown();
-
-        // Record simulated trades (they're already in all_trades_log_)
-        if (all_trades_log_.size() > warmup_metrics_.simulated_trades.size()) {
-            warmup_metrics_.simulated_trades = all_trades_log_;
-        }
     }
 
     if (bars_seen_ % 100 == 0) {
@@ -1362,7 +1666,7 @@ void MultiSymbolTrader::handle_simulation_phase(
             (warmup_metrics_.current_equity - warmup_metrics_.starting_equity) /
             warmup_metrics_.starting_equity * 100 : 0.0;
 
-        std::cout << "  [SIMULATION] Bar " << bars_seen_
+        console() << "  [SIMULATION] Bar " << bars_seen_
                   << " | Equity: $" << std::fixed << std::setprecision(2)
                   << warmup_metrics_.current_equity
                   << " (" << std::showpos << sim_return << "%" << std::noshowpos << ")"
@@ -1371,7 +1675,7 @@ void MultiSymbolTrader::handle_simulation_phase(
 }
 
 void MultiSymbolTrader::handle_live_phase(
-    const std::unordered_map<Symbol, PredictionData>& predictions,
+    const PredictionSet& predictions,
     const std::unordered_map<Symbol, Bar>& market_data) {
 
     // Normal trading - exactly as before warmup was added
@@ -1387,13 +1691,13 @@ bool MultiSymbolTrader::evaluate_warmup_complete() {
 
     // CRITICAL WARNING: Alert if using TESTING mode
     if (cfg.mode == TradingConfig::WarmupMode::TESTING) {
-        std::cout << "\n⚠️  WARNING: Warmup in TESTING mode (relaxed criteria)\n";
-        std::cout << "⚠️  NOT SAFE FOR LIVE TRADING - Use PRODUCTION mode for real money!\n\n";
+        console() << "\n⚠️  WARNING: Warmup in TESTING mode (relaxed criteria)\n";
+        console() << "⚠️  NOT SAFE FOR LIVE TRADING - Use PRODUCTION mode for real money!\n\n";
     }
 
     // Check minimum trades
     if (static_cast<int>(metrics.simulated_trades.size()) < cfg.min_trades) {
-        std::cout << "  ❌ Too few trades: " << metrics.simulated_trades.size()
+        console() << "  ❌ Too few trades: " << metrics.simulated_trades.size()
                   << " < " << cfg.min_trades << "\n";
         return false;
     }
@@ -1401,7 +1705,7 @@ bool MultiSymbolTrader::evaluate_warmup_complete() {
     // Check Sharpe ratio
     double sharpe = metrics.calculate_sharpe();
     if (sharpe < cfg.min_sharpe_ratio) {
-        std::cout << "  ❌ Sharpe too low: " << std::fixed << std::setprecision(2)
+        console() << "  ❌ Sharpe too low: " << std::fixed << std::setprecision(2)
                   << sharpe << " < " << cfg.min_sharpe_ratio
                   << " [Mode: " << cfg.get_mode_name() << "]\n";
         return false;
@@ -1409,7 +1713,7 @@ bool MultiSymbolTrader::evaluate_warmup_complete() {
 
     // Check drawdown
     if (metrics.max_drawdown > cfg.max_drawdown) {
-        std::cout << "  ❌ Drawdown too high: " << (metrics.max_drawdown * 100)
+        console() << "  ❌ Drawdown too high: " << (metrics.max_drawdown * 100)
                   << "% > " << (cfg.max_drawdown * 100) << "%"
                   << " [Mode: " << cfg.get_mode_name() << "]\n";
         return false;
@@ -1420,30 +1724,30 @@ bool MultiSymbolTrader::evaluate_warmup_complete() {
         (metrics.current_equity - metrics.starting_equity) / metrics.starting_equity : 0.0;
 
     if (cfg.require_positive_return && total_return < 0) {
-        std::cout << "  ❌ Negative return: " << (total_return * 100) << "%\n";
+        console() << "  ❌ Negative return: " << (total_return * 100) << "%\n";
         return false;
     }
 
     // All checks passed
-    std::cout << "  ✅ All warmup criteria met [Mode: " << cfg.get_mode_name() << "]\n";
+    console() << "  ✅ All warmup criteria met [Mode: " << cfg.get_mode_name() << "]\n";
     return true;
 }
 
 void MultiSymbolTrader::print_warmup_summary() {
-    std::cout << "\n========== WARMUP SUMMARY ==========\n";
-    std::cout << "Observation: " << config_.warmup.observation_days << " days\n";
-    std::cout << "Simulation: " << config_.warmup.simulation_days << " days\n";
-    std::cout << "\nResults:\n";
+    console() << "\n========== WARMUP SUMMARY ==========\n";
+    console() << "Observation: " << config_.warmup.observation_days << " days\n";
+    console() << "Simulation: " << config_.warmup.simulation_days << " days\n";
+    console() << "\nResults:\n";
 
     double total_return = warmup_metrics_.starting_equity > 0 ?
         (warmup_metrics_.current_equity - warmup_metrics_.starting_equity) /
         warmup_metrics_.starting_equity : 0.0;
 
-    std::cout << "  Return: " << std::fixed << std::setprecision(2)
+    console() << "  Return: " << std::fixed << std::setprecision(2)
               << (total_return * 100) << "%\n";
-    std::cout << "  Sharpe: " << warmup_metrics_.calculate_sharpe() << "\n";
-    std::cout << "  Max DD: " << (warmup_metrics_.max_drawdown * 100) << "%\n";
-    std::cout << "  Trades: " << warmup_metrics_.simulated_trades.size() << "\n";
+    console() << "  Sharpe: " << warmup_metrics_.calculate_sharpe() << "\n";
+    console() << "  Max DD: " << (warmup_metrics_.max_drawdown * 100) << "%\n";
+    console() << "  Trades: " << warmup_metrics_.simulated_trades.size() << "\n";
 
     // Win/loss breakdown
     int wins = 0, losses = 0;
@@ -1453,13 +1757,13 @@ void MultiSymbolTrader::print_warmup_summary() {
     }
 
     if (!warmup_metrics_.simulated_trades.empty()) {
-        std::cout << "  Win Rate: " << std::fixed << std::setprecision(1)
+        console() << "  Win Rate: " << std::fixed << std::setprecision(1)
                   << (100.0 * wins / warmup_metrics_.simulated_trades.size())
                   << "% (" << wins << "W/" << losses << "L)\n";
     }
 
-    std::cout << "\n✅ All criteria met - ready for live\n";
-    std::cout << "====================================\n\n";
+    console() << "\n✅ All criteria met - ready for live\n";
+    console() << "====================================\n\n";
 }
 
 // ============================================================================
@@ -1467,7 +1771,7 @@ void MultiSymbolTrader::print_warmup_summary() {
 // ============================================================================
 
 Symbol MultiSymbolTrader::find_weakest_position(
-    const std::unordered_map<Symbol, PredictionData>& predictions) const {
+    const PredictionSet& predictions) const {
 
     if (positions_.empty()) {
         return "";
@@ -1477,20 +1781,20 @@ Symbol MultiSymbolTrader::find_weakest_position(
     double min_strength = std::numeric_limits<double>::max();
 
     // Build a deterministic list of currently held symbols, sorted by symbol name
-    std::vector<Symbol> held_symbols;
-    held_symbols.reserve(positions_.size());
+    auto& held_symbols = held_scratch_;
+    held_symbols.clear();
     for (const auto& kv : positions_) {
         held_symbols.push_back(kv.first);
     }
     std::sort(held_symbols.begin(), held_symbols.end());
 
     for (const auto& symbol : held_symbols) {
-        auto pred_it = predictions.find(symbol);
-        if (pred_it == predictions.end()) {
+        const PredictionData* pred_it = predictions.find(symbol);
+        if (!pred_it) {
             continue;
         }
 
-        double strength = std::abs(pred_it->second.prediction.pred_2bar.prediction);
+        double strength = std::abs(pred_it->prediction.pred_2bar.prediction);
 
         if (strength < min_strength) {
             min_strength = strength;
@@ -0,0 +1,269 @@
+#include "trading/optimizer.h"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+
+namespace trading {
+
+namespace {
+
+double clamp_unit(double v) {
+    return std::min(1.0, std::max(0.0, v));
+}
+
+} // namespace
+
+// ============================================================================
+// SearchSpace
+// ============================================================================
+
+void SearchSpace::add(const std::string& name, double lo, double hi) {
+    const ParamInfo* param = find_param(name);
+    if (!param) {
+        throw std::runtime_error("Unknown parameter: '" + name + "'");
+    }
+    if (!(lo < hi)) {
+        throw std::runtime_error("Empty range for parameter '" + name + "'");
+    }
+    dims_.push_back({param, lo, hi});
+}
+
+std::vector<double> SearchSpace::decode(const std::vector<double>& unit) const {
+    std::vector<double> values(dims_.size());
+    for (size_t i = 0; i < dims_.size(); ++i) {
+        const auto& d = dims_[i];
+        double v = d.lo + clamp_unit(unit[i]) * (d.hi - d.lo);
+        values[i] = d.param->is_int ? std::round(v) : v;
+    }
+    return values;
+}
+
+std::vector<double> SearchSpace::encode(const TradingConfig& config) const {
+    std::vector<double> unit(dims_.size());
+    for (size_t i = 0; i < dims_.size(); ++i) {
+        const auto& d = dims_[i];
+        unit[i] = clamp_unit((d.param->get(config) - d.lo) / (d.hi - d.lo));
+    }
+    return unit;
+}
+
+TradingConfig SearchSpace::apply(const TradingConfig& base, const std::vector<double>& unit) const {
+    TradingConfig config = base;
+    std::vector<double> values = decode(unit);
+    for (size_t i = 0; i < dims_.size(); ++i) {
+        dims_[i].param->set(config, values[i]);
+    }
+    return config;
+}
+
+SearchSpace SearchSpace::sigor_default() {
+    SearchSpace space;
+    for (const char* w : {"w_boll", "w_rsi", "w_mom", "w_vwap", "w_orb", "w_ofi", "w_vol"}) {
+        space.add(w, 0.1, 2.0);
+    }
+    space.add("win_boll", 10, 50);
+    space.add("win_rsi", 5, 30);
+    space.add("win_mom", 3, 20);
+    space.add("win_vwap", 10, 50);
+    space.add("orb_opening_bars", 10, 50);
+    space.add("vol_window", 10, 50);
+    return space;
+}
+
+// ============================================================================
+// CMA-ES
+// ============================================================================
+
+CmaEs::CmaEs(const std::vector<double>& x0, double sigma0, size_t population, uint64_t seed)
+    : n_(x0.size()),
+      sigma_(sigma0),
+      rng_(seed) {
+    if (n_ == 0) {
+        throw std::runtime_error("CMA-ES: empty search space");
+    }
+    const double n = static_cast<double>(n_);
+
+    lambda_ = (population > 0) ? population
+                               : 4 + static_cast<size_t>(std::floor(3.0 * std::log(n)));
+    lambda_ = std::max<size_t>(lambda_, 2);
+    mu_ = lambda_ / 2;
+
+    // Log-linear recombination weights
+    weights_.resize(mu_);
+    for (size_t i = 0; i < mu_; ++i) {
+        weights_(i) = std::log(mu_ + 0.5) - std::log(static_cast<double>(i + 1));
+    }
+    weights_ /= weights_.sum();
+    mueff_ = 1.0 / weights_.squaredNorm();
+
+    // Strategy parameters (Hansen's defaults)
+    cc_ = (4.0 + mueff_ / n) / (n + 4.0 + 2.0 * mueff_ / n);
+    cs_ = (mueff_ + 2.0) / (n + mueff_ + 5.0);
+    c1_ = 2.0 / ((n + 1.3) * (n + 1.3) + mueff_);
+    cmu_ = std::min(1.0 - c1_, 2.0 * (mueff_ - 2.0 + 1.0 / mueff_) / ((n + 2.0) * (n + 2.0) + mueff_));
+    damps_ = 1.0 + 2.0 * std::max(0.0, std::sqrt((mueff_ - 1.0) / (n + 1.0)) - 1.0) + cs_;
+    chi_n_ = std::sqrt(n) * (1.0 - 1.0 / (4.0 * n) + 1.0 / (21.0 * n * n));
+
+    mean_ = Eigen::Map<const Eigen::VectorXd>(x0.data(), n_);
+    pc_ = Eigen::VectorXd::Zero(n_);
+    ps_ = Eigen::VectorXd::Zero(n_);
+    C_ = Eigen::MatrixXd::Identity(n_, n_);
+    B_ = Eigen::MatrixXd::Identity(n_, n_);
+    D_ = Eigen::VectorXd::Ones(n_);
+    inv_sqrt_C_ = Eigen::MatrixXd::Identity(n_, n_);
+}
+
+std::vector<std::vector<double>> CmaEs::ask() {
+    std::normal_distribution<double> normal(0.0, 1.0);
+    candidates_.resize(n_, lambda_);
+    Eigen::VectorXd z(n_);
+
+    std::vector<std::vector<double>> out(lambda_, std::vector<double>(n_));
+    for (size_t k = 0; k < lambda_; ++k) {
+        for (size_t i = 0; i < n_; ++i) z(i) = normal(rng_);
+        Eigen::VectorXd x = mean_ + sigma_ * (B_ * D_.cwiseProduct(z));
+        x = x.cwiseMax(0.0).cwiseMin(1.0);   // Repair into the box
+        candidates_.col(k) = x;
+        Eigen::VectorXd::Map(out[k].data(), n_) = x;
+    }
+    return out;
+}
+
+void CmaEs::tell(const std::vector<double>& fitness) {
+    if (fitness.size() != static_cast<size_t>(candidates_.cols())) {
+        throw std::runtime_error("CMA-ES: fitness count does not match candidates");
+    }
+    generation_++;
+
+    // Rank candidates best-first (maximization)
+    std::vector<size_t> order(lambda_);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) { return fitness[a] > fitness[b]; });
+
+    Eigen::MatrixXd selected(n_, mu_);   // Best mu steps, scaled by sigma
+    Eigen::VectorXd old_mean = mean_;
+    mean_.setZero();
+    for (size_t k = 0; k < mu_; ++k) {
+        mean_ += weights_(k) * candidates_.col(order[k]);
+        selected.col(k) = (candidates_.col(order[k]) - old_mean) / sigma_;
+    }
+    Eigen::VectorXd step = (mean_ - old_mean) / sigma_;
+
+    // Evolution paths
+    ps_ = (1.0 - cs_) * ps_ + std::sqrt(cs_ * (2.0 - cs_) * mueff_) * (inv_sqrt_C_ * step);
+    double ps_norm = ps_.norm();
+    double hsig_denom = std::sqrt(1.0 - std::pow(1.0 - cs_, 2.0 * generation_));
+    bool hsig = ps_norm / hsig_denom / chi_n_ < 1.4 + 2.0 / (n_ + 1.0);
+
+    pc_ = (1.0 - cc_) * pc_;
+    if (hsig) pc_ += std::sqrt(cc_ * (2.0 - cc_) * mueff_) * step;
+
+    // Covariance: rank-one + rank-mu update
+    double c1a = c1_ * (1.0 - (hsig ? 0.0 : cc_ * (2.0 - cc_)));
+    C_ = (1.0 - c1a - cmu_) * C_
+       + c1_ * (pc_ * pc_.transpose())
+       + cmu_ * (selected * weights_.asDiagonal() * selected.transpose());
+
+    // Step size (capped: the whole box is the unit cube)
+    sigma_ *= std::exp((cs_ / damps_) * (ps_norm / chi_n_ - 1.0));
+    sigma_ = std::min(sigma_, 1.0);
+
+    update_eigensystem();
+}
+
+void CmaEs::update_eigensystem() {
+    C_ = 0.5 * (C_ + C_.transpose());   // Enforce symmetry against rounding drift
+    Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> solver(C_);
+    B_ = solver.eigenvectors();
+    D_ = solver.eigenvalues().cwiseMax(1e-20).cwiseSqrt();
+    inv_sqrt_C_ = B_ * D_.cwiseInverse().asDiagonal() * B_.transpose();
+}
+
+// ============================================================================
+// Differential Evolution
+// ============================================================================
+
+DifferentialEvolution::DifferentialEvolution(const std::vector<double>& x0, size_t population,
+                                             uint64_t seed, double F, double CR)
+    : n_(x0.size()),
+      F_(F),
+      CR_(CR),
+      rng_(seed) {
+    if (n_ == 0) {
+        throw std::runtime_error("DE: empty search space");
+    }
+    size_t np = (population > 0) ? population : 20;
+    np = std::max<size_t>(np, 4);  // rand/1 needs three partners
+
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    members_.assign(np, std::vector<double>(n_));
+    members_[0] = x0;
+    for (size_t m = 1; m < np; ++m) {
+        for (auto& v : members_[m]) v = uniform(rng_);
+    }
+    member_fitness_.assign(np, 0.0);
+}
+
+std::vector<std::vector<double>> DifferentialEvolution::ask() {
+    if (!initialized_) {
+        trials_ = members_;
+        return trials_;
+    }
+
+    const size_t np = members_.size();
+    std::uniform_int_distribution<size_t> pick(0, np - 1);
+    std::uniform_int_distribution<size_t> pick_dim(0, n_ - 1);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+    trials_.assign(np, std::vector<double>(n_));
+    for (size_t i = 0; i < np; ++i) {
+        size_t a, b, c;
+        do { a = pick(rng_); } while (a == i);
+        do { b = pick(rng_); } while (b == i || b == a);
+        do { c = pick(rng_); } while (c == i || c == a || c == b);
+
+        size_t forced = pick_dim(rng_);   // At least one mutated coordinate
+        for (size_t d = 0; d < n_; ++d) {
+            if (d == forced || uniform(rng_) < CR_) {
+                double v = members_[a][d] + F_ * (members_[b][d] - members_[c][d]);
+                trials_[i][d] = clamp_unit(v);
+            } else {
+                trials_[i][d] = members_[i][d];
+            }
+        }
+    }
+    return trials_;
+}
+
+void DifferentialEvolution::tell(const std::vector<double>& fitness) {
+    if (fitness.size() != trials_.size()) {
+        throw std::runtime_error("DE: fitness count does not match candidates");
+    }
+    if (!initialized_) {
+        member_fitness_ = fitness;
+        initialized_ = true;
+        return;
+    }
+    for (size_t i = 0; i < members_.size(); ++i) {
+        if (fitness[i] >= member_fitness_[i]) {
+            members_[i] = trials_[i];
+            member_fitness_[i] = fitness[i];
+        }
+    }
+}
+
+std::unique_ptr<BlackBoxOptimizer> make_optimizer(const std::string& algorithm,
+                                                  const std::vector<double>& x0,
+                                                  size_t population,
+                                                  uint64_t seed) {
+    if (algorithm == "cmaes" || algorithm == "cma-es") {
+        return std::make_unique<CmaEs>(x0, 0.3, population, seed);
+    }
+    if (algorithm == "de") {
+        return std::make_unique<DifferentialEvolution>(x0, population, seed);
+    }
+    throw std::runtime_error("Unknown optimizer: '" + algorithm + "' (expected cmaes or de)");
+}
+
+} // namespace trading
@@ -0,0 +1,348 @@
+#include "trading/order_gateway.h"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <fcntl.h>
+#include <iomanip>
+#include <poll.h>
+#include <pthread.h>
+#include <sstream>
+#include <stdexcept>
+#include <unistd.h>
+
+namespace trading {
+
+namespace {
+
+uint64_t steady_ns() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+OrderStatus parse_status(const std::string& status) {
+    if (status == "filled") return OrderStatus::FILLED;
+    if (status == "rejected" || status == "canceled" || status == "expired") return OrderStatus::REJECTED;
+    return OrderStatus::PENDING;
+}
+
+} // namespace
+
+void OrderBatch::sort_exits_first() {
+    std::stable_partition(legs.begin(), legs.end(), [](const OrderLeg& leg) { return leg.qty < 0; });
+}
+
+const char* order_status_name(OrderStatus status) {
+    switch (status) {
+        case OrderStatus::QUEUED:   return "queued";
+        case OrderStatus::SENT:     return "sent";
+        case OrderStatus::FILLED:   return "filled";
+        case OrderStatus::PENDING:  return "pending";
+        case OrderStatus::REJECTED: return "rejected";
+        default:                    return "unknown";
+    }
+}
+
+// ============================================================================
+// Wire protocol
+// ============================================================================
+
+namespace order_wire {
+
+void encode(const OrderBatch& batch, OrderWireFormat format, std::string& out) {
+    if (format == OrderWireFormat::BINARY) {
+        if (batch.legs.size() > UINT16_MAX) {
+            throw std::runtime_error("Order batch too large for binary wire format");
+        }
+        BinaryBatchHeader header{};
+        header.magic = BATCH_MAGIC;
+        header.version = 1;
+        header.count = static_cast<uint16_t>(batch.legs.size());
+        header.batch_id = batch.batch_id;
+        header.bar_id = batch.bar_id;
+        out.append(reinterpret_cast<const char*>(&header), sizeof(header));
+
+        for (const auto& leg : batch.legs) {
+            if (leg.symbol.size() > SYMBOL_BYTES) {
+                throw std::runtime_error("Symbol too long for binary wire format: " + leg.symbol);
+            }
+            BinaryOrderRecord record{};
+            std::memcpy(record.symbol, leg.symbol.data(), leg.symbol.size());
+            record.order_id = leg.order_id;
+            record.qty = leg.qty;
+            record.ref_price = leg.ref_price;
+            out.append(reinterpret_cast<const char*>(&record), sizeof(record));
+        }
+        return;
+    }
+
+    std::ostringstream line;
+    line << std::setprecision(10)
+         << "{\"batch_id\":" << batch.batch_id << ",\"bar_id\":" << batch.bar_id << ",\"orders\":[";
+    for (size_t i = 0; i < batch.legs.size(); ++i) {
+        const auto& leg = batch.legs[i];
+        line << (i ? "," : "") << "{\"order_id\":" << leg.order_id
+             << ",\"action\":\"" << (leg.qty > 0 ? "BUY" : "SELL") << "\""
+             << ",\"symbol\":\"" << leg.symbol << "\""
+             << ",\"shares\":" << std::abs(leg.qty)
+             << ",\"ref_price\":" << leg.ref_price << "}";
+    }
+    line << "]}\n";
+    out += line.str();
+}
+
+size_t decode_responses(std::string& buffer, OrderWireFormat format,
+                        std::vector<Response>& out, size_t& malformed) {
+    size_t decoded = 0;
+    size_t consumed = 0;
+
+    if (format == OrderWireFormat::BINARY) {
+        while (buffer.size() - consumed >= sizeof(BinaryOrderResponse)) {
+            BinaryOrderResponse raw;
+            std::memcpy(&raw, buffer.data() + consumed, sizeof(raw));
+            if (raw.magic != RESPONSE_MAGIC || raw.status > static_cast<uint8_t>(OrderStatus::REJECTED)) {
+                consumed++;             // Resynchronize one byte at a time
+                malformed++;
+                continue;
+            }
+            out.push_back({raw.order_id, static_cast<OrderStatus>(raw.status), raw.filled_price});
+            consumed += sizeof(raw);
+            decoded++;
+        }
+        buffer.erase(0, consumed);
+        return decoded;
+    }
+
+    size_t nl;
+    while ((nl = buffer.find('\n', consumed)) != std::string::npos) {
+        std::string line = buffer.substr(consumed, nl - consumed);
+        consumed = nl + 1;
+        if (line.find_first_not_of(" \t\r") == std::string::npos) continue;
+
+        auto json = nlohmann::json::parse(line, nullptr, false);
+        if (json.is_discarded() || !json.is_object() || !json.contains("order_id")) {
+            malformed++;
+            continue;
+        }
+        Response response;
+        try {
+            const auto& id = json["order_id"];
+            response.order_id = id.is_string() ? std::stoull(id.get<std::string>()) : id.get<uint64_t>();
+            response.status = parse_status(json.value("status", std::string("pending")));
+            response.filled_price = json.value("filled_price", 0.0);
+        } catch (const std::exception&) {
+            malformed++;
+            continue;
+        }
+        out.push_back(response);
+        decoded++;
+    }
+    buffer.erase(0, consumed);
+    return decoded;
+}
+
+} // namespace order_wire
+
+// ============================================================================
+// Gateway
+// ============================================================================
+
+OrderGateway::OrderGateway(Options options)
+    : options_(std::move(options)),
+      inbound_(options_.queue_capacity) {}
+
+OrderGateway::~OrderGateway() {
+    stop();
+}
+
+void OrderGateway::start() {
+    if (thread_.joinable()) return;
+    stopping_ = false;
+    thread_ = std::thread([this]() { run(); });
+}
+
+void OrderGateway::stop() {
+    if (!thread_.joinable()) return;
+    stopping_ = true;
+    thread_.join();
+}
+
+bool OrderGateway::submit(OrderBatch&& batch) {
+    stats_.batches_submitted.fetch_add(1, std::memory_order_relaxed);
+    if (!inbound_.try_push(std::move(batch))) {
+        stats_.batches_rejected.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    return true;
+}
+
+size_t OrderGateway::outstanding() const {
+    size_t n = 0;
+    for (const auto& [_, order] : orders_) {
+        if (order.status == OrderStatus::SENT || order.status == OrderStatus::PENDING) n++;
+    }
+    return n;
+}
+
+void OrderGateway::run() {
+    // A bridge that exits mid-write must surface as EPIPE here, not kill the process
+    sigset_t block;
+    sigemptyset(&block);
+    sigaddset(&block, SIGPIPE);
+    pthread_sigmask(SIG_BLOCK, &block, nullptr);
+
+    std::chrono::steady_clock::time_point drain_deadline{};
+    bool draining = false;
+
+    while (true) {
+        if (order_fd_ < 0 && std::chrono::steady_clock::now() >= next_open_attempt_) open_fds();
+        take_inbound();
+        flush_pending();
+        read_responses();
+
+        if (stopping_.load(std::memory_order_acquire)) {
+            if (!draining) {
+                draining = true;
+                drain_deadline = std::chrono::steady_clock::now() + options_.drain_timeout;
+            }
+            bool idle = pending_.empty() && inbound_.empty_approx() && outstanding() == 0;
+            if (idle || std::chrono::steady_clock::now() >= drain_deadline) break;
+        }
+
+        struct pollfd fds[2];
+        nfds_t count = 0;
+        if (order_fd_ >= 0 && !pending_.empty()) fds[count++] = {order_fd_, POLLOUT, 0};
+        if (response_fd_ >= 0) fds[count++] = {response_fd_, POLLIN, 0};
+        ::poll(count ? fds : nullptr, count, 1);
+    }
+
+    // Batches still queued when the drain timed out count as unsent
+    OrderBatch abandoned;
+    size_t unsent = pending_.size();
+    while (inbound_.try_pop(abandoned)) unsent++;
+    stats_.pending_batches.store(unsent, std::memory_order_relaxed);
+
+    read_responses();
+    close_order_fd();
+    if (response_fd_ >= 0) {
+        ::close(response_fd_);
+        response_fd_ = -1;
+    }
+}
+
+void OrderGateway::open_fds() {
+    next_open_attempt_ = std::chrono::steady_clock::now() + options_.reopen_interval;
+
+    // Fails with ENXIO until the bridge has the FIFO open for reading
+    int fd = ::open(options_.order_path.c_str(), O_WRONLY | O_NONBLOCK);
+    if (fd < 0) return;
+    order_fd_ = fd;
+
+    // The bridge (re)creates both FIFOs at startup, so reopen responses with
+    // every new order connection. O_RDWR keeps a writer reference of our own:
+    // the bridge opening and closing the FIFO per response never reads as EOF.
+    if (response_fd_ >= 0) ::close(response_fd_);
+    response_fd_ = ::open(options_.response_path.c_str(), O_RDWR | O_NONBLOCK);
+    response_buffer_.clear();
+}
+
+void OrderGateway::close_order_fd() {
+    if (order_fd_ >= 0) ::close(order_fd_);
+    order_fd_ = -1;
+}
+
+void OrderGateway::take_inbound() {
+    OrderBatch batch;
+    while (pending_.size() < options_.max_pending && inbound_.try_pop(batch)) {
+        batch.sort_exits_first();
+        PendingWrite write;
+        try {
+            order_wire::encode(batch, options_.format, write.bytes);
+        } catch (const std::exception&) {
+            for (const auto& leg : batch.legs) {
+                orders_[leg.order_id] = {leg.symbol, leg.qty, OrderStatus::REJECTED, 0.0, 0, false};
+            }
+            stats_.orders_rejected.fetch_add(batch.legs.size(), std::memory_order_relaxed);
+            stats_.write_errors.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+        for (const auto& leg : batch.legs) {
+            write.order_ids.push_back(leg.order_id);
+            orders_[leg.order_id] = {leg.symbol, leg.qty, OrderStatus::QUEUED, 0.0, 0, false};
+        }
+        pending_.push_back(std::move(write));
+    }
+    stats_.pending_batches.store(pending_.size(), std::memory_order_relaxed);
+}
+
+void OrderGateway::flush_pending() {
+    while (order_fd_ >= 0 && !pending_.empty()) {
+        PendingWrite& front = pending_.front();
+        ssize_t n = ::write(order_fd_, front.bytes.data() + front.written, front.bytes.size() - front.written);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN) break;     // Pipe full: wait for POLLOUT
+            // Bridge went away (EPIPE): resend the whole batch once it reconnects
+            stats_.write_errors.fetch_add(1, std::memory_order_relaxed);
+            front.written = 0;
+            close_order_fd();
+            break;
+        }
+        front.written += static_cast<size_t>(n);
+        if (front.written < front.bytes.size()) continue;
+
+        const uint64_t now = steady_ns();
+        for (uint64_t id : front.order_ids) {
+            auto& order = orders_[id];
+            order.status = OrderStatus::SENT;
+            order.sent_ns = now;
+        }
+        stats_.batches_sent.fetch_add(1, std::memory_order_relaxed);
+        stats_.orders_sent.fetch_add(front.order_ids.size(), std::memory_order_relaxed);
+        pending_.pop_front();
+    }
+    stats_.pending_batches.store(pending_.size(), std::memory_order_relaxed);
+}
+
+void OrderGateway::read_responses() {
+    if (response_fd_ < 0) return;
+
+    char chunk[4096];
+    while (true) {
+        ssize_t n = ::read(response_fd_, chunk, sizeof(chunk));
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) break;
+        response_buffer_.append(chunk, static_cast<size_t>(n));
+    }
+    if (response_buffer_.empty()) return;
+
+    std::vector<order_wire::Response> responses;
+    size_t malformed = 0;
+    order_wire::decode_responses(response_buffer_, options_.format, responses, malformed);
+    if (malformed) stats_.responses_malformed.fetch_add(malformed, std::memory_order_relaxed);
+
+    const uint64_t now = steady_ns();
+    for (const auto& response : responses) {
+        auto it = orders_.find(response.order_id);
+        if (it == orders_.end()) {
+            stats_.responses_unmatched.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+        TrackedOrder& order = it->second;
+        if (!order.acked && order.sent_ns != 0) {
+            ack_latency_.record(now - order.sent_ns);
+            order.acked = true;
+        }
+        if (order.status == OrderStatus::FILLED || order.status == OrderStatus::REJECTED) continue;
+        order.status = response.status;
+        order.filled_price = response.filled_price;
+        if (response.status == OrderStatus::FILLED) {
+            stats_.orders_filled.fetch_add(1, std::memory_order_relaxed);
+        } else if (response.status == OrderStatus::REJECTED) {
+            stats_.orders_rejected.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
+
+} // namespace trading
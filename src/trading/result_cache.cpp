@@ -0,0 +1,362 @@
+#include "trading/result_cache.h"
+#include "trading/backtest_runner.h"
+#include "utils/fingerprint.h"
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <unistd.h>
+
+namespace trading {
+
+namespace {
+
+constexpr const char* kEntryMagic = "SLRC 1";
+constexpr size_t kMaxMemoryEntries = 16384;   // ~2 KB key each; cleared when full
+
+/**
+ * Hash of the running executable: any rebuild changes engine behaviour
+ * potentially, so it must change every key. Computed once per process.
+ */
+const std::string& engine_fingerprint() {
+    static const std::string fingerprint = [] {
+        std::ifstream exe("/proc/self/exe", std::ios::binary);
+        if (!exe.is_open()) {
+            return std::string("build-") + __DATE__ + " " + __TIME__;
+        }
+        utils::Fingerprint fp;
+        char buf[1 << 16];
+        while (exe.read(buf, sizeof(buf)) || exe.gcount() > 0) {
+            fp.add_bytes(buf, static_cast<size_t>(exe.gcount()));
+        }
+        return fp.hex();
+    }();
+    return fingerprint;
+}
+
+/**
+ * Canonical "name=value" lines; doubles printed round-trip exact
+ */
+class KeyWriter {
+public:
+    void add(const char* name, double v) {
+        char buf[40];
+        std::snprintf(buf, sizeof(buf), "%.17g", v);
+        line(name, buf);
+    }
+    void add(const char* name, int64_t v) { line(name, std::to_string(v)); }
+    void add(const char* name, int v) { add(name, static_cast<int64_t>(v)); }
+    void add(const char* name, size_t v) { add(name, static_cast<int64_t>(v)); }
+    void add(const char* name, bool v) { line(name, v ? "1" : "0"); }
+    void add(const char* name, const std::string& v) { line(name, v); }
+
+    std::string str() const { return text_; }
+
+private:
+    std::string text_;
+
+    void line(const char* name, const std::string& value) {
+        text_ += name;
+        text_ += '=';
+        text_ += value;
+        text_ += '\n';
+    }
+};
+
+std::string format_double(double v) {
+    char buf[40];
+    std::snprintf(buf, sizeof(buf), "%.17g", v);
+    return buf;
+}
+
+} // namespace
+
+ResultCache::ResultCache(const std::string& directory)
+    : directory_(directory) {
+    std::error_code ec;
+    std::filesystem::create_directories(directory_, ec);
+    if (ec) {
+        throw std::runtime_error("Cannot create result cache directory " + directory_ + ": " + ec.message());
+    }
+}
+
+std::string ResultCache::make_key(const ReplayWindow& window, const TradingConfig& c) {
+    KeyWriter k;
+    k.add("engine", engine_fingerprint());
+    const char* tz = std::getenv("TZ");
+    k.add("tz", std::string(tz ? tz : ""));
+
+    // Replayed data
+    std::string symbols;
+    for (const auto& s : window.symbols) {
+        symbols += s;
+        symbols += ',';
+    }
+    k.add("symbols", symbols);
+    k.add("test_date", window.test_date);
+    k.add("window_bars", window.size());
+    k.add("window_warmup_bars", window.warmup_bars);
+    k.add("window_sim_days", window.sim_days);
+    char data_hex[17];
+    std::snprintf(data_hex, sizeof(data_hex), "%016llx", static_cast<unsigned long long>(window.data_fingerprint));
+    k.add("data", std::string(data_hex));
+
+    // Every result-affecting TradingConfig field. Not included: quiet and the
+    // trade journal settings (logging/storage only). A new config field that
+    // can change results MUST be added here, or stale entries will be served.
+    k.add("strategy", static_cast<int>(c.strategy));
+
+    const auto& s = c.sigor_config;
+    k.add("sigor.k", s.k);
+    k.add("sigor.w_boll", s.w_boll);
+    k.add("sigor.w_rsi", s.w_rsi);
+    k.add("sigor.w_mom", s.w_mom);
+    k.add("sigor.w_vwap", s.w_vwap);
+    k.add("sigor.w_orb", s.w_orb);
+    k.add("sigor.w_ofi", s.w_ofi);
+    k.add("sigor.w_vol", s.w_vol);
+    k.add("sigor.win_boll", s.win_boll);
+    k.add("sigor.win_rsi", s.win_rsi);
+    k.add("sigor.win_mom", s.win_mom);
+    k.add("sigor.win_vwap", s.win_vwap);
+    k.add("sigor.orb_opening_bars", s.orb_opening_bars);
+    k.add("sigor.vol_window", s.vol_window);
+    k.add("sigor.warmup_bars", s.warmup_bars);
+
+    const auto& a = c.awr_config;
+    k.add("awr.williams_period", a.williams_period);
+    k.add("awr.rsi_period", a.rsi_period);
+    k.add("awr.bb_period", a.bb_period);
+    k.add("awr.bb_stddev", a.bb_stddev);
+    k.add("awr.approach_threshold", a.approach_threshold);
+    k.add("awr.fresh_bars", a.fresh_bars);
+    k.add("awr.lower_band_zone", a.lower_band_zone);
+    k.add("awr.upper_band_zone", a.upper_band_zone);
+    k.add("awr.crossing_strength", a.crossing_strength);
+    k.add("awr.approaching_strength", a.approaching_strength);
+    k.add("awr.fresh_strength", a.fresh_strength);
+
+    k.add("initial_capital", c.initial_capital);
+    k.add("max_positions", c.max_positions);
+    k.add("min_bars_to_learn", c.min_bars_to_learn);
+    k.add("bars_per_day", c.bars_per_day);
+    k.add("eod_liquidation", c.eod_liquidation);
+    k.add("win_multiplier", c.win_multiplier);
+    k.add("loss_multiplier", c.loss_multiplier);
+    k.add("trade_history_size", c.trade_history_size);
+    k.add("min_prediction_for_entry", c.min_prediction_for_entry);
+    k.add("min_prediction_increase_on_trade", c.min_prediction_increase_on_trade);
+    k.add("min_prediction_decrease_on_no_trade", c.min_prediction_decrease_on_no_trade);
+
+    const auto& f = c.filter_config;
+    k.add("filter.min_bars_to_hold", f.min_bars_to_hold);
+    k.add("filter.typical_hold_period", f.typical_hold_period);
+    k.add("filter.max_bars_to_hold", f.max_bars_to_hold);
+    k.add("filter.min_bars_between_entries", f.min_bars_between_entries);
+    k.add("filter.max_trades_per_hour", f.max_trades_per_hour);
+    k.add("filter.max_trades_per_day", f.max_trades_per_day);
+    k.add("filter.min_prediction_for_entry", f.min_prediction_for_entry);
+    k.add("filter.min_confidence_for_entry", f.min_confidence_for_entry);
+    k.add("filter.exit_signal_reversed_threshold", f.exit_signal_reversed_threshold);
+    k.add("filter.exit_confidence_threshold", f.exit_confidence_threshold);
+    k.add("filter.profit_target_multiple", f.profit_target_multiple);
+
+    k.add("enable_cost_tracking", c.enable_cost_tracking);
+    k.add("default_avg_volume", c.default_avg_volume);
+    k.add("default_volatility", c.default_volatility);
+    k.add("enable_probability_scaling", c.enable_probability_scaling);
+    k.add("probability_scaling_factor", c.probability_scaling_factor);
+    k.add("buy_threshold", c.buy_threshold);
+    k.add("sell_threshold", c.sell_threshold);
+    k.add("enable_rotation", c.enable_rotation);
+    k.add("rotation_strength_delta", c.rotation_strength_delta);
+    k.add("rotation_cooldown_bars", c.rotation_cooldown_bars);
+    k.add("min_rank_strength", c.min_rank_strength);
+    k.add("enable_price_based_exits", c.enable_price_based_exits);
+    k.add("exit_on_ma_crossover", c.exit_on_ma_crossover);
+    k.add("trailing_stop_percentage", c.trailing_stop_percentage);
+    k.add("ma_exit_period", c.ma_exit_period);
+    k.add("enable_profit_target", c.enable_profit_target);
+    k.add("profit_target_pct", c.profit_target_pct);
+    k.add("enable_stop_loss", c.enable_stop_loss);
+    k.add("stop_loss_pct", c.stop_loss_pct);
+
+    const auto& p = c.position_sizing;
+    k.add("sizing.expected_win_pct", p.expected_win_pct);
+    k.add("sizing.expected_loss_pct", p.expected_loss_pct);
+    k.add("sizing.fractional_kelly", p.fractional_kelly);
+    k.add("sizing.min_position_pct", p.min_position_pct);
+    k.add("sizing.max_position_pct", p.max_position_pct);
+    k.add("sizing.enable_volatility_adjustment", p.enable_volatility_adjustment);
+    k.add("sizing.volatility_lookback", p.volatility_lookback);
+    k.add("sizing.max_volatility_reduce", p.max_volatility_reduce);
+
+    const auto& w = c.warmup;
+    k.add("warmup.enabled", w.enabled);
+    k.add("warmup.observation_days", w.observation_days);
+    k.add("warmup.simulation_days", w.simulation_days);
+    k.add("warmup.mode", static_cast<int>(w.mode));
+    k.add("warmup.skip_validation", w.skip_validation);
+    k.add("warmup.min_sharpe_ratio", w.min_sharpe_ratio);
+    k.add("warmup.max_drawdown", w.max_drawdown);
+    k.add("warmup.min_trades", w.min_trades);
+    k.add("warmup.require_positive_return", w.require_positive_return);
+    k.add("warmup.preserve_predictor_state", w.preserve_predictor_state);
+    k.add("warmup.preserve_trade_history", w.preserve_trade_history);
+    k.add("warmup.history_decay_factor", w.history_decay_factor);
+
+    k.add("current_phase", static_cast<int>(c.current_phase));
+    return k.str();
+}
+
+std::string ResultCache::path_for(const std::string& key) const {
+    utils::Fingerprint fp;
+    fp.add_string(key);
+    std::string hex = fp.hex();
+    return directory_ + "/" + hex.substr(0, 2) + "/" + hex + ".res";
+}
+
+bool ResultCache::lookup(const std::string& key, MultiSymbolTrader::BacktestResults& out) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = memory_.find(key);
+        if (it != memory_.end()) {
+            out = it->second;
+            memory_hits_++;
+            return true;
+        }
+    }
+
+    std::ifstream in(path_for(key), std::ios::binary);
+    if (!in.is_open()) {
+        misses_++;
+        return false;
+    }
+
+    // Entry layout: magic, key length, key bytes, one results line, daily rows
+    std::string magic;
+    size_t key_len = 0;
+    if (!std::getline(in, magic) || magic != kEntryMagic || !(in >> key_len) || in.get() != '\n') {
+        misses_++;
+        return false;
+    }
+    std::string stored_key(key_len, '\0');
+    if (!in.read(&stored_key[0], static_cast<std::streamsize>(key_len)) || stored_key != key) {
+        misses_++;   // Corrupt entry or hash collision
+        return false;
+    }
+
+    // Tokens parsed with strtod so inf/nan (e.g. profit factor without losses) round-trip
+    std::string rest((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    std::istringstream tokens(rest);
+    auto next = [&tokens](double& v) {
+        std::string t;
+        if (!(tokens >> t)) return false;
+        v = std::strtod(t.c_str(), nullptr);
+        return true;
+    };
+
+    MultiSymbolTrader::BacktestResults r{};
+    double total_trades, winning, losing, daily_count;
+    bool ok = next(r.total_return) && next(r.mrd) && next(r.final_equity) &&
+              next(total_trades) && next(winning) && next(losing) &&
+              next(r.win_rate) && next(r.avg_win) && next(r.avg_loss) &&
+              next(r.profit_factor) && next(r.max_drawdown) && next(r.sharpe_ratio) &&
+              next(r.total_transaction_costs) && next(r.avg_cost_per_trade) &&
+              next(r.cost_as_pct_of_volume) && next(r.net_return_after_costs) &&
+              next(daily_count);
+    if (ok) {
+        r.total_trades = static_cast<int>(total_trades);
+        r.winning_trades = static_cast<int>(winning);
+        r.losing_trades = static_cast<int>(losing);
+        for (int d = 0; ok && d < static_cast<int>(daily_count); ++d) {
+            DailyResults day{};
+            double day_number, trades, wins, losses;
+            ok = next(day_number) && next(day.start_equity) && next(day.end_equity) &&
+                 next(day.daily_return) && next(trades) && next(wins) && next(losses);
+            day.day_number = static_cast<int>(day_number);
+            day.trades_today = static_cast<int>(trades);
+            day.winning_trades_today = static_cast<int>(wins);
+            day.losing_trades_today = static_cast<int>(losses);
+            r.daily_breakdown.push_back(day);
+        }
+    }
+    if (!ok) {
+        misses_++;
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (memory_.size() >= kMaxMemoryEntries) memory_.clear();
+        memory_.emplace(key, r);
+    }
+    out = std::move(r);
+    disk_hits_++;
+    return true;
+}
+
+void ResultCache::store(const std::string& key, const MultiSymbolTrader::BacktestResults& r) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (memory_.size() >= kMaxMemoryEntries) memory_.clear();
+        memory_.insert_or_assign(key, r);
+    }
+
+    std::string path = path_for(key);
+    std::error_code ec;
+    std::filesystem::create_directories(std::filesystem::path(path).parent_path(), ec);
+
+    std::ostringstream body;
+    body << kEntryMagic << "\n" << key.size() << "\n" << key
+         << format_double(r.total_return) << " " << format_double(r.mrd) << " "
+         << format_double(r.final_equity) << " " << r.total_trades << " "
+         << r.winning_trades << " " << r.losing_trades << " "
+         << format_double(r.win_rate) << " " << format_double(r.avg_win) << " "
+         << format_double(r.avg_loss) << " " << format_double(r.profit_factor) << " "
+         << format_double(r.max_drawdown) << " " << format_double(r.sharpe_ratio) << " "
+         << format_double(r.total_transaction_costs) << " " << format_double(r.avg_cost_per_trade) << " "
+         << format_double(r.cost_as_pct_of_volume) << " " << format_double(r.net_return_after_costs) << "\n"
+         << r.daily_breakdown.size() << "\n";
+    for (const auto& d : r.daily_breakdown) {
+        body << d.day_number << " " << format_double(d.start_equity) << " "
+             << format_double(d.end_equity) << " " << format_double(d.daily_return) << " "
+             << d.trades_today << " " << d.winning_trades_today << " " << d.losing_trades_today << "\n";
+    }
+
+    // Temp file + rename: readers in other processes never see a partial entry
+    std::ostringstream tmp_name;
+    tmp_name << path << ".tmp." << ::getpid() << "." << std::this_thread::get_id();
+    std::string tmp = tmp_name.str();
+    {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        out << body.str();
+        if (!out.good()) {
+            store_errors_++;
+            std::filesystem::remove(tmp, ec);
+            return;
+        }
+    }
+    std::filesystem::rename(tmp, path, ec);
+    if (ec) {
+        store_errors_++;
+        std::filesystem::remove(tmp, ec);
+        return;
+    }
+    stores_++;
+}
+
+ResultCache::Stats ResultCache::stats() const {
+    Stats s;
+    s.memory_hits = memory_hits_.load();
+    s.disk_hits = disk_hits_.load();
+    s.misses = misses_.load();
+    s.stores = stores_.load();
+    s.store_errors = store_errors_.load();
+    return s;
+}
+
+} // namespace trading
@@ -0,0 +1,129 @@
+#include "trading/snapshot_assembler.h"
+#include <algorithm>
+
+namespace trading {
+
+SnapshotAssembler::SnapshotAssembler(const std::vector<Symbol>& symbols,
+                                     std::chrono::milliseconds deadline)
+    : symbols_(symbols),
+      deadline_(deadline) {}
+
+void SnapshotAssembler::add_bar(const Bar& bar, Clock::time_point now) {
+    if (std::find(symbols_.begin(), symbols_.end(), bar.symbol) == symbols_.end()) {
+        stats_.unknown_bars++;
+        return;
+    }
+    if (released_any_ && bar.bar_id <= last_released_id_) {
+        stats_.late_bars++;
+        return;
+    }
+
+    auto [it, inserted] = pending_.try_emplace(bar.bar_id);
+    PendingMinute& minute = it->second;
+    if (inserted) {
+        minute.first_seen = now;
+    }
+
+    auto [bar_it, new_symbol] = minute.bars.insert_or_assign(bar.symbol, bar);
+    bar_it->second.stale = false;
+    if (!new_symbol) {
+        stats_.duplicate_bars++;
+    }
+
+    // Barrier: all expected symbols reported for this minute
+    bool all_reported = true;
+    for (const auto& symbol : symbols_) {
+        if (minute.bars.find(symbol) == minute.bars.end()) {
+            all_reported = false;
+            break;
+        }
+    }
+
+    if (all_reported) {
+        release_through(bar.bar_id, true);
+    }
+}
+
+void SnapshotAssembler::poll(Clock::time_point now) {
+    while (!pending_.empty()) {
+        auto it = pending_.begin();
+        if (now - it->second.first_seen < deadline_) break;
+        release(it->first, it->second, false);
+        pending_.erase(it);
+    }
+}
+
+void SnapshotAssembler::flush() {
+    while (!pending_.empty()) {
+        auto it = pending_.begin();
+        release(it->first, it->second, false);
+        pending_.erase(it);
+    }
+}
+
+bool SnapshotAssembler::pop_ready(Snapshot& out) {
+    if (ready_.empty()) return false;
+    out = std::move(ready_.front());
+    ready_.pop_front();
+    return true;
+}
+
+SnapshotAssembler::Clock::duration SnapshotAssembler::time_to_next_deadline(Clock::time_point now) const {
+    if (pending_.empty()) return Clock::duration::max();
+    auto due = pending_.begin()->second.first_seen + deadline_;
+    return (due > now) ? (due - now) : Clock::duration::zero();
+}
+
+void SnapshotAssembler::release_through(uint64_t bar_id, bool complete) {
+    // Earlier minutes can no longer complete in order - release them first
+    while (!pending_.empty() && pending_.begin()->first <= bar_id) {
+        auto it = pending_.begin();
+        release(it->first, it->second, complete && it->first == bar_id);
+        pending_.erase(it);
+    }
+}
+
+void SnapshotAssembler::release(uint64_t bar_id, PendingMinute& minute, bool complete) {
+    Snapshot snap;
+    snap.bar_id = bar_id;
+    snap.complete = complete;
+
+    // Reference timestamp for carried-forward bars
+    Timestamp minute_ts = minute.bars.empty() ? Timestamp() : minute.bars.begin()->second.timestamp;
+
+    for (const auto& symbol : symbols_) {
+        auto it = minute.bars.find(symbol);
+        if (it != minute.bars.end()) {
+            last_bars_[symbol] = it->second;
+            snap.bars.emplace(symbol, std::move(it->second));
+            snap.fresh_count++;
+            continue;
+        }
+
+        auto last_it = last_bars_.find(symbol);
+        if (last_it == last_bars_.end()) continue;  // Never reported - omit
+
+        Bar carried = last_it->second;
+        carried.open = carried.high = carried.low = carried.close;
+        carried.volume = 0;
+        carried.timestamp = minute_ts;
+        carried.bar_id = bar_id;
+        carried.stale = true;
+        snap.bars.emplace(symbol, std::move(carried));
+        snap.stale_count++;
+    }
+
+    stats_.snapshots_released++;
+    stats_.stale_bars += snap.stale_count;
+    if (complete) {
+        stats_.released_complete++;
+    } else {
+        stats_.released_by_deadline++;
+    }
+
+    last_released_id_ = bar_id;
+    released_any_ = true;
+    ready_.push_back(std::move(snap));
+}
+
+} // namespace trading
@@ -0,0 +1,303 @@
+#include "trading/state_journal.h"
+#include "trading/param_registry.h"
+#include "utils/binary_io.h"
+#include "utils/fingerprint.h"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <unistd.h>
+
+namespace trading {
+
+namespace {
+
+constexpr uint32_t kRecordMagic = 0x314c5753;       // "SWL1"
+constexpr uint32_t kCheckpointMagic = 0x31504353;   // "SCP1"
+constexpr uint32_t kCheckpointVersion = 1;
+constexpr const char* kCheckpointFile = "checkpoint.bin";
+constexpr const char* kWalFile = "journal.wal";
+
+uint64_t checksum(const char* data, size_t size) {
+    utils::Fingerprint fp;
+    fp.add_bytes(data, size);
+    return fp.value();
+}
+
+std::string errno_text() {
+    return std::strerror(errno);
+}
+
+void write_all(int fd, const char* data, size_t size, const std::string& path) {
+    while (size > 0) {
+        ssize_t n = ::write(fd, data, size);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            throw std::runtime_error("Cannot write " + path + ": " + errno_text());
+        }
+        data += n;
+        size -= static_cast<size_t>(n);
+    }
+}
+
+/**
+ * [magic][payload length][checksum][payload]
+ */
+std::string frame(const std::string& payload) {
+    utils::BinaryWriter out;
+    out.put(kRecordMagic);
+    out.put(static_cast<uint32_t>(payload.size()));
+    out.put(checksum(payload.data(), payload.size()));
+    out.put_bytes(payload.data(), payload.size());
+    return out.take();
+}
+
+std::vector<double> tunable_values(const TradingConfig& config) {
+    std::vector<double> values;
+    values.reserve(tunable_params().size());
+    for (const auto& p : tunable_params()) values.push_back(p.get(config));
+    return values;
+}
+
+void apply_tunable_values(TradingConfig& config, const std::vector<double>& values) {
+    const auto& params = tunable_params();
+    if (values.size() != params.size()) {
+        throw std::runtime_error("State journal parameter list does not match this build");
+    }
+    for (size_t i = 0; i < params.size(); ++i) params[i].set(config, values[i]);
+}
+
+std::string read_file(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return {};
+    return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+StateJournal::Record decode_record(const std::string& payload) {
+    utils::BinaryReader in(payload);
+    StateJournal::Record record;
+    in.get(record.type);
+    in.get(record.bar_id);
+    if (record.type == StateJournal::RecordType::MINUTE) {
+        size_t count = in.length(1);
+        for (size_t i = 0; i < count; ++i) {
+            Bar bar;
+            bar.symbol = in.get_string();
+            in.get(bar.bar_id);
+            in.get(bar.timestamp);
+            in.get(bar.open);
+            in.get(bar.high);
+            in.get(bar.low);
+            in.get(bar.close);
+            in.get(bar.volume);
+            in.get(bar.stale);
+            Symbol symbol = bar.symbol;
+            record.bars.emplace(std::move(symbol), std::move(bar));
+        }
+        in.get(record.digest);
+    } else if (record.type == StateJournal::RecordType::RELOAD) {
+        in.get_vector(record.params);
+    } else {
+        throw std::runtime_error("Unknown state journal record type");
+    }
+    if (!in.at_end()) throw std::runtime_error("Trailing data in state journal record");
+    return record;
+}
+
+} // namespace
+
+StateJournal::Digest StateJournal::Digest::of(const MultiSymbolTrader& trader) {
+    Digest digest;
+    digest.cash = trader.cash();
+    digest.positions = trader.positions().size();
+    digest.trades = trader.total_trades();
+    for (const auto& [_, position] : trader.positions()) digest.position_shares += position.shares;
+    return digest;
+}
+
+// ============================================================================
+// Encoding
+// ============================================================================
+
+std::string StateJournal::encode_minute(uint64_t bar_id, const std::unordered_map<Symbol, Bar>& bars,
+                                        const MultiSymbolTrader& trader) {
+    utils::BinaryWriter out;
+    out.put(RecordType::MINUTE);
+    out.put(bar_id);
+    out.put<uint64_t>(bars.size());
+    for (const auto& [symbol, bar] : bars) {
+        out.put_string(symbol);
+        out.put(bar.bar_id);
+        out.put(bar.timestamp);
+        out.put(bar.open);
+        out.put(bar.high);
+        out.put(bar.low);
+        out.put(bar.close);
+        out.put(bar.volume);
+        out.put(bar.stale);
+    }
+    out.put(Digest::of(trader));
+    return frame(out.data());
+}
+
+std::string StateJournal::encode_reload(uint64_t bar_id, const TradingConfig& config) {
+    utils::BinaryWriter out;
+    out.put(RecordType::RELOAD);
+    out.put(bar_id);
+    out.put_vector(tunable_values(config));
+    return frame(out.data());
+}
+
+std::string StateJournal::encode_checkpoint(uint64_t bar_id, const MultiSymbolTrader& trader) {
+    utils::BinaryWriter out;
+    out.put(kCheckpointMagic);
+    out.put(kCheckpointVersion);
+    out.put(bar_id);
+    out.put_vector(tunable_values(trader.config()));
+    out.put_string(trader.save_checkpoint());
+    out.put(checksum(out.data().data(), out.size()));
+    return out.take();
+}
+
+// ============================================================================
+// Writer
+// ============================================================================
+
+StateJournal::StateJournal(std::string directory)
+    : directory_(std::move(directory)) {
+    std::error_code ec;
+    std::filesystem::create_directories(directory_, ec);
+    const std::string path = directory_ + "/" + kWalFile;
+    wal_fd_ = ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (wal_fd_ < 0) {
+        throw std::runtime_error("Cannot open state journal " + path + ": " + errno_text());
+    }
+}
+
+StateJournal::~StateJournal() {
+    if (wal_fd_ >= 0) ::close(wal_fd_);
+}
+
+void StateJournal::append(const std::string& record) {
+    const std::string path = directory_ + "/" + kWalFile;
+    write_all(wal_fd_, record.data(), record.size(), path);
+    if (::fdatasync(wal_fd_) != 0) {
+        throw std::runtime_error("Cannot sync " + path + ": " + errno_text());
+    }
+    records_appended_++;
+}
+
+void StateJournal::write_checkpoint(const std::string& checkpoint) {
+    const std::string path = directory_ + "/" + kCheckpointFile;
+    const std::string tmp = path + ".tmp";
+
+    int fd = ::open(tmp.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) throw std::runtime_error("Cannot create " + tmp + ": " + errno_text());
+    try {
+        write_all(fd, checkpoint.data(), checkpoint.size(), tmp);
+        if (::fsync(fd) != 0) throw std::runtime_error("Cannot sync " + tmp + ": " + errno_text());
+    } catch (...) {
+        ::close(fd);
+        throw;
+    }
+    ::close(fd);
+    if (std::rename(tmp.c_str(), path.c_str()) != 0) {
+        throw std::runtime_error("Cannot replace " + path + ": " + errno_text());
+    }
+    // Make the rename durable before dropping the log records it covers
+    int dir_fd = ::open(directory_.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (dir_fd >= 0) {
+        ::fsync(dir_fd);
+        ::close(dir_fd);
+    }
+    if (::ftruncate(wal_fd_, 0) != 0) {
+        throw std::runtime_error("Cannot truncate state journal: " + errno_text());
+    }
+    checkpoints_written_++;
+}
+
+// ============================================================================
+// Recovery
+// ============================================================================
+
+StateJournal::Recovery StateJournal::load(const std::string& directory) {
+    Recovery recovery;
+
+    const std::string checkpoint_path = directory + "/" + kCheckpointFile;
+    const std::string checkpoint = read_file(checkpoint_path);
+    if (checkpoint.size() < sizeof(uint64_t)) {
+        throw std::runtime_error("No state checkpoint in " + directory);
+    }
+    const size_t body = checkpoint.size() - sizeof(uint64_t);
+    uint64_t stored_sum;
+    std::memcpy(&stored_sum, checkpoint.data() + body, sizeof(stored_sum));
+    if (stored_sum != checksum(checkpoint.data(), body)) {
+        throw std::runtime_error("State checkpoint " + checkpoint_path + " is corrupt");
+    }
+    const std::string contents = checkpoint.substr(0, body);
+    utils::BinaryReader in(contents);
+    if (in.get<uint32_t>() != kCheckpointMagic || in.get<uint32_t>() != kCheckpointVersion) {
+        throw std::runtime_error("Unsupported state checkpoint " + checkpoint_path);
+    }
+    in.get(recovery.checkpoint_bar_id);
+    in.get_vector(recovery.params);
+    recovery.trader_state = in.get_string();
+
+    const std::string wal = read_file(directory + "/" + kWalFile);
+    constexpr size_t kHeader = sizeof(uint32_t) * 2 + sizeof(uint64_t);
+    size_t pos = 0;
+    while (wal.size() - pos >= kHeader) {
+        uint32_t magic, length;
+        uint64_t sum;
+        std::memcpy(&magic, wal.data() + pos, sizeof(magic));
+        std::memcpy(&length, wal.data() + pos + 4, sizeof(length));
+        std::memcpy(&sum, wal.data() + pos + 8, sizeof(sum));
+        if (magic != kRecordMagic || length > wal.size() - pos - kHeader ||
+            sum != checksum(wal.data() + pos + kHeader, length)) {
+            break;      // Torn or corrupt: nothing after it can be trusted
+        }
+        const std::string payload = wal.substr(pos + kHeader, length);
+        Record record = decode_record(payload);
+        pos += kHeader + length;
+        // Covered by the checkpoint: a reload re-applied here could reset indicator state it saved
+        if (record.bar_id <= recovery.checkpoint_bar_id) {
+            recovery.skipped_records++;
+            continue;
+        }
+        recovery.records.push_back(std::move(record));
+    }
+    recovery.torn_bytes = wal.size() - pos;
+    return recovery;
+}
+
+std::unique_ptr<MultiSymbolTrader> StateJournal::restore(const Recovery& recovery, const TradingConfig& base,
+                                                         uint64_t& last_bar_id) {
+    TradingConfig config = base;
+    apply_tunable_values(config, recovery.params);
+    auto trader = MultiSymbolTrader::restore_checkpoint(recovery.trader_state, config);
+    last_bar_id = recovery.checkpoint_bar_id;
+
+    for (const auto& record : recovery.records) {
+        if (record.type == RecordType::RELOAD) {
+            TradingConfig reloaded = trader->config();
+            apply_tunable_values(reloaded, record.params);
+            trader->reconfigure(reloaded);
+            continue;
+        }
+        try {
+            trader->on_bar(record.bars);
+        } catch (const std::exception&) {
+            // The live run logged the minute after on_bar threw; the digest decides
+        }
+        if (!(Digest::of(*trader) == record.digest)) {
+            throw std::runtime_error("State journal replay diverged at bar_id " + std::to_string(record.bar_id));
+        }
+        last_bar_id = record.bar_id;
+    }
+    return trader;
+}
+
+} // namespace trading
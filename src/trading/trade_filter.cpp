@@ -93,12 +93,8 @@ void TradeFilter::record_entry(const Symbol& symbol, int entry_bar,
     state.entry_price = entry_price;
 
     // Record trade for frequency tracking
+    // (ring buffer keeps only the last MAX_TRADE_BARS trades)
     trade_bars_.push_back(entry_bar);
-
-    // Keep only recent trades (last 500 bars ~ 1 day of minute data)
-    if (trade_bars_.size() > 500) {
-        trade_bars_.erase(trade_bars_.begin(), trade_bars_.end() - 500);
-    }
 }
 
 void TradeFilter::record_exit(const Symbol& symbol, int exit_bar) {
@@ -108,11 +104,6 @@ void TradeFilter::record_exit(const Symbol& symbol, int exit_bar) {
 
     // Record trade for frequency tracking
     trade_bars_.push_back(exit_bar);
-
-    // Keep only recent trades
-    if (trade_bars_.size() > 500) {
-        trade_bars_.erase(trade_bars_.begin(), trade_bars_.end() - 500);
-    }
 }
 
 void TradeFilter::update_bars_held(int current_bar) {
@@ -181,8 +172,8 @@ TradeFilter::TradeStats TradeFilter::get_trade_stats(int current_bar) const {
 
     // Count trades today (since last daily reset)
     stats.trades_today = 0;
-    for (int trade_bar : trade_bars_) {
-        if (trade_bar / 390 == current_bar / 390) {
+    for (size_t i = 0; i < trade_bars_.size(); ++i) {
+        if (trade_bars_[i] / 390 == current_bar / 390) {
             stats.trades_today++;
         }
     }
@@ -192,8 +183,8 @@ TradeFilter::TradeStats TradeFilter::get_trade_stats(int current_bar) const {
 
 int TradeFilter::count_recent_trades(int current_bar, int window_bars) const {
     int count = 0;
-    for (int trade_bar : trade_bars_) {
-        if (current_bar - trade_bar <= window_bars) {
+    for (size_t i = 0; i < trade_bars_.size(); ++i) {
+        if (current_bar - trade_bars_[i] <= window_bars) {
             count++;
         }
     }
@@ -206,15 +197,16 @@ bool TradeFilter::check_frequency_limits(int current_bar) const {
 
     // Count trades today only
     int trades_today = 0;
-    for (int trade_bar : trade_bars_) {
-        if (trade_bar / 390 == current_day) {
+    for (size_t i = 0; i < trade_bars_.size(); ++i) {
+        if (trade_bars_[i] / 390 == current_day) {
             trades_today++;
         }
     }
 
     // Hourly check should also be day-aware to prevent cross-day counting
     int trades_last_hour = 0;
-    for (int trade_bar : trade_bars_) {
+    for (size_t i = 0; i < trade_bars_.size(); ++i) {
+        int trade_bar = trade_bars_[i];
         if (trade_bar / 390 == current_day &&    // Same day
             current_bar - trade_bar <= 60) {     // Within hour
             trades_last_hour++;
@@ -246,4 +238,36 @@ double TradeFilter::calculate_pnl_pct(const Symbol& symbol, double current_price
     return (current_price - state.entry_price) / state.entry_price;
 }
 
+void TradeFilter::copy_state_from(const TradeFilter& other) {
+    position_states_ = other.position_states_;
+    trade_bars_ = other.trade_bars_;
+    last_day_reset_ = other.last_day_reset_;
+}
+
+void TradeFilter::save_state(utils::BinaryWriter& out) const {
+    out.put<uint64_t>(position_states_.size());
+    for (const auto& [symbol, state] : position_states_) {
+        out.put_string(symbol);
+        out.put(state);
+    }
+    out.put_vector(trade_bars_.to_vector());
+    out.put(last_day_reset_);
+}
+
+void TradeFilter::load_state(utils::BinaryReader& in) {
+    position_states_.clear();
+    size_t count = in.length(sizeof(PositionState));
+    for (size_t i = 0; i < count; ++i) {
+        Symbol symbol = in.get_string();
+        position_states_[symbol] = in.get<PositionState>();
+    }
+    std::vector<int> bars;
+    in.get_vector(bars);
+    trade_bars_.clear();
+    for (int bar : bars) {
+        trade_bars_.push_back(bar);
+    }
+    in.get(last_day_reset_);
+}
+
 } // namespace trading
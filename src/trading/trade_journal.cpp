@@ -0,0 +1,365 @@
+#include "trading/trade_journal.h"
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <type_traits>
+#include <unistd.h>
+
+namespace trading {
+
+static_assert(std::is_trivially_copyable<TradeJournal::Record>::value,
+              "TradeJournal::Record must be trivially copyable");
+static_assert(sizeof(TradeJournal::Record) == 96,
+              "TradeJournal::Record layout changed - bump kFileVersion");
+
+// ============================================================================
+// Record conversion
+// ============================================================================
+
+TradeJournal::Record TradeJournal::Record::from_trade(const TradeRecord& trade) {
+    Record rec;
+    std::memset(&rec, 0, sizeof(rec));
+    rec.entry_time_ms = to_timestamp_ms(trade.entry_time);
+    rec.exit_time_ms = to_timestamp_ms(trade.exit_time);
+    rec.entry_bar_id = trade.entry_bar_id;
+    rec.exit_bar_id = trade.exit_bar_id;
+    rec.exit_bar_index = static_cast<uint64_t>(trade.exit_bar_index);
+    rec.pnl = trade.pnl;
+    rec.pnl_pct = trade.pnl_pct;
+    rec.entry_price = trade.entry_price;
+    rec.exit_price = trade.exit_price;
+    rec.shares = static_cast<int32_t>(trade.shares);
+    std::strncpy(rec.symbol, trade.symbol.c_str(), sizeof(rec.symbol) - 1);
+    return rec;
+}
+
+TradeRecord TradeJournal::Record::to_trade() const {
+    return TradeRecord(pnl, pnl_pct,
+                       from_timestamp_ms(entry_time_ms), from_timestamp_ms(exit_time_ms),
+                       Symbol(symbol, strnlen(symbol, sizeof(symbol))),
+                       shares, entry_price, exit_price,
+                       entry_bar_id, exit_bar_id, static_cast<size_t>(exit_bar_index));
+}
+
+// ============================================================================
+// Journal
+// ============================================================================
+
+TradeJournal::TradeJournal(size_t ring_capacity)
+    : ring_(std::max<size_t>(1, ring_capacity)) {}
+
+TradeJournal::~TradeJournal() {
+    if (writer_.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        writer_cv_.notify_one();
+        writer_.join();
+    }
+    if (file_) {
+        std::fclose(file_);
+        file_ = nullptr;
+    }
+}
+
+void TradeJournal::open_spill(const std::string& path) {
+    if (spilling()) {
+        throw std::runtime_error("Trade journal already spilling to: " + spill_path_);
+    }
+    start_writer(path);
+}
+
+void TradeJournal::resume_spill(const std::string& path, uint64_t persisted) {
+    if (spilling() || !empty()) {
+        throw std::runtime_error("Trade journal can only resume a spill file when empty");
+    }
+
+    std::FILE* file = std::fopen(path.c_str(), "r+b");
+    if (!file) {
+        throw std::runtime_error("Cannot reopen trade journal file: " + path);
+    }
+    char header[kHeaderSize] = {};
+    uint32_t version = 0;
+    uint32_t record_size = 0;
+    const bool read_ok = std::fread(header, 1, sizeof(header), file) == sizeof(header);
+    std::memcpy(&version, header + 4, sizeof(version));
+    std::memcpy(&record_size, header + 8, sizeof(record_size));
+    if (!read_ok || std::memcmp(header, "SLTJ", 4) != 0 || version != kFileVersion ||
+        record_size != sizeof(Record)) {
+        std::fclose(file);
+        throw std::runtime_error("Not a trade journal file of this version: " + path);
+    }
+
+    const uint64_t keep = kHeaderSize + persisted * sizeof(Record);
+    std::error_code ec;
+    const uint64_t on_disk = std::filesystem::file_size(path, ec);
+    if (ec || on_disk < keep) {
+        std::fclose(file);
+        throw std::runtime_error("Trade journal file " + path + " holds fewer than " +
+                                 std::to_string(persisted) + " trades");
+    }
+    if (::ftruncate(::fileno(file), static_cast<off_t>(keep)) != 0 || std::fseek(file, 0, SEEK_END) != 0) {
+        std::fclose(file);
+        throw std::runtime_error("Cannot truncate trade journal file: " + path);
+    }
+
+    file_ = file;
+    spill_path_ = path;
+    appended_.store(persisted, std::memory_order_release);
+    flushed_.store(persisted, std::memory_order_release);
+    writer_ = std::thread(&TradeJournal::writer_loop, this);
+}
+
+TradeJournal::Checkpoint TradeJournal::checkpoint() const {
+    Checkpoint cp;
+    // Only this thread appends, so the records in [persisted, total) stay in the ring
+    const uint64_t total = appended_.load(std::memory_order_acquire);
+    if (spilling()) {
+        cp.spill_path = spill_path_;
+        cp.persisted = flushed_.load(std::memory_order_acquire);
+    }
+    const size_t capacity = ring_.size();
+    cp.pending.reserve(static_cast<size_t>(total - cp.persisted));
+    for (uint64_t seq = cp.persisted; seq < total; ++seq) {
+        cp.pending.push_back(ring_[static_cast<size_t>(seq % capacity)]);
+    }
+    return cp;
+}
+
+void TradeJournal::append(const TradeRecord& trade) {
+    const uint64_t seq = appended_.load(std::memory_order_relaxed);
+
+    if (!spilling() && seq == ring_.size()) {
+        // Memory only: grow rather than touch the disk from inside on_bar
+        ring_.resize(ring_.size() * 2);
+    }
+
+    if (spilling() && seq - flushed_.load(std::memory_order_acquire) >= ring_.size()) {
+        // Writer is a full ring behind - wait for it (rare backpressure)
+        std::unique_lock<std::mutex> lock(mutex_);
+        flush_requested_ = true;
+        writer_cv_.notify_one();
+        space_cv_.wait(lock, [&] {
+            return seq - flushed_.load(std::memory_order_acquire) < ring_.size() ||
+                   (!write_error_.empty() && !writing_);
+        });
+        // Its writes are failing: keep the records in memory until a retry succeeds
+        if (seq - flushed_.load(std::memory_order_acquire) >= ring_.size()) grow_ring();
+    }
+    const size_t capacity = ring_.size();
+
+    ring_[seq % capacity] = Record::from_trade(trade);
+    appended_.store(seq + 1, std::memory_order_release);
+
+    if (spilling() && (seq + 1) - flushed_.load(std::memory_order_acquire) >= flush_batch()) {
+        writer_cv_.notify_one();
+    }
+}
+
+void TradeJournal::flush() const {
+    if (!writer_.joinable()) return;
+
+    const uint64_t target = appended_.load(std::memory_order_acquire);
+    std::unique_lock<std::mutex> lock(mutex_);
+    const uint64_t attempts = write_attempts_;
+    flush_requested_ = true;
+    writer_cv_.notify_one();
+    space_cv_.wait(lock, [&] {
+        return flushed_.load(std::memory_order_acquire) >= target ||
+               (write_attempts_ > attempts && !write_error_.empty());
+    });
+    if (flushed_.load(std::memory_order_acquire) < target) {
+        throw std::runtime_error("Trade journal " + spill_path_ + " not flushed: " + write_error_);
+    }
+}
+
+std::string TradeJournal::write_error() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return write_error_;
+}
+
+void TradeJournal::grow_ring() {
+    // Caller holds mutex_ and the writer is not reading the ring
+    const uint64_t from = flushed_.load(std::memory_order_acquire);
+    const uint64_t to = appended_.load(std::memory_order_relaxed);
+    std::vector<Record> grown(ring_.size() * 2);
+    for (uint64_t seq = from; seq < to; ++seq) {
+        grown[static_cast<size_t>(seq % grown.size())] = ring_[static_cast<size_t>(seq % ring_.size())];
+    }
+    ring_.swap(grown);
+}
+
+void TradeJournal::start_writer(const std::string& path) {
+    std::filesystem::path p(path);
+    if (p.has_parent_path()) {
+        std::filesystem::create_directories(p.parent_path());
+    }
+
+    file_ = std::fopen(path.c_str(), "wb");
+    if (!file_) {
+        throw std::runtime_error("Cannot create trade journal file: " + path);
+    }
+
+    char header[kHeaderSize] = {'S', 'L', 'T', 'J'};
+    const uint32_t version = kFileVersion;
+    const uint32_t record_size = sizeof(Record);
+    std::memcpy(header + 4, &version, sizeof(version));
+    std::memcpy(header + 8, &record_size, sizeof(record_size));
+    if (std::fwrite(header, 1, sizeof(header), file_) != sizeof(header) || std::fflush(file_) != 0) {
+        const std::string error = std::strerror(errno);
+        std::fclose(file_);
+        file_ = nullptr;
+        throw std::runtime_error("Cannot write trade journal header to " + path + ": " + error);
+    }
+
+    spill_path_ = path;
+    flushed_.store(0, std::memory_order_release);
+    writer_ = std::thread(&TradeJournal::writer_loop, this);
+}
+
+void TradeJournal::writer_loop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        // After a failed write, retry on the once-a-second timeout (or when
+        // flush() asks) rather than on every append
+        writer_cv_.wait_for(lock, std::chrono::seconds(1), [&] {
+            return stop_ || flush_requested_ ||
+                   (write_error_.empty() &&
+                    appended_.load(std::memory_order_acquire) -
+                    flushed_.load(std::memory_order_relaxed) >= flush_batch());
+        });
+
+        const uint64_t from = flushed_.load(std::memory_order_relaxed);
+        const uint64_t to = appended_.load(std::memory_order_acquire);
+        flush_requested_ = false;
+
+        if (to > from) {
+            writing_ = true;
+            lock.unlock();
+            std::string error;
+            const bool written = write_range(from, to, error);
+            lock.lock();
+            writing_ = false;
+            write_attempts_++;
+            if (written) {
+                flushed_.store(to, std::memory_order_release);
+                write_error_.clear();
+            } else {
+                write_error_ = error;
+            }
+        }
+        space_cv_.notify_all();
+
+        // Shutting down: stop once everything is on disk, or after one more failed attempt
+        if (stop_ && (flushed_.load(std::memory_order_relaxed) == appended_.load(std::memory_order_acquire) ||
+                      !write_error_.empty())) {
+            break;
+        }
+    }
+}
+
+bool TradeJournal::write_range(uint64_t from, uint64_t to, std::string& error) {
+    // Positioned writes: a retry rewrites the whole range over any partial write
+    const int fd = ::fileno(file_);
+    const size_t capacity = ring_.size();
+    while (from < to) {
+        const size_t slot = static_cast<size_t>(from % capacity);
+        const size_t count = static_cast<size_t>(std::min<uint64_t>(to - from, capacity - slot));
+        const char* data = reinterpret_cast<const char*>(&ring_[slot]);
+        size_t bytes = count * sizeof(Record);
+        off_t offset = static_cast<off_t>(kHeaderSize + from * sizeof(Record));
+        while (bytes > 0) {
+            const ssize_t n = ::pwrite(fd, data, bytes, offset);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) {
+                error = std::string("write failed: ") + (n < 0 ? std::strerror(errno) : "no progress");
+                return false;
+            }
+            data += n;
+            bytes -= static_cast<size_t>(n);
+            offset += n;
+        }
+        from += count;
+    }
+    // Durable before counted as flushed: a trader checkpoint relies on it
+    if (::fdatasync(fd) != 0) {
+        error = std::string("fdatasync failed: ") + std::strerror(errno);
+        return false;
+    }
+    return true;
+}
+
+// ============================================================================
+// Iteration
+// ============================================================================
+
+struct TradeJournal::Iterator::Source {
+    static constexpr size_t kChunk = 256;
+
+    const TradeJournal* journal = nullptr;  // Ring-backed (not spilling)
+    std::FILE* file = nullptr;              // Disk-backed (spilling)
+    std::vector<Record> chunk;
+    uint64_t chunk_start = 0;
+
+    ~Source() {
+        if (file) std::fclose(file);
+    }
+};
+
+TradeJournal::Iterator::Iterator(std::shared_ptr<Source> source, uint64_t index, uint64_t end)
+    : source_(std::move(source)), index_(index), end_(end) {
+    load();
+}
+
+TradeJournal::Iterator& TradeJournal::Iterator::operator++() {
+    ++index_;
+    load();
+    return *this;
+}
+
+void TradeJournal::Iterator::load() {
+    if (!source_ || index_ >= end_) return;
+
+    if (!source_->file) {
+        current_ = source_->journal->ring_[static_cast<size_t>(index_)].to_trade();
+        return;
+    }
+
+    auto& src = *source_;
+    if (index_ < src.chunk_start || index_ >= src.chunk_start + src.chunk.size()) {
+        size_t count = static_cast<size_t>(std::min<uint64_t>(Source::kChunk, end_ - index_));
+        src.chunk.resize(count);
+        long offset = static_cast<long>(kHeaderSize + index_ * sizeof(Record));
+        if (std::fseek(src.file, offset, SEEK_SET) != 0 ||
+            std::fread(src.chunk.data(), sizeof(Record), count, src.file) != count) {
+            throw std::runtime_error("Trade journal read failed at record " + std::to_string(index_));
+        }
+        src.chunk_start = index_;
+    }
+    current_ = src.chunk[static_cast<size_t>(index_ - src.chunk_start)].to_trade();
+}
+
+TradeJournal::Iterator TradeJournal::begin() const {
+    auto source = std::make_shared<Iterator::Source>();
+    source->journal = this;
+
+    const uint64_t total = appended_.load(std::memory_order_acquire);
+    if (writer_.joinable()) {
+        flush();
+        source->file = std::fopen(spill_path_.c_str(), "rb");
+        if (!source->file) {
+            throw std::runtime_error("Cannot open trade journal for reading: " + spill_path_);
+        }
+    }
+    return Iterator(std::move(source), 0, total);
+}
+
+TradeJournal::Iterator TradeJournal::end() const {
+    const uint64_t total = appended_.load(std::memory_order_acquire);
+    return Iterator(nullptr, total, total);
+}
+
+} // namespace trading
@@ -0,0 +1,173 @@
+#!/usr/bin/env python3
+"""
+Sentio Serve Client - Drive a resident `sentio_lite serve` process from Python
+
+Keeps one server alive for a whole optimization run so each trial costs only
+the backtest itself (no process startup, data loading or window assembly).
+
+Usage (Optuna ask/tell with pruning):
+    from sentio_serve_client import SentioServer
+
+    with SentioServer(config_dir="config", date="10-21", threads=8) as server:
+        study = optuna.create_study(direction="maximize", pruner=optuna.pruners.MedianPruner())
+        for _ in range(1000):
+            trial = study.ask()
+            params = {"w_rsi": trial.suggest_float("w_rsi", 0.0, 2.0)}
+
+            def on_progress(event):
+                trial.report(event["total_return"], event["step"])
+                return trial.should_prune()      # True aborts the backtest
+
+            result = server.evaluate(params, on_progress=on_progress, report_every=60)
+            if result.get("aborted"):
+                study.tell(trial, state=optuna.trial.TrialState.PRUNED)
+            else:
+                study.tell(trial, result.get("mrd", float("-inf")))
+
+    # Or submit a batch and collect results as they finish
+    ids = [server.submit(p) for p in param_sets]
+    for result in server.results(len(ids)):
+        ...
+
+    # Attach to an already running server: sentio_lite serve --socket /tmp/sentio.sock
+    server = SentioServer.connect("/tmp/sentio.sock")
+"""
+
+import itertools
+import json
+import socket
+import subprocess
+
+
+class SentioServer:
+    """NDJSON client for `sentio_lite serve` over a pipe or Unix socket"""
+
+    def __init__(self, binary="./build/sentio_lite", config_dir="config", date=None,
+                 threads=0, data_dir=None, extra_args=None):
+        cmd = [binary, "serve", "--config", config_dir, "--no-dashboard"]
+        if date:
+            cmd += ["--date", date]
+        if threads:
+            cmd += ["--threads", str(threads)]
+        if data_dir:
+            cmd += ["--data-dir", data_dir]
+        cmd += list(extra_args or [])
+
+        # stderr carries the human-readable log; stdout is the protocol
+        self._proc = subprocess.Popen(cmd, stdin=subprocess.PIPE, stdout=subprocess.PIPE,
+                                      text=True, bufsize=1)
+        self._reader = self._proc.stdout
+        self._writer = self._proc.stdin
+        self._sock = None
+        self._init_session()
+
+    @classmethod
+    def connect(cls, socket_path):
+        """Attach to a server started with --socket PATH"""
+        self = cls.__new__(cls)
+        self._proc = None
+        self._sock = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+        self._sock.connect(socket_path)
+        self._reader = self._sock.makefile("r", encoding="utf-8")
+        self._writer = self._sock.makefile("w", encoding="utf-8")
+        self._init_session()
+        return self
+
+    def _init_session(self):
+        self._ids = itertools.count(1)
+        self._buffered = {}
+        self._progress_handlers = {}
+        self.info = self._read()
+        if self.info.get("event") != "ready":
+            raise RuntimeError(f"Unexpected server greeting: {self.info}")
+
+    def _send(self, obj):
+        self._writer.write(json.dumps(obj) + "\n")
+        self._writer.flush()
+
+    def _read(self):
+        line = self._reader.readline()
+        if not line:
+            raise RuntimeError("sentio_lite serve closed the connection")
+        return json.loads(line)
+
+    def _read_response(self):
+        """Next non-progress message; progress events go to their handlers"""
+        while True:
+            message = self._read()
+            if message.get("event") != "progress":
+                return message
+            handler = self._progress_handlers.get(message.get("id"))
+            if handler is not None and handler(message):
+                self.abort(message["id"])
+
+    def submit(self, params, date=None, on_progress=None, report_every=None):
+        """Queue one evaluation; returns its request id
+
+        on_progress(event) is called with intermediate metrics (at day closes and
+        every `report_every` trading bars); returning True aborts the backtest.
+        """
+        request_id = next(self._ids)
+        request = {"id": request_id, "params": params}
+        if date:
+            request["date"] = date
+        if on_progress is not None:
+            self._progress_handlers[request_id] = on_progress
+            if report_every:
+                request["report_every"] = int(report_every)
+            else:
+                request["progress"] = True
+        self._send(request)
+        return request_id
+
+    def abort(self, request_id):
+        """Stop a queued or running evaluation (its result arrives with "aborted": true)"""
+        self._send({"cmd": "abort", "target": request_id, "id": f"abort-{request_id}"})
+
+    def _store(self, response):
+        response_id = response.get("id")
+        if isinstance(response_id, str) and response_id.startswith("abort-"):
+            return  # Acknowledgement of abort()
+        self._progress_handlers.pop(response_id, None)
+        self._buffered[response_id] = response
+
+    def result(self, request_id):
+        """Block until the result for request_id arrives"""
+        while request_id not in self._buffered:
+            self._store(self._read_response())
+        return self._buffered.pop(request_id)
+
+    def results(self, count):
+        """Yield the next `count` results in completion order"""
+        for _ in range(count):
+            while not self._buffered:
+                self._store(self._read_response())
+            yield self._buffered.pop(next(iter(self._buffered)))
+
+    def evaluate(self, params, date=None, on_progress=None, report_every=None):
+        """Submit and wait (one trial at a time)"""
+        return self.result(self.submit(params, date, on_progress, report_every))
+
+    def tunable_params(self):
+        """Base values of every tunable parameter, by name"""
+        self._send({"cmd": "params", "id": "params"})
+        return self.result("params")["params"]
+
+    def close(self):
+        if self._proc is not None:
+            self._writer.close()  # EOF: server drains in-flight work and exits
+            self._proc.wait()
+        elif self._sock is not None:
+            self._sock.close()
+
+    def shutdown(self):
+        """Stop the server process (socket mode: affects every client)"""
+        self._send({"cmd": "shutdown", "id": "shutdown"})
+        self.result("shutdown")
+        self.close()
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *exc):
+        self.close()